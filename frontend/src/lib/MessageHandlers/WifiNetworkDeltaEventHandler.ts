@@ -0,0 +1,62 @@
+import { WifiNetworkDeltaEvent } from '$lib/_fbs/open-shock/serialization/local/wifi-network-delta-event';
+import { WifiNetworkDelta } from '$lib/_fbs/open-shock/serialization/local/wifi-network-delta';
+import { DeviceStateStore } from '$lib/stores';
+import type { MessageHandler } from '.';
+
+// Generation of the last applied delta, null until the first delta after (re)connecting
+let lastGeneration: number | null = null;
+
+function formatBssid(delta: WifiNetworkDelta): string {
+  const parts: string[] = [];
+  for (let i = 0; i < 6; i++) {
+    parts.push((delta.bssid(i) ?? 0).toString(16).toUpperCase().padStart(2, '0'));
+  }
+  return parts.join(':');
+}
+
+export function resetWifiNetworkDeltaGeneration() {
+  lastGeneration = null;
+}
+
+export const WifiNetworkDeltaEventHandler: MessageHandler = (cli, msg) => {
+  const payload = new WifiNetworkDeltaEvent();
+  msg.payload(payload);
+
+  const generation = payload.generation();
+
+  if (lastGeneration !== null && generation <= lastGeneration) {
+    console.warn('[WS] Received stale wifi network delta event (generation ' + generation + ')');
+    return;
+  }
+  lastGeneration = generation;
+
+  const updatedLength = payload.updatedLength();
+  for (let i = 0; i < updatedLength; i++) {
+    const delta = payload.updated(i);
+    if (!delta) {
+      console.warn('[WS] Received invalid wifi network delta event (null update)');
+      continue;
+    }
+
+    const rssi = delta.rssi();
+    const channel = delta.channel();
+
+    // Deltas only carry RSSI and channel, networks not seen yet arrive through the full snapshot instead
+    DeviceStateStore.updateWifiNetwork(formatBssid(delta), (network) => {
+      network.rssi = rssi;
+      network.channel = channel;
+      return network;
+    });
+  }
+
+  const lostLength = payload.lostLength();
+  for (let i = 0; i < lostLength; i++) {
+    const delta = payload.lost(i);
+    if (!delta) {
+      console.warn('[WS] Received invalid wifi network delta event (null loss)');
+      continue;
+    }
+
+    DeviceStateStore.removeWifiNetwork(formatBssid(delta));
+  }
+};
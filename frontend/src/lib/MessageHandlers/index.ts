@@ -13,6 +13,7 @@ import { AccountLinkCommandResult } from '$lib/_fbs/open-shock/serialization/loc
 import { AccountLinkResultCode } from '$lib/_fbs/open-shock/serialization/local/account-link-result-code';
 import { ErrorMessage } from '$lib/_fbs/open-shock/serialization/local/error-message';
 import { WifiNetworkEventHandler } from './WifiNetworkEventHandler';
+import { WifiNetworkDeltaEventHandler, resetWifiNetworkDeltaGeneration } from './WifiNetworkDeltaEventHandler';
 import { mapConfig } from '$lib/mappers/ConfigMapper';
 
 export type MessageHandler = (wsClient: WebSocketClient, message: HubToLocalMessage) => void;
@@ -40,6 +41,9 @@ PayloadHandlers[HubToLocalMessagePayload.ReadyMessage] = (cli, msg) => {
     return store;
   });
 
+  // The device restarts its delta stream with a full snapshot on every new connection
+  resetWifiNetworkDeltaGeneration();
+
   const data = SerializeWifiScanCommand(true);
   cli.Send(data);
 
@@ -70,6 +74,8 @@ PayloadHandlers[HubToLocalMessagePayload.WifiScanStatusMessage] = (cli, msg) =>
 
 PayloadHandlers[HubToLocalMessagePayload.WifiNetworkEvent] = WifiNetworkEventHandler;
 
+PayloadHandlers[HubToLocalMessagePayload.WifiNetworkDeltaEvent] = WifiNetworkDeltaEventHandler;
+
 PayloadHandlers[HubToLocalMessagePayload.AccountLinkCommandResult] = (cli, msg) => {
   const payload = new AccountLinkCommandResult();
   msg.payload(payload);
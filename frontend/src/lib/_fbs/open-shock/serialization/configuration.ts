@@ -9,6 +9,7 @@ export { OtaUpdateChannel } from './configuration/ota-update-channel';
 export { OtaUpdateConfig } from './configuration/ota-update-config';
 export { OtaUpdateStep } from './configuration/ota-update-step';
 export { RFConfig } from './configuration/rfconfig';
+export { RFTransmitterConfig } from './configuration/rftransmitter-config';
 export { SerialInputConfig } from './configuration/serial-input-config';
 export { WiFiConfig } from './configuration/wi-fi-config';
 export { WiFiCredentials } from './configuration/wi-fi-credentials';
@@ -4,6 +4,9 @@
 
 import * as flatbuffers from 'flatbuffers';
 
+import { RFTransmitterConfig } from '../../../open-shock/serialization/configuration/rftransmitter-config';
+
+
 export class RFConfig {
   bb: flatbuffers.ByteBuffer|null = null;
   bb_pos = 0;
@@ -38,8 +41,21 @@ keepaliveEnabled():boolean {
   return offset ? !!this.bb!.readInt8(this.bb_pos + offset) : false;
 }
 
+/**
+ * Additional transmitters, each driving its own RF modulator
+ */
+transmitters(index: number, obj?:RFTransmitterConfig):RFTransmitterConfig|null {
+  const offset = this.bb!.__offset(this.bb_pos, 8);
+  return offset ? (obj || new RFTransmitterConfig()).__init(this.bb!.__indirect(this.bb!.__vector(this.bb_pos + offset) + index * 4), this.bb!) : null;
+}
+
+transmittersLength():number {
+  const offset = this.bb!.__offset(this.bb_pos, 8);
+  return offset ? this.bb!.__vector_len(this.bb_pos + offset) : 0;
+}
+
 static startRFConfig(builder:flatbuffers.Builder) {
-  builder.startObject(2);
+  builder.startObject(3);
 }
 
 static addTxPin(builder:flatbuffers.Builder, txPin:number) {
@@ -50,15 +66,32 @@ static addKeepaliveEnabled(builder:flatbuffers.Builder, keepaliveEnabled:boolean
   builder.addFieldInt8(1, +keepaliveEnabled, +false);
 }
 
+static addTransmitters(builder:flatbuffers.Builder, transmittersOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(2, transmittersOffset, 0);
+}
+
+static createTransmittersVector(builder:flatbuffers.Builder, data:flatbuffers.Offset[]):flatbuffers.Offset {
+  builder.startVector(4, data.length, 4);
+  for (let i = data.length - 1; i >= 0; i--) {
+    builder.addOffset(data[i]!);
+  }
+  return builder.endVector();
+}
+
+static startTransmittersVector(builder:flatbuffers.Builder, numElems:number) {
+  builder.startVector(4, numElems, 4);
+}
+
 static endRFConfig(builder:flatbuffers.Builder):flatbuffers.Offset {
   const offset = builder.endObject();
   return offset;
 }
 
-static createRFConfig(builder:flatbuffers.Builder, txPin:number, keepaliveEnabled:boolean):flatbuffers.Offset {
+static createRFConfig(builder:flatbuffers.Builder, txPin:number, keepaliveEnabled:boolean, transmittersOffset:flatbuffers.Offset):flatbuffers.Offset {
   RFConfig.startRFConfig(builder);
   RFConfig.addTxPin(builder, txPin);
   RFConfig.addKeepaliveEnabled(builder, keepaliveEnabled);
+  RFConfig.addTransmitters(builder, transmittersOffset);
   return RFConfig.endRFConfig(builder);
 }
 }
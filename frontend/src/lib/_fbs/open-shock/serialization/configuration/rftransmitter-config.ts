@@ -0,0 +1,104 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+/* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
+
+import * as flatbuffers from 'flatbuffers';
+
+export class RFTransmitterConfig {
+  bb: flatbuffers.ByteBuffer|null = null;
+  bb_pos = 0;
+  __init(i:number, bb:flatbuffers.ByteBuffer):RFTransmitterConfig {
+  this.bb_pos = i;
+  this.bb = bb;
+  return this;
+}
+
+static getRootAsRFTransmitterConfig(bb:flatbuffers.ByteBuffer, obj?:RFTransmitterConfig):RFTransmitterConfig {
+  return (obj || new RFTransmitterConfig()).__init(bb.readInt32(bb.position()) + bb.position(), bb);
+}
+
+static getSizePrefixedRootAsRFTransmitterConfig(bb:flatbuffers.ByteBuffer, obj?:RFTransmitterConfig):RFTransmitterConfig {
+  bb.setPosition(bb.position() + flatbuffers.SIZE_PREFIX_LENGTH);
+  return (obj || new RFTransmitterConfig()).__init(bb.readInt32(bb.position()) + bb.position(), bb);
+}
+
+/**
+ * The GPIO pin connected to this transmitter's RF modulator data pin
+ */
+txPin():number {
+  const offset = this.bb!.__offset(this.bb_pos, 4);
+  return offset ? this.bb!.readUint8(this.bb_pos + offset) : 0;
+}
+
+/**
+ * The core the transmit task is pinned to, -1 lets the scheduler pick either core
+ */
+coreId():number {
+  const offset = this.bb!.__offset(this.bb_pos, 6);
+  return offset ? this.bb!.readInt8(this.bb_pos + offset) : -1;
+}
+
+/**
+ * IDs of the shockers that are sent through this transmitter instead of the main one
+ */
+shockerIds(index: number):number|null {
+  const offset = this.bb!.__offset(this.bb_pos, 8);
+  return offset ? this.bb!.readUint16(this.bb!.__vector(this.bb_pos + offset) + index * 2) : 0;
+}
+
+shockerIdsLength():number {
+  const offset = this.bb!.__offset(this.bb_pos, 8);
+  return offset ? this.bb!.__vector_len(this.bb_pos + offset) : 0;
+}
+
+shockerIdsArray():Uint16Array|null {
+  const offset = this.bb!.__offset(this.bb_pos, 8);
+  return offset ? new Uint16Array(this.bb!.bytes().buffer, this.bb!.bytes().byteOffset + this.bb!.__vector(this.bb_pos + offset), this.bb!.__vector_len(this.bb_pos + offset)) : null;
+}
+
+static startRFTransmitterConfig(builder:flatbuffers.Builder) {
+  builder.startObject(3);
+}
+
+static addTxPin(builder:flatbuffers.Builder, txPin:number) {
+  builder.addFieldInt8(0, txPin, 0);
+}
+
+static addCoreId(builder:flatbuffers.Builder, coreId:number) {
+  builder.addFieldInt8(1, coreId, -1);
+}
+
+static addShockerIds(builder:flatbuffers.Builder, shockerIdsOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(2, shockerIdsOffset, 0);
+}
+
+static createShockerIdsVector(builder:flatbuffers.Builder, data:number[]|Uint16Array):flatbuffers.Offset;
+/**
+ * @deprecated This Uint8Array overload will be removed in the future.
+ */
+static createShockerIdsVector(builder:flatbuffers.Builder, data:number[]|Uint8Array):flatbuffers.Offset;
+static createShockerIdsVector(builder:flatbuffers.Builder, data:number[]|Uint16Array|Uint8Array):flatbuffers.Offset {
+  builder.startVector(2, data.length, 2);
+  for (let i = data.length - 1; i >= 0; i--) {
+    builder.addInt16(data[i]!);
+  }
+  return builder.endVector();
+}
+
+static startShockerIdsVector(builder:flatbuffers.Builder, numElems:number) {
+  builder.startVector(2, numElems, 2);
+}
+
+static endRFTransmitterConfig(builder:flatbuffers.Builder):flatbuffers.Offset {
+  const offset = builder.endObject();
+  return offset;
+}
+
+static createRFTransmitterConfig(builder:flatbuffers.Builder, txPin:number, coreId:number, shockerIdsOffset:flatbuffers.Offset):flatbuffers.Offset {
+  RFTransmitterConfig.startRFTransmitterConfig(builder);
+  RFTransmitterConfig.addTxPin(builder, txPin);
+  RFTransmitterConfig.addCoreId(builder, coreId);
+  RFTransmitterConfig.addShockerIds(builder, shockerIdsOffset);
+  return RFTransmitterConfig.endRFTransmitterConfig(builder);
+}
+}
@@ -4,6 +4,7 @@
 
 export { AccountLinkCommand } from './local/account-link-command';
 export { AccountUnlinkCommand } from './local/account-unlink-command';
+export { LatencyReportCommand } from './local/latency-report-command';
 export { LocalToHubMessage } from './local/local-to-hub-message';
 export { LocalToHubMessagePayload } from './local/local-to-hub-message-payload';
 export { OtaUpdateCheckForUpdatesCommand } from './local/ota-update-check-for-updates-command';
@@ -16,6 +17,8 @@ export { OtaUpdateSetRequireManualApprovalCommand } from './local/ota-update-set
 export { OtaUpdateSetUpdateChannelCommand } from './local/ota-update-set-update-channel-command';
 export { OtaUpdateStartUpdateCommand } from './local/ota-update-start-update-command';
 export { SetRfTxPinCommand } from './local/set-rf-tx-pin-command';
+export { ShockerCommand } from './local/shocker-command';
+export { ShockerCommandList } from './local/shocker-command-list';
 export { WifiNetworkConnectCommand } from './local/wifi-network-connect-command';
 export { WifiNetworkDisconnectCommand } from './local/wifi-network-disconnect-command';
 export { WifiNetworkForgetCommand } from './local/wifi-network-forget-command';
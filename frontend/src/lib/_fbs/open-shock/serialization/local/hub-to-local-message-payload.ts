@@ -4,10 +4,13 @@
 
 import { AccountLinkCommandResult } from '../../../open-shock/serialization/local/account-link-command-result';
 import { ErrorMessage } from '../../../open-shock/serialization/local/error-message';
+import { LatencyReport } from '../../../open-shock/serialization/local/latency-report';
 import { ReadyMessage } from '../../../open-shock/serialization/local/ready-message';
 import { SetRfTxPinCommandResult } from '../../../open-shock/serialization/local/set-rf-tx-pin-command-result';
+import { ShockerCommandListResult } from '../../../open-shock/serialization/local/shocker-command-list-result';
 import { WifiGotIpEvent } from '../../../open-shock/serialization/local/wifi-got-ip-event';
 import { WifiLostIpEvent } from '../../../open-shock/serialization/local/wifi-lost-ip-event';
+import { WifiNetworkDeltaEvent } from '../../../open-shock/serialization/local/wifi-network-delta-event';
 import { WifiNetworkEvent } from '../../../open-shock/serialization/local/wifi-network-event';
 import { WifiScanStatusMessage } from '../../../open-shock/serialization/local/wifi-scan-status-message';
 
@@ -21,13 +24,16 @@ export enum HubToLocalMessagePayload {
   WifiGotIpEvent = 5,
   WifiLostIpEvent = 6,
   AccountLinkCommandResult = 7,
-  SetRfTxPinCommandResult = 8
+  SetRfTxPinCommandResult = 8,
+  LatencyReport = 9,
+  ShockerCommandListResult = 10,
+  WifiNetworkDeltaEvent = 11
 }
 
 export function unionToHubToLocalMessagePayload(
   type: HubToLocalMessagePayload,
-  accessor: (obj:AccountLinkCommandResult|ErrorMessage|ReadyMessage|SetRfTxPinCommandResult|WifiGotIpEvent|WifiLostIpEvent|WifiNetworkEvent|WifiScanStatusMessage) => AccountLinkCommandResult|ErrorMessage|ReadyMessage|SetRfTxPinCommandResult|WifiGotIpEvent|WifiLostIpEvent|WifiNetworkEvent|WifiScanStatusMessage|null
-): AccountLinkCommandResult|ErrorMessage|ReadyMessage|SetRfTxPinCommandResult|WifiGotIpEvent|WifiLostIpEvent|WifiNetworkEvent|WifiScanStatusMessage|null {
+  accessor: (obj:AccountLinkCommandResult|ErrorMessage|LatencyReport|ReadyMessage|SetRfTxPinCommandResult|ShockerCommandListResult|WifiGotIpEvent|WifiLostIpEvent|WifiNetworkDeltaEvent|WifiNetworkEvent|WifiScanStatusMessage) => AccountLinkCommandResult|ErrorMessage|LatencyReport|ReadyMessage|SetRfTxPinCommandResult|ShockerCommandListResult|WifiGotIpEvent|WifiLostIpEvent|WifiNetworkDeltaEvent|WifiNetworkEvent|WifiScanStatusMessage|null
+): AccountLinkCommandResult|ErrorMessage|LatencyReport|ReadyMessage|SetRfTxPinCommandResult|ShockerCommandListResult|WifiGotIpEvent|WifiLostIpEvent|WifiNetworkDeltaEvent|WifiNetworkEvent|WifiScanStatusMessage|null {
   switch(HubToLocalMessagePayload[type]) {
     case 'NONE': return null; 
     case 'ReadyMessage': return accessor(new ReadyMessage())! as ReadyMessage;
@@ -38,15 +44,18 @@ export function unionToHubToLocalMessagePayload(
     case 'WifiLostIpEvent': return accessor(new WifiLostIpEvent())! as WifiLostIpEvent;
     case 'AccountLinkCommandResult': return accessor(new AccountLinkCommandResult())! as AccountLinkCommandResult;
     case 'SetRfTxPinCommandResult': return accessor(new SetRfTxPinCommandResult())! as SetRfTxPinCommandResult;
+    case 'LatencyReport': return accessor(new LatencyReport())! as LatencyReport;
+    case 'ShockerCommandListResult': return accessor(new ShockerCommandListResult())! as ShockerCommandListResult;
+    case 'WifiNetworkDeltaEvent': return accessor(new WifiNetworkDeltaEvent())! as WifiNetworkDeltaEvent;
     default: return null;
   }
 }
 
 export function unionListToHubToLocalMessagePayload(
   type: HubToLocalMessagePayload, 
-  accessor: (index: number, obj:AccountLinkCommandResult|ErrorMessage|ReadyMessage|SetRfTxPinCommandResult|WifiGotIpEvent|WifiLostIpEvent|WifiNetworkEvent|WifiScanStatusMessage) => AccountLinkCommandResult|ErrorMessage|ReadyMessage|SetRfTxPinCommandResult|WifiGotIpEvent|WifiLostIpEvent|WifiNetworkEvent|WifiScanStatusMessage|null, 
+  accessor: (index: number, obj:AccountLinkCommandResult|ErrorMessage|LatencyReport|ReadyMessage|SetRfTxPinCommandResult|ShockerCommandListResult|WifiGotIpEvent|WifiLostIpEvent|WifiNetworkDeltaEvent|WifiNetworkEvent|WifiScanStatusMessage) => AccountLinkCommandResult|ErrorMessage|LatencyReport|ReadyMessage|SetRfTxPinCommandResult|ShockerCommandListResult|WifiGotIpEvent|WifiLostIpEvent|WifiNetworkDeltaEvent|WifiNetworkEvent|WifiScanStatusMessage|null, 
   index: number
-): AccountLinkCommandResult|ErrorMessage|ReadyMessage|SetRfTxPinCommandResult|WifiGotIpEvent|WifiLostIpEvent|WifiNetworkEvent|WifiScanStatusMessage|null {
+): AccountLinkCommandResult|ErrorMessage|LatencyReport|ReadyMessage|SetRfTxPinCommandResult|ShockerCommandListResult|WifiGotIpEvent|WifiLostIpEvent|WifiNetworkDeltaEvent|WifiNetworkEvent|WifiScanStatusMessage|null {
   switch(HubToLocalMessagePayload[type]) {
     case 'NONE': return null; 
     case 'ReadyMessage': return accessor(index, new ReadyMessage())! as ReadyMessage;
@@ -57,6 +66,9 @@ export function unionListToHubToLocalMessagePayload(
     case 'WifiLostIpEvent': return accessor(index, new WifiLostIpEvent())! as WifiLostIpEvent;
     case 'AccountLinkCommandResult': return accessor(index, new AccountLinkCommandResult())! as AccountLinkCommandResult;
     case 'SetRfTxPinCommandResult': return accessor(index, new SetRfTxPinCommandResult())! as SetRfTxPinCommandResult;
+    case 'LatencyReport': return accessor(index, new LatencyReport())! as LatencyReport;
+    case 'ShockerCommandListResult': return accessor(index, new ShockerCommandListResult())! as ShockerCommandListResult;
+    case 'WifiNetworkDeltaEvent': return accessor(index, new WifiNetworkDeltaEvent())! as WifiNetworkDeltaEvent;
     default: return null;
   }
 }
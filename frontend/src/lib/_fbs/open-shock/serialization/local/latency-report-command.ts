@@ -0,0 +1,30 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+/* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
+
+import * as flatbuffers from 'flatbuffers';
+
+export class LatencyReportCommand {
+  bb: flatbuffers.ByteBuffer|null = null;
+  bb_pos = 0;
+  __init(i:number, bb:flatbuffers.ByteBuffer):LatencyReportCommand {
+  this.bb_pos = i;
+  this.bb = bb;
+  return this;
+}
+
+reset():boolean {
+  return !!this.bb!.readInt8(this.bb_pos);
+}
+
+static sizeOf():number {
+  return 1;
+}
+
+static createLatencyReportCommand(builder:flatbuffers.Builder, reset: boolean):flatbuffers.Offset {
+  builder.prep(1, 1);
+  builder.writeInt8(Number(Boolean(reset)));
+  return builder.offset();
+}
+
+}
@@ -0,0 +1,60 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+/* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
+
+import * as flatbuffers from 'flatbuffers';
+
+import { LatencyStageStats } from '../../../open-shock/serialization/local/latency-stage-stats';
+
+
+export class LatencyReport {
+  bb: flatbuffers.ByteBuffer|null = null;
+  bb_pos = 0;
+  __init(i:number, bb:flatbuffers.ByteBuffer):LatencyReport {
+  this.bb_pos = i;
+  this.bb = bb;
+  return this;
+}
+
+static getRootAsLatencyReport(bb:flatbuffers.ByteBuffer, obj?:LatencyReport):LatencyReport {
+  return (obj || new LatencyReport()).__init(bb.readInt32(bb.position()) + bb.position(), bb);
+}
+
+static getSizePrefixedRootAsLatencyReport(bb:flatbuffers.ByteBuffer, obj?:LatencyReport):LatencyReport {
+  bb.setPosition(bb.position() + flatbuffers.SIZE_PREFIX_LENGTH);
+  return (obj || new LatencyReport()).__init(bb.readInt32(bb.position()) + bb.position(), bb);
+}
+
+stages(index: number, obj?:LatencyStageStats):LatencyStageStats|null {
+  const offset = this.bb!.__offset(this.bb_pos, 4);
+  return offset ? (obj || new LatencyStageStats()).__init(this.bb!.__vector(this.bb_pos + offset) + index * 20, this.bb!) : null;
+}
+
+stagesLength():number {
+  const offset = this.bb!.__offset(this.bb_pos, 4);
+  return offset ? this.bb!.__vector_len(this.bb_pos + offset) : 0;
+}
+
+static startLatencyReport(builder:flatbuffers.Builder) {
+  builder.startObject(1);
+}
+
+static addStages(builder:flatbuffers.Builder, stagesOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(0, stagesOffset, 0);
+}
+
+static startStagesVector(builder:flatbuffers.Builder, numElems:number) {
+  builder.startVector(20, numElems, 4);
+}
+
+static endLatencyReport(builder:flatbuffers.Builder):flatbuffers.Offset {
+  const offset = builder.endObject();
+  return offset;
+}
+
+static createLatencyReport(builder:flatbuffers.Builder, stagesOffset:flatbuffers.Offset):flatbuffers.Offset {
+  LatencyReport.startLatencyReport(builder);
+  LatencyReport.addStages(builder, stagesOffset);
+  return LatencyReport.endLatencyReport(builder);
+}
+}
@@ -0,0 +1,51 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+/* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
+
+import * as flatbuffers from 'flatbuffers';
+
+export class LatencyStageStats {
+  bb: flatbuffers.ByteBuffer|null = null;
+  bb_pos = 0;
+  __init(i:number, bb:flatbuffers.ByteBuffer):LatencyStageStats {
+  this.bb_pos = i;
+  this.bb = bb;
+  return this;
+}
+
+stage():number {
+  return this.bb!.readUint8(this.bb_pos);
+}
+
+count():number {
+  return this.bb!.readUint32(this.bb_pos + 4);
+}
+
+p50Us():number {
+  return this.bb!.readUint32(this.bb_pos + 8);
+}
+
+p95Us():number {
+  return this.bb!.readUint32(this.bb_pos + 12);
+}
+
+p99Us():number {
+  return this.bb!.readUint32(this.bb_pos + 16);
+}
+
+static sizeOf():number {
+  return 20;
+}
+
+static createLatencyStageStats(builder:flatbuffers.Builder, stage: number, count: number, p50_us: number, p95_us: number, p99_us: number):flatbuffers.Offset {
+  builder.prep(4, 20);
+  builder.writeInt32(p99_us);
+  builder.writeInt32(p95_us);
+  builder.writeInt32(p50_us);
+  builder.writeInt32(count);
+  builder.pad(3);
+  builder.writeInt8(stage);
+  return builder.offset();
+}
+
+}
@@ -0,0 +1,73 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+/* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
+
+import * as flatbuffers from 'flatbuffers';
+
+import { ShockerCommandResultCode } from '../../../open-shock/serialization/local/shocker-command-result-code';
+
+
+export class ShockerCommandListResult {
+  bb: flatbuffers.ByteBuffer|null = null;
+  bb_pos = 0;
+  __init(i:number, bb:flatbuffers.ByteBuffer):ShockerCommandListResult {
+  this.bb_pos = i;
+  this.bb = bb;
+  return this;
+}
+
+static getRootAsShockerCommandListResult(bb:flatbuffers.ByteBuffer, obj?:ShockerCommandListResult):ShockerCommandListResult {
+  return (obj || new ShockerCommandListResult()).__init(bb.readInt32(bb.position()) + bb.position(), bb);
+}
+
+static getSizePrefixedRootAsShockerCommandListResult(bb:flatbuffers.ByteBuffer, obj?:ShockerCommandListResult):ShockerCommandListResult {
+  bb.setPosition(bb.position() + flatbuffers.SIZE_PREFIX_LENGTH);
+  return (obj || new ShockerCommandListResult()).__init(bb.readInt32(bb.position()) + bb.position(), bb);
+}
+
+results(index: number):ShockerCommandResultCode|null {
+  const offset = this.bb!.__offset(this.bb_pos, 4);
+  return offset ? this.bb!.readUint8(this.bb!.__vector(this.bb_pos + offset) + index) : 0;
+}
+
+resultsLength():number {
+  const offset = this.bb!.__offset(this.bb_pos, 4);
+  return offset ? this.bb!.__vector_len(this.bb_pos + offset) : 0;
+}
+
+resultsArray():Uint8Array|null {
+  const offset = this.bb!.__offset(this.bb_pos, 4);
+  return offset ? new Uint8Array(this.bb!.bytes().buffer, this.bb!.bytes().byteOffset + this.bb!.__vector(this.bb_pos + offset), this.bb!.__vector_len(this.bb_pos + offset)) : null;
+}
+
+static startShockerCommandListResult(builder:flatbuffers.Builder) {
+  builder.startObject(1);
+}
+
+static addResults(builder:flatbuffers.Builder, resultsOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(0, resultsOffset, 0);
+}
+
+static createResultsVector(builder:flatbuffers.Builder, data:ShockerCommandResultCode[]):flatbuffers.Offset {
+  builder.startVector(1, data.length, 1);
+  for (let i = data.length - 1; i >= 0; i--) {
+    builder.addInt8(data[i]!);
+  }
+  return builder.endVector();
+}
+
+static startResultsVector(builder:flatbuffers.Builder, numElems:number) {
+  builder.startVector(1, numElems, 1);
+}
+
+static endShockerCommandListResult(builder:flatbuffers.Builder):flatbuffers.Offset {
+  const offset = builder.endObject();
+  return offset;
+}
+
+static createShockerCommandListResult(builder:flatbuffers.Builder, resultsOffset:flatbuffers.Offset):flatbuffers.Offset {
+  ShockerCommandListResult.startShockerCommandListResult(builder);
+  ShockerCommandListResult.addResults(builder, resultsOffset);
+  return ShockerCommandListResult.endShockerCommandListResult(builder);
+}
+}
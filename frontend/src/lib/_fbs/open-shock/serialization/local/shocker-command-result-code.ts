@@ -0,0 +1,9 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+/* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
+
+export enum ShockerCommandResultCode {
+  Success = 0,
+  InvalidCommand = 1,
+  Rejected = 2
+}
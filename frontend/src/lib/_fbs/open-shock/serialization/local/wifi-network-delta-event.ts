@@ -0,0 +1,89 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+/* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
+
+import * as flatbuffers from 'flatbuffers';
+
+import { WifiNetworkDelta } from '../../../open-shock/serialization/local/wifi-network-delta';
+
+
+export class WifiNetworkDeltaEvent {
+  bb: flatbuffers.ByteBuffer|null = null;
+  bb_pos = 0;
+  __init(i:number, bb:flatbuffers.ByteBuffer):WifiNetworkDeltaEvent {
+  this.bb_pos = i;
+  this.bb = bb;
+  return this;
+}
+
+static getRootAsWifiNetworkDeltaEvent(bb:flatbuffers.ByteBuffer, obj?:WifiNetworkDeltaEvent):WifiNetworkDeltaEvent {
+  return (obj || new WifiNetworkDeltaEvent()).__init(bb.readInt32(bb.position()) + bb.position(), bb);
+}
+
+static getSizePrefixedRootAsWifiNetworkDeltaEvent(bb:flatbuffers.ByteBuffer, obj?:WifiNetworkDeltaEvent):WifiNetworkDeltaEvent {
+  bb.setPosition(bb.position() + flatbuffers.SIZE_PREFIX_LENGTH);
+  return (obj || new WifiNetworkDeltaEvent()).__init(bb.readInt32(bb.position()) + bb.position(), bb);
+}
+
+generation():number {
+  const offset = this.bb!.__offset(this.bb_pos, 4);
+  return offset ? this.bb!.readUint32(this.bb_pos + offset) : 0;
+}
+
+updated(index: number, obj?:WifiNetworkDelta):WifiNetworkDelta|null {
+  const offset = this.bb!.__offset(this.bb_pos, 6);
+  return offset ? (obj || new WifiNetworkDelta()).__init(this.bb!.__vector(this.bb_pos + offset) + index * 8, this.bb!) : null;
+}
+
+updatedLength():number {
+  const offset = this.bb!.__offset(this.bb_pos, 6);
+  return offset ? this.bb!.__vector_len(this.bb_pos + offset) : 0;
+}
+
+lost(index: number, obj?:WifiNetworkDelta):WifiNetworkDelta|null {
+  const offset = this.bb!.__offset(this.bb_pos, 8);
+  return offset ? (obj || new WifiNetworkDelta()).__init(this.bb!.__vector(this.bb_pos + offset) + index * 8, this.bb!) : null;
+}
+
+lostLength():number {
+  const offset = this.bb!.__offset(this.bb_pos, 8);
+  return offset ? this.bb!.__vector_len(this.bb_pos + offset) : 0;
+}
+
+static startWifiNetworkDeltaEvent(builder:flatbuffers.Builder) {
+  builder.startObject(3);
+}
+
+static addGeneration(builder:flatbuffers.Builder, generation:number) {
+  builder.addFieldInt32(0, generation, 0);
+}
+
+static addUpdated(builder:flatbuffers.Builder, updatedOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(1, updatedOffset, 0);
+}
+
+static startUpdatedVector(builder:flatbuffers.Builder, numElems:number) {
+  builder.startVector(8, numElems, 1);
+}
+
+static addLost(builder:flatbuffers.Builder, lostOffset:flatbuffers.Offset) {
+  builder.addFieldOffset(2, lostOffset, 0);
+}
+
+static startLostVector(builder:flatbuffers.Builder, numElems:number) {
+  builder.startVector(8, numElems, 1);
+}
+
+static endWifiNetworkDeltaEvent(builder:flatbuffers.Builder):flatbuffers.Offset {
+  const offset = builder.endObject();
+  return offset;
+}
+
+static createWifiNetworkDeltaEvent(builder:flatbuffers.Builder, generation:number, updatedOffset:flatbuffers.Offset, lostOffset:flatbuffers.Offset):flatbuffers.Offset {
+  WifiNetworkDeltaEvent.startWifiNetworkDeltaEvent(builder);
+  WifiNetworkDeltaEvent.addGeneration(builder, generation);
+  WifiNetworkDeltaEvent.addUpdated(builder, updatedOffset);
+  WifiNetworkDeltaEvent.addLost(builder, lostOffset);
+  return WifiNetworkDeltaEvent.endWifiNetworkDeltaEvent(builder);
+}
+}
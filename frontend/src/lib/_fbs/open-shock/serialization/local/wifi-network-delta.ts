@@ -0,0 +1,44 @@
+// automatically generated by the FlatBuffers compiler, do not modify
+
+/* eslint-disable @typescript-eslint/no-unused-vars, @typescript-eslint/no-explicit-any, @typescript-eslint/no-non-null-assertion */
+
+import * as flatbuffers from 'flatbuffers';
+
+export class WifiNetworkDelta {
+  bb: flatbuffers.ByteBuffer|null = null;
+  bb_pos = 0;
+  __init(i:number, bb:flatbuffers.ByteBuffer):WifiNetworkDelta {
+  this.bb_pos = i;
+  this.bb = bb;
+  return this;
+}
+
+bssid(index: number):number|null {
+    return this.bb!.readUint8(this.bb_pos + 0 + index);
+}
+
+channel():number {
+  return this.bb!.readUint8(this.bb_pos + 6);
+}
+
+rssi():number {
+  return this.bb!.readInt8(this.bb_pos + 7);
+}
+
+static sizeOf():number {
+  return 8;
+}
+
+static createWifiNetworkDelta(builder:flatbuffers.Builder, bssid: number[]|null, channel: number, rssi: number):flatbuffers.Offset {
+  builder.prep(1, 8);
+  builder.writeInt8(rssi);
+  builder.writeInt8(channel);
+  
+  for (let i = 5; i >= 0; --i) {
+    builder.writeInt8((bssid?.[i] ?? 0));
+  }
+
+  return builder.offset();
+}
+
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "LocalOutboundQueue.h"
 #include "StringView.h"
 
 #include <freertos/portmacro.h>
@@ -20,4 +21,11 @@ namespace OpenShock::CaptivePortal {
 
   bool BroadcastMessageTXT(StringView data);
   bool BroadcastMessageBIN(const std::uint8_t* data, std::size_t len);
+
+  /// @return False if the captive portal is not running
+  bool GetOutboundStats(LocalOutboundQueue::Stats& out);
+
+  /// @brief Gets how many times the portal task has gone to sleep waiting for socket activity, a measure of how often it wakes while idle
+  /// @return False if the captive portal is not running
+  bool GetTaskWakeups(std::uint32_t& out);
 }  // namespace OpenShock::CaptivePortal
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "LocalOutboundQueue.h"
 #include "StringView.h"
 #include "WebSocketDeFragger.h"
 
@@ -11,6 +12,7 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/task.h>
 
+#include <atomic>
 #include <cstdint>
 
 namespace OpenShock {
@@ -19,13 +21,19 @@ namespace OpenShock {
     CaptivePortalInstance();
     ~CaptivePortalInstance();
 
-    bool sendMessageTXT(std::uint8_t socketId, StringView data) { return m_socketServer.sendTXT(socketId, data.data(), data.length()); }
-    bool sendMessageBIN(std::uint8_t socketId, const std::uint8_t* data, std::size_t len) { return m_socketServer.sendBIN(socketId, data, len); }
-    bool broadcastMessageTXT(StringView data) { return m_socketServer.broadcastTXT(data.data(), data.length()); }
-    bool broadcastMessageBIN(const std::uint8_t* data, std::size_t len) { return m_socketServer.broadcastBIN(data, len); }
+    // Messages are queued and written by the portal task, the socket server is not safe to use from other tasks
+    bool sendMessageTXT(std::uint8_t socketId, StringView data) { return wakeIf(m_outbound.Send(socketId, false, reinterpret_cast<const std::uint8_t*>(data.data()), data.length())); }
+    bool sendMessageBIN(std::uint8_t socketId, const std::uint8_t* data, std::size_t len) { return wakeIf(m_outbound.Send(socketId, true, data, len)); }
+    bool broadcastMessageTXT(StringView data) { return wakeIf(m_outbound.Broadcast(false, reinterpret_cast<const std::uint8_t*>(data.data()), data.length())); }
+    bool broadcastMessageBIN(const std::uint8_t* data, std::size_t len) { return wakeIf(m_outbound.Broadcast(true, data, len)); }
+
+    LocalOutboundQueue::Stats outboundStats() const { return m_outbound.GetStats(); }
+    std::uint32_t taskWakeups() const { return m_taskWakeups.load(std::memory_order_relaxed); }
 
   private:
     static void task(void* arg);
+    void waitForActivity();
+    bool wakeIf(bool queued);
     void handleWebSocketClientConnected(std::uint8_t socketId);
     void handleWebSocketClientDisconnected(std::uint8_t socketId);
     void handleWebSocketClientError(std::uint8_t socketId, std::uint16_t code, const char* message);
@@ -34,8 +42,15 @@ namespace OpenShock {
     AsyncWebServer m_webServer;
     WebSocketsServer m_socketServer;
     WebSocketDeFragger m_socketDeFragger;
+    LocalOutboundQueue m_outbound;
+    LocalOutboundQueue::Buffer m_networksSnapshot;  // Serialized network list sent to clients on connect, only touched by the portal task
+    std::uint32_t m_networksSnapshotGeneration;
     fs::LittleFSFS m_fileSystem;
     DNSServer m_dnsServer;
     TaskHandle_t m_taskHandle;
+    TaskHandle_t m_stopWaiter;
+    std::atomic<bool> m_running;
+    std::atomic<std::uint32_t> m_taskWakeups;
+    int m_wakeFd;  // eventfd that wakes the task out of select, -1 if unavailable
   };
 }  // namespace OpenShock
@@ -1,17 +1,171 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <cstring>
+#include <type_traits>
 
 namespace OpenShock::Checksum {
-  constexpr std::uint8_t CRC8(const std::uint8_t* data, std::size_t size) {
-    std::uint8_t checksum = 0;
+  /// @brief Big-endian (most significant byte first) view of an unsigned integer, independent of host byte order
+  template<typename T>
+  struct BigEndianBytes {
+    static_assert(std::is_unsigned<T>::value, "T must be an unsigned integer");
+
+    T value;
+
+    static constexpr std::size_t size() { return sizeof(T); }
+    constexpr std::uint8_t operator[](std::size_t i) const { return static_cast<std::uint8_t>(value >> ((sizeof(T) - 1 - i) * 8)); }
+  };
+
+  /// @brief Little-endian (least significant byte first) view of an unsigned integer, independent of host byte order
+  template<typename T>
+  struct LittleEndianBytes {
+    static_assert(std::is_unsigned<T>::value, "T must be an unsigned integer");
+
+    T value;
+
+    static constexpr std::size_t size() { return sizeof(T); }
+    constexpr std::uint8_t operator[](std::size_t i) const { return static_cast<std::uint8_t>(value >> (i * 8)); }
+  };
+
+  template<typename T>
+  constexpr BigEndianBytes<T> BigEndian(T value) {
+    return {value};
+  }
+  template<typename T>
+  constexpr LittleEndianBytes<T> LittleEndian(T value) {
+    return {value};
+  }
+
+  /// @brief Sum of all bytes modulo 256, used by CaiXianlin
+  struct Sum8 {
+    static constexpr std::uint8_t kInit = 0;
+
+    static constexpr std::uint8_t Update(std::uint8_t state, std::uint8_t byte) { return state + byte; }
+    static constexpr std::uint8_t Finalize(std::uint8_t state) { return state; }
+
+    static std::uint8_t UpdateWords(std::uint8_t state, const std::uint8_t* data, std::size_t words) {
+      while (words > 0) {
+        // Two 16-bit lanes each gain at most 510 per word, so 128 words fit before a lane can carry into the other
+        std::size_t batch = words < 128 ? words : 128;
+        words -= batch;
+
+        std::uint32_t lanes = 0;
+        for (std::size_t i = 0; i < batch; ++i, data += 4) {
+          std::uint32_t word;
+          std::memcpy(&word, data, sizeof(word));  // Byte order does not matter for a sum
+
+          lanes += (word & 0x00FF00FF) + ((word >> 8) & 0x00FF00FF);
+        }
+
+        state += static_cast<std::uint8_t>(lanes + (lanes >> 16));
+      }
+
+      return state;
+    }
+  };
+
+  /// @brief Table-driven, MSB-first CRC-8
+  /// @tparam Poly Generator polynomial, without the implicit x^8 term
+  template<std::uint8_t Poly, std::uint8_t Init = 0x00, std::uint8_t XorOut = 0x00>
+  struct CRC8Poly {
+    static constexpr std::uint8_t kInit = Init;
+
+    static constexpr std::uint8_t Update(std::uint8_t state, std::uint8_t byte) { return kTables[0][state ^ byte]; }
+    static constexpr std::uint8_t Finalize(std::uint8_t state) { return state ^ XorOut; }
+
+    static std::uint8_t UpdateWords(std::uint8_t state, const std::uint8_t* data, std::size_t words) {
+      // Slicing-by-4, kTables[n] advances a byte through n trailing zero bytes, and the CRC is linear so the four lookups can be combined
+      for (std::size_t i = 0; i < words; ++i, data += 4) {
+        state = kTables[3][state ^ data[0]] ^ kTables[2][data[1]] ^ kTables[1][data[2]] ^ kTables[0][data[3]];
+      }
+
+      return state;
+    }
+
+  private:
+    typedef std::array<std::array<std::uint8_t, 256>, 4> Tables;
+
+    static constexpr Tables MakeTables() {
+      Tables tables {};
+
+      for (std::size_t i = 0; i < 256; ++i) {
+        std::uint8_t crc = static_cast<std::uint8_t>(i);
+        for (int bit = 0; bit < 8; ++bit) {
+          crc = (crc & 0x80) ? static_cast<std::uint8_t>((crc << 1) ^ Poly) : static_cast<std::uint8_t>(crc << 1);
+        }
+        tables[0][i] = crc;
+      }
+
+      for (std::size_t n = 1; n < 4; ++n) {
+        for (std::size_t i = 0; i < 256; ++i) {
+          tables[n][i] = tables[0][tables[n - 1][i]];
+        }
+      }
+
+      return tables;
+    }
+
+    static constexpr Tables kTables = MakeTables();
+  };
+
+  typedef CRC8Poly<0x07> CRC8SMBus;
+  typedef CRC8Poly<0x2F, 0xFF, 0xFF> CRC8Autosar;
+  typedef CRC8Poly<0x1D, 0xFF, 0xFF> CRC8SAEJ1850;
+
+  /// @brief Checksums a byte view or any indexable byte container, usable in constant expressions
+  /// @tparam Algorithm One of the algorithms above, protocols pick theirs through this parameter
+  template<typename Algorithm, typename Bytes>
+  constexpr std::uint8_t Compute(const Bytes& bytes) {
+    std::uint8_t state = Algorithm::kInit;
+    for (std::size_t i = 0; i < bytes.size(); ++i) {
+      state = Algorithm::Update(state, bytes[i]);
+    }
+    return Algorithm::Finalize(state);
+  }
+
+  /// @brief Checksums a buffer byte by byte, usable in constant expressions
+  template<typename Algorithm>
+  constexpr std::uint8_t Compute(const std::uint8_t* data, std::size_t size) {
+    std::uint8_t state = Algorithm::kInit;
     for (std::size_t i = 0; i < size; ++i) {
-      checksum += data[i];
+      state = Algorithm::Update(state, data[i]);
+    }
+    return Algorithm::Finalize(state);
+  }
+
+  /// @brief Checksums a buffer 32 bits at a time, for larger buffers such as config blobs
+  template<typename Algorithm>
+  std::uint8_t ComputeBuffer(const void* data, std::size_t size) {
+    const std::uint8_t* bytes = reinterpret_cast<const std::uint8_t*>(data);
+
+    std::size_t words = size / 4;
+
+    std::uint8_t state = Algorithm::UpdateWords(Algorithm::kInit, bytes, words);
+    for (std::size_t i = words * 4; i < size; ++i) {
+      state = Algorithm::Update(state, bytes[i]);
     }
-    return checksum;
+
+    return Algorithm::Finalize(state);
+  }
+
+  /// @brief Byte sum, named CRC8 for historical reasons
+  constexpr std::uint8_t CRC8(const std::uint8_t* data, std::size_t size) {
+    return Compute<Sum8>(data, size);
   }
   template<typename T>
   constexpr std::uint8_t CRC8(T data) {
-    return CRC8(reinterpret_cast<std::uint8_t*>(&data), sizeof(T));
+    return Compute<Sum8>(BigEndian(data));
   }
+
+  namespace Internal {
+    constexpr std::array<std::uint8_t, 9> kCheckInput = {'1', '2', '3', '4', '5', '6', '7', '8', '9'};
+
+    // Catalogued check values for "123456789"
+    static_assert(Compute<Sum8>(kCheckInput) == 0xDD, "Sum8 check value mismatch");
+    static_assert(Compute<CRC8SMBus>(kCheckInput) == 0xF4, "CRC-8/SMBUS check value mismatch");
+    static_assert(Compute<CRC8Autosar>(kCheckInput) == 0xDF, "CRC-8/AUTOSAR check value mismatch");
+    static_assert(Compute<CRC8SAEJ1850>(kCheckInput) == 0x4B, "CRC-8/SAE-J1850 check value mismatch");
+    static_assert(Compute<Sum8>(BigEndian<std::uint32_t>(0x12345678)) == Compute<Sum8>(LittleEndian<std::uint32_t>(0x78563412)), "Byte views disagree");
+  }  // namespace Internal
 }  // namespace OpenShock::Checksum
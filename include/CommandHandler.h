@@ -1,10 +1,12 @@
 #pragma once
 
+#include "radio/RFTransmitter.h"
 #include "SetRfPinResultCode.h"
 #include "ShockerCommandType.h"
 #include "ShockerModelType.h"
 
 #include <cstdint>
+#include <vector>
 
 // TODO: This is horrible architecture. Fix it.
 
@@ -18,5 +20,8 @@ namespace OpenShock::CommandHandler {
   bool SetKeepAliveEnabled(bool enabled);
   bool SetKeepAlivePaused(bool paused);
 
+  bool GetRfSlotStats(std::vector<RFScheduler::SlotStats>& out);
+  bool GetRfTransmitStats(std::vector<RFTransmitter::TransmitStats>& out);
+
   bool HandleCommand(ShockerModelType shockerModel, std::uint16_t shockerId, ShockerCommandType type, std::uint8_t intensity, std::uint16_t durationMs);
 }  // namespace OpenShock::CommandHandler
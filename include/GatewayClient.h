@@ -1,6 +1,8 @@
 #pragma once
 
+#include "GatewayOutboundQueue.h"
 #include "StringView.h"
+#include "WebSocketDeFragger.h"
 
 #include <WebSocketsClient.h>
 
@@ -26,18 +28,25 @@ namespace OpenShock {
     void connect(const char* lcgFqdn);
     void disconnect();
 
+    /// @brief Queues a message, it is written from loop() so the caller never waits on the socket
     bool sendMessageTXT(StringView data);
     bool sendMessageBIN(const std::uint8_t* data, std::size_t length);
 
+    GatewayOutboundQueue::Stats outboundStats() const { return m_outbound.GetStats(); }
+    bool hasPendingOutbound() const { return m_outbound.HasPending(); }
+
     bool loop();
 
   private:
     void _setState(State state);
     void _sendKeepAlive();
     void _sendBootStatus();
-    void _handleEvent(WStype_t type, std::uint8_t* payload, std::size_t length);
+    void _onBootStatusSent();
+    void _handleEvent(WebSocketMessageType type, const std::uint8_t* payload, std::size_t length);
 
     WebSocketsClient m_webSocket;
+    WebSocketDeFragger m_deFragger;
+    GatewayOutboundQueue m_outbound;
     std::int64_t m_lastKeepAlive;
     State m_state;
   };
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "AccountLinkResultCode.h"
+#include "GatewayOutboundQueue.h"
 #include "StringView.h"
 
 #include <cstdint>
@@ -18,5 +19,12 @@ namespace OpenShock::GatewayConnectionManager {
   bool SendMessageTXT(StringView data);
   bool SendMessageBIN(const std::uint8_t* data, std::size_t length);
 
+  /// @return False if there is no gateway client
+  bool GetOutboundStats(GatewayOutboundQueue::Stats& out);
+
+  /// @brief Waits for the gateway task to write out everything queued so far, used right before restarting
+  /// @return False if messages were still pending when the timeout ran out
+  bool FlushOutbound(std::uint32_t timeoutMs);
+
   void Update();
 }  // namespace OpenShock::GatewayConnectionManager
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace OpenShock {
+  /// @brief Bounded queue of messages waiting to be written to the gateway socket
+  ///
+  /// Any task may enqueue, only the task that owns the socket drains, so slow TLS writes never block the producers.
+  /// Messages leave in the order they were first queued, priority only decides what gets dropped when the queue is full.
+  /// Slots keep their buffers between messages, so steady traffic does not allocate.
+  class GatewayOutboundQueue {
+  public:
+    static constexpr std::size_t kCapacity = 8;
+
+    enum class Priority : std::uint8_t {
+      Low,     // Superseded quickly, such as progress updates
+      Normal,
+      High,    // Must not be lost, such as boot status and OTA results
+    };
+
+    struct Stats {
+      std::uint32_t queued;
+      std::uint32_t coalesced;     // Replaced a pending message with the same key
+      std::uint32_t dropped;       // Evicted or rejected because the queue was full, or discarded on disconnect
+      std::uint32_t requeued;      // High priority messages put back after a failed write
+      std::uint32_t sent;
+      std::uint32_t sendFailures;
+      std::uint8_t depth;
+      std::uint8_t maxDepth;
+      std::uint32_t lastLatencyUs;  // From first being queued until the write returned
+      std::uint32_t maxLatencyUs;
+      std::uint32_t maxSendUs;      // Time spent in the write itself
+    };
+
+    typedef std::function<bool(bool binary, const std::uint8_t* data, std::size_t length)> SendFn;
+
+    GatewayOutboundQueue();
+    ~GatewayOutboundQueue();
+    GatewayOutboundQueue(const GatewayOutboundQueue&) = delete;
+    void operator=(const GatewayOutboundQueue&)      = delete;
+
+    /// @brief Queues a copy of the message
+    /// @param coalesceKey Non-zero to replace a pending message with the same key instead of queueing another one
+    /// @return False if the queue is full of messages with at least the same priority
+    bool Push(bool binary, const std::uint8_t* data, std::size_t length, Priority priority, std::uint32_t coalesceKey);
+
+    /// @brief Writes up to maxMessages queued messages, oldest first, without holding the lock during the write
+    /// @remark A High priority message whose write fails goes back to the front of the queue and ends the drain
+    /// @return Number of messages taken off the queue
+    std::size_t Drain(std::size_t maxMessages, const SendFn& send);
+
+    /// @brief Discards pending messages when the connection goes away, High priority ones are kept for the next connection
+    void Clear();
+
+    /// @return True while messages are queued or a write is still in progress
+    bool HasPending() const;
+
+    Stats GetStats() const;
+
+  private:
+    struct Entry {
+      bool used;
+      bool binary;
+      Priority priority;
+      std::uint32_t coalesceKey;
+      std::uint32_t sequence;  // Queue order
+      std::int64_t queuedUs;
+      std::vector<std::uint8_t> data;
+    };
+
+    int findOldest() const;
+    int findVictim(Priority priority) const;
+    int findSlot(Priority priority);
+
+    mutable SemaphoreHandle_t m_mutex;
+    std::array<Entry, kCapacity> m_entries;
+    std::vector<std::uint8_t> m_sending;  // Only touched by the draining task
+    bool m_inFlight;
+    std::uint32_t m_nextSequence;
+    Stats m_stats;
+  };
+}  // namespace OpenShock
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace OpenShock::LatencyTrace {
+  /// @brief Points a shocker command passes on its way from the gateway to the radio, in order
+  enum class Stage : std::uint8_t {
+    Received,     // Gateway message handed to the handler, reassembled if it was fragmented
+    Verified,     // FlatBuffers verification passed
+    Handled,      // CommandHandler::HandleCommand entered
+    Queued,       // Pushed into the transmitter's command ring
+    Dequeued,     // Taken off the ring by the transmit task
+    Transmitted,  // First frame of the command left the air
+    Count,
+  };
+
+  struct StageStats {
+    const char* name;  // Stage the interval ends at, "Total" for receipt to transmission
+    std::uint32_t count;
+    std::uint32_t p50Us;
+    std::uint32_t p95Us;
+    std::uint32_t p99Us;
+  };
+
+  /// @brief Marks the start of a gateway message on the calling task, commands handled before EndMessage are traced
+  void BeginMessage(std::int64_t receivedUs);
+  void MarkMessageVerified(std::int64_t verifiedUs);
+  void EndMessage();
+
+  /// @brief Starts a trace for a command if the calling task is handling a gateway message
+  /// @return Trace ID to pass along with the command, 0 if the command is not traced
+  std::uint32_t Begin(std::int64_t handledUs);
+
+  /// @brief Records when a traced command reached a stage, only the first time is kept
+  /// @note Lock-free, safe to call from any task. Records are reused in a ring, marks for a trace that was already overwritten are ignored.
+  void Mark(std::uint32_t traceId, Stage stage, std::int64_t timeUs);
+
+  /// @brief Gets p50/p95/p99 of the time spent between each stage and the one before it, over the traces still in the ring
+  void GetStageStats(std::vector<StageStats>& out);
+
+  void Reset();
+}  // namespace OpenShock::LatencyTrace
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace OpenShock {
+  /// @brief Per-client queues of messages waiting to be written to captive portal sockets
+  ///
+  /// A broadcast is copied once into an immutable, reference-counted buffer, and every client queue holds a reference to it.
+  /// Any task may enqueue, only the task that owns the socket server drains. Every client gets a bounded share of each drain, so a browser that reads slowly only fills its own queue.
+  class LocalOutboundQueue {
+  public:
+    static constexpr std::size_t kMaxClients     = 8;   // Above WEBSOCKETS_SERVER_CLIENT_MAX, socket IDs past this are rejected
+    static constexpr std::size_t kClientCapacity = 16;  // Room for the connect snapshot plus a burst of scan events
+
+    typedef std::shared_ptr<const std::vector<std::uint8_t>> Buffer;
+
+    struct Stats {
+      std::uint32_t broadcasts;    // Serialized once, shared by every client
+      std::uint32_t unicasts;
+      std::uint32_t sent;
+      std::uint32_t sendFailures;
+      std::uint32_t dropped;       // Oldest message discarded because a client fell behind
+      std::uint8_t clients;
+      std::uint8_t maxDepth;       // Deepest any single client queue got
+      std::uint32_t lastLatencyUs;  // From being queued until the write returned
+      std::uint32_t maxLatencyUs;
+      std::uint32_t maxSendUs;      // Time spent in the write itself
+    };
+
+    typedef std::function<bool(std::uint8_t socketId, bool binary, const std::uint8_t* data, std::size_t length)> SendFn;
+
+    /// @brief Copies a message into a buffer that can be queued for any number of clients
+    static Buffer MakeBuffer(const std::uint8_t* data, std::size_t length);
+
+    LocalOutboundQueue();
+    ~LocalOutboundQueue();
+    LocalOutboundQueue(const LocalOutboundQueue&) = delete;
+    void operator=(const LocalOutboundQueue&)    = delete;
+
+    /// @brief Starts delivering broadcasts to a socket, discarding anything left from a previous client with the same ID
+    bool AddClient(std::uint8_t socketId);
+    void RemoveClient(std::uint8_t socketId);
+
+    bool Send(std::uint8_t socketId, bool binary, const Buffer& buffer);
+    bool Send(std::uint8_t socketId, bool binary, const std::uint8_t* data, std::size_t length) { return Send(socketId, binary, MakeBuffer(data, length)); }
+
+    /// @return False if no client is connected
+    bool Broadcast(bool binary, const std::uint8_t* data, std::size_t length);
+
+    /// @brief Writes up to maxPerClient queued messages to every client, taking turns between clients, without holding the lock during the writes
+    /// @return Number of messages taken off the queues
+    std::size_t Drain(std::size_t maxPerClient, const SendFn& send);
+
+    /// @brief Checks if any client still has messages queued, such as after a drain ran out of budget
+    bool HasPending() const;
+
+    Stats GetStats() const;
+
+  private:
+    struct Entry {
+      bool binary;
+      std::int64_t queuedUs;
+      Buffer buffer;
+    };
+
+    struct Client {
+      bool active;
+      std::uint8_t head;
+      std::uint8_t size;
+      std::array<Entry, kClientCapacity> entries;
+    };
+
+    void push(Client& client, bool binary, const Buffer& buffer, std::int64_t nowUs);
+    void clear(Client& client);
+
+    mutable SemaphoreHandle_t m_mutex;
+    std::array<Client, kMaxClients> m_clients;
+    Stats m_stats;
+  };
+}  // namespace OpenShock
@@ -3,21 +3,62 @@
 #include <freertos/FreeRTOS.h>
 #include <freertos/semphr.h>
 
+#include <cstdint>
+#include <vector>
+
 namespace OpenShock {
+  /// @brief Writer-preferring read/write lock
+  ///
+  /// Once a writer is waiting, new readers queue behind it, so a steady stream of readers can not starve writers.
+  /// Ownership of the write side is a FreeRTOS mutex, so tasks blocked on a writer lend it their priority. Readers are not owned by a task and get no such boost.
+  /// Read locks are not recursive, taking a second one while a writer is waiting deadlocks.
   class ReadWriteMutex {
   public:
-    ReadWriteMutex();
+    struct Stats {
+      const char* name;
+      std::uint32_t readLocks;
+      std::uint32_t writeLocks;
+      std::uint32_t contended;  // Locks that had to wait
+      std::uint32_t timeouts;
+      std::uint32_t totalWaitUs;
+      std::uint32_t maxWaitUs;
+      std::uint32_t maxReadHoldUs;  // Longest stretch with at least one reader inside
+      std::uint32_t maxWriteHoldUs;
+    };
+
+    /// @param name If set, the lock keeps contention statistics and is listed by GetAllStats
+    ReadWriteMutex(const char* name = nullptr);
     ~ReadWriteMutex();
+    ReadWriteMutex(const ReadWriteMutex&) = delete;
+    void operator=(const ReadWriteMutex&) = delete;
 
     bool lockRead(TickType_t xTicksToWait);
     void unlockRead();
 
     bool lockWrite(TickType_t xTicksToWait);
     void unlockWrite();
+
+    bool getStats(Stats& out) const;
+
+    /// @brief Gets the statistics of every named lock
+    static void GetAllStats(std::vector<Stats>& out);
+
   private:
-    SemaphoreHandle_t m_mutex;
-    SemaphoreHandle_t m_readSem;
+    void recordWait(std::int64_t startUs);
+    void recordTimeout();
+
+    const char* m_name;
+    ReadWriteMutex* m_next;  // Registry of named locks
+
+    mutable portMUX_TYPE m_spinlock;
+    SemaphoreHandle_t m_writeMutex;      // Held by the writer from the moment it starts waiting for readers to drain
+    SemaphoreHandle_t m_readersDrained;  // Given by the last reader out while a writer is waiting
     int m_readers;
+    bool m_writer;
+
+    Stats m_stats;
+    std::int64_t m_readHoldStartUs;
+    std::int64_t m_writeHoldStartUs;
   };
 
   class ScopedReadLock {
@@ -5,7 +5,7 @@
 
 #include <WebSockets.h>
 
-#include <map>
+#include <array>
 #include <cstdint>
 #include <functional>
 
@@ -13,10 +13,14 @@ namespace OpenShock {
   class WebSocketDeFragger {
     DISABLE_COPY(WebSocketDeFragger);
   public:
+    static constexpr std::size_t kMaxSockets              = 8;     // Above WEBSOCKETS_SERVER_CLIENT_MAX, socket IDs past this are rejected
+    static constexpr std::uint32_t kDefaultMaxMessageSize = 8192;  // Per socket, larger messages are dropped instead of exhausting the heap
+    static constexpr std::uint32_t kMinCapacity           = 256;
+    static constexpr std::uint32_t kMaxRetainedCapacity   = 2048;  // Buffers that grew past this are freed after the message instead of being reused
 
     typedef std::function<void(std::uint8_t socketId, WebSocketMessageType type, const std::uint8_t* data, std::uint32_t length)> EventCallback;
 
-    WebSocketDeFragger(EventCallback callback);
+    WebSocketDeFragger(EventCallback callback, std::uint32_t maxMessageSize = kDefaultMaxMessageSize);
     ~WebSocketDeFragger();
 
     void handler(std::uint8_t socketId, WStype_t type, const std::uint8_t* payload, std::size_t length);
@@ -27,15 +31,21 @@ namespace OpenShock {
     void start(std::uint8_t socketId, WebSocketMessageType type, const std::uint8_t* data, std::uint32_t length);
     void append(std::uint8_t socketId, const std::uint8_t* data, std::uint32_t length);
     void finish(std::uint8_t socketId, const std::uint8_t* data, std::uint32_t length);
+    void reject(std::uint8_t socketId, const char* errorMessage);
 
+    // Buffers are kept across messages and only grow, so a steady stream of fragmented messages stops allocating after the first few
     struct Message {
       std::uint8_t* data;
       std::uint32_t size;
       std::uint32_t capacity;
       WebSocketMessageType type;
+      bool active;
     };
 
-    std::map<std::uint8_t, Message> m_messages;
+    bool reserve(Message& message, std::uint32_t size);
+
+    std::array<Message, kMaxSockets> m_messages;
+    std::uint32_t m_maxMessageSize;
     EventCallback m_callback;
   };
 }
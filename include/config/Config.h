@@ -10,11 +10,41 @@
 #include "StringView.h"
 
 #include <functional>
+#include <memory>
 #include <vector>
 
 namespace OpenShock::Config {
+  struct RootConfig;
+
+  struct PersistStats {
+    std::uint32_t changes;  // Setter calls that changed the config, each used to cost a flash write
+    std::uint32_t flashWrites;
+    std::uint32_t sectionsWritten;  // Before sections were stored separately, every write covered all six
+    std::uint32_t writeFailures;
+    std::uint32_t lastWriteUs;
+    std::uint32_t maxWriteUs;
+    std::uint32_t lastSetterUs;
+    std::uint32_t maxSetterUs;
+  };
+
   void Init();
 
+  /**
+   * @brief Writes pending changes to flash now instead of waiting for the save task.
+   *
+   * @note Setters only mark the config as changed and return, call this before anything that must survive a power loss right after it.
+   */
+  bool Flush();
+
+  void GetPersistStats(PersistStats& out);
+
+  /**
+   * @brief Gets the current config without copying or locking, for reading several fields consistently.
+   *
+   * @note The snapshot never changes, later setters publish a new one. Returns nullptr before Init.
+   */
+  std::shared_ptr<const RootConfig> GetSnapshot();
+
   /* GetAsJSON and SaveFromJSON are used for Reading/Writing the config file in its human-readable form. */
   std::string GetAsJSON(bool withSensitiveData);
   bool SaveFromJSON(StringView json);
@@ -1,14 +1,18 @@
 #pragma once
 
 #include "config/ConfigBase.h"
+#include "config/RFTransmitterConfig.h"
+
+#include <vector>
 
 namespace OpenShock::Config {
   struct RFConfig : public ConfigBase<Serialization::Configuration::RFConfig> {
     RFConfig();
-    RFConfig(std::uint8_t txPin, bool keepAliveEnabled);
+    RFConfig(std::uint8_t txPin, bool keepAliveEnabled, const std::vector<RFTransmitterConfig>& transmitters);
 
     std::uint8_t txPin;
     bool keepAliveEnabled;
+    std::vector<RFTransmitterConfig> transmitters;  // Additional transmitters, shockers not mapped to one of these use txPin
 
     void ToDefault() override;
 
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "config/ConfigBase.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace OpenShock::Config {
+  struct RFTransmitterConfig : public ConfigBase<Serialization::Configuration::RFTransmitterConfig> {
+    RFTransmitterConfig();
+    RFTransmitterConfig(std::uint8_t txPin, std::int8_t coreId, const std::vector<std::uint16_t>& shockerIds);
+
+    std::uint8_t txPin;
+    std::int8_t coreId;  // -1 lets the scheduler pick either core
+    std::vector<std::uint16_t> shockerIds;
+
+    void ToDefault() override;
+
+    bool FromFlatbuffers(const Serialization::Configuration::RFTransmitterConfig* config) override;
+    flatbuffers::Offset<Serialization::Configuration::RFTransmitterConfig> ToFlatbuffers(flatbuffers::FlatBufferBuilder& builder, bool withSensitiveData) const override;
+
+    bool FromJSON(const cJSON* json) override;
+    cJSON* ToJSON(bool withSensitiveData) const override;
+  };
+}  // namespace OpenShock::Config
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+namespace OpenShock::Config::Internal::RawPartition {
+  /// @brief Label of the optional raw config partition, boards without it keep the config on LittleFS
+  constexpr const char* kPartitionLabel = "rawconfig";
+
+  /// @brief Header at the start of each slot, written after the payload so a torn write never looks valid
+  struct SlotHeader {
+    std::uint32_t magic;
+    std::uint32_t sequence;  // Highest valid sequence is the current config
+    std::uint32_t size;
+    std::uint8_t checksum;  // CRC-8 of the payload
+    std::uint8_t reserved[3];
+  };
+  static_assert(sizeof(SlotHeader) == 16, "SlotHeader layout changed");
+
+  constexpr std::uint32_t kSlotMagic  = 0x4643534F;  // "OSCF"
+  constexpr std::uint32_t kSectorSize = 4096;
+
+  /// @brief Finds the newest valid slot in a partition image, without touching flash APIs so it can run against any mapping
+  /// @return Index of the slot, or -1 if no slot holds a valid header
+  int FindLatestSlot(const std::uint8_t* base, std::uint32_t partitionSize, std::uint32_t slotSize);
+
+  /// @brief Finds and maps the partition
+  /// @return False if there is no raw config partition, or it is too small for two slots
+  bool Init();
+  bool IsAvailable();
+
+  /// @brief Gets the current config straight from mapped flash, valid until the next Write
+  /// @return False if no slot holds a valid config yet
+  bool GetLatest(const std::uint8_t*& data, std::uint32_t& size);
+
+  /// @brief Writes a config into the older slot, it only becomes current once its header is written
+  /// @remark Every write erases the sectors the whole config covers in one of two fixed slots, there is no wear leveling across the partition like LittleFS does
+  bool Write(const std::uint8_t* data, std::uint32_t size);
+}  // namespace OpenShock::Config::Internal::RawPartition
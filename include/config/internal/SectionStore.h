@@ -0,0 +1,64 @@
+#pragma once
+
+#include "config/RootConfig.h"
+
+#include <FS.h>
+
+#include <cstdint>
+
+namespace OpenShock::Config::Internal::SectionStore {
+  /// @brief Parts of RootConfig that are persisted independently, each in its own file
+  enum class Section : std::uint8_t {
+    RF,
+    WiFi,
+    CaptivePortal,
+    Backend,
+    SerialInput,
+    OtaUpdate,
+  };
+
+  constexpr std::uint8_t kSectionCount = 6;
+  constexpr std::uint8_t kAllSections  = (1 << kSectionCount) - 1;
+
+  constexpr std::uint8_t SectionBit(Section section) {
+    return 1 << static_cast<std::uint8_t>(section);
+  }
+
+  /// @brief Header in front of each section file, the version is bumped when a section's schema changes incompatibly
+  struct SectionHeader {
+    std::uint32_t magic;
+    std::uint8_t section;
+    std::uint8_t version;
+    std::uint8_t checksum;  // CRC-8 of the payload
+    std::uint8_t reserved;
+    std::uint32_t size;
+  };
+  static_assert(sizeof(SectionHeader) == 12, "SectionHeader layout changed");
+
+  constexpr std::uint32_t kSectionMagic  = 0x5343534F;  // "OSCS"
+  constexpr std::uint8_t kSectionVersion = 1;
+
+  /// @brief Written once every section of a multi-section save sits in its temp file, renaming it into place commits the save
+  struct CommitRecord {
+    std::uint32_t magic;
+    std::uint8_t sections;  // Sections whose temp files belong to the save
+    std::uint8_t checksum;  // CRC-8 of sections
+    std::uint16_t reserved;
+  };
+  static_assert(sizeof(CommitRecord) == 8, "CommitRecord layout changed");
+
+  constexpr std::uint32_t kCommitMagic = 0x4343534F;  // "OSCC"
+
+  /// @brief Whether any section has been written, if not the config is still in the single-file format
+  bool Exists(fs::FS& fs);
+
+  /// @brief Finishes or discards an interrupted save, then loads every section into config, sections that are missing or fail their checks are reset to defaults
+  /// @param invalid Bits of the sections that were reset and should be written back
+  void Load(fs::FS& fs, RootConfig& config, std::uint8_t& invalid);
+
+  /// @brief Writes the given sections as one unit, after a power loss Load sees either all of them or none
+  ///
+  /// Every section is written to a temp file first. A single section is then renamed over the old file, for several a commit record is renamed into place before any of them are.
+  /// @param failed Bits of the sections that could not be written, if writing any temp file fails that is all of them
+  bool Save(fs::FS& fs, const RootConfig& config, std::uint8_t sections, std::uint8_t& failed);
+}  // namespace OpenShock::Config::Internal::SectionStore
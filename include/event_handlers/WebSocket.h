@@ -1,8 +1,27 @@
 #pragma once
 
 #include <cstdint>
+#include <vector>
 
 namespace OpenShock::EventHandlers::WebSocket {
+  /// @brief Largest message accepted from the gateway, fragmented messages are reassembled up to this size
+  constexpr std::uint32_t GATEWAY_MAX_MESSAGE_SIZE = 16 * 1024;
+  /// @brief Largest message accepted from the local captive portal, fragmented messages are reassembled up to this size
+  constexpr std::uint32_t LOCAL_MAX_MESSAGE_SIZE = 4096;
+
+  struct VerifyStats {
+    const char* payloadType;
+    std::uint32_t messages;  // Verified and within the size limit of their payload type
+    std::uint32_t rejected;
+    std::uint32_t largestSize;
+    std::uint32_t totalVerifyUs;
+    std::uint32_t maxVerifyUs;
+  };
+
   void HandleGatewayBinary(const std::uint8_t* data, std::size_t len);
   void HandleLocalBinary(std::uint8_t socketId, const std::uint8_t* data, std::size_t len);
+
+  /// @brief Gets verification counters per payload type, messages that failed verification are counted under NONE
+  void GetGatewayVerifyStats(std::vector<VerifyStats>& out);
+  void GetLocalVerifyStats(std::vector<VerifyStats>& out);
 }
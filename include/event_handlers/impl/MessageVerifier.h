@@ -0,0 +1,120 @@
+#pragma once
+
+#include "event_handlers/WebSocket.h"
+#include "Time.h"
+
+#include <flatbuffers/flatbuffers.h>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace OpenShock::EventHandlers::WebSocket::_Private {
+  /// @brief Verifies incoming messages against a size limit per payload type, and counts how long verification takes for each type
+  /// @tparam Message Root table of the schema
+  /// @tparam PayloadType Union type enum of the root table
+  /// @tparam EnumName Generated name lookup for PayloadType, used when reporting stats
+  template<typename Message, typename PayloadType, const char* (*EnumName)(PayloadType)>
+  class MessageVerifier {
+  public:
+    static constexpr std::size_t kPayloadCount = static_cast<std::size_t>(PayloadType::MAX) + 1;
+    typedef std::array<std::uint32_t, kPayloadCount> SizeLimits;
+
+    /// @param maxSize Limit for any message, checked before verification
+    /// @param payloadMaxSizes Limit for each payload type, checked once the type is known
+    MessageVerifier(std::uint32_t maxSize, const SizeLimits& payloadMaxSizes) : m_options(), m_payloadMaxSizes(payloadMaxSizes), m_counters() { m_options.max_size = maxSize; }
+    MessageVerifier(const MessageVerifier&) = delete;
+    void operator=(const MessageVerifier&)  = delete;
+
+    /// @brief Verifies a buffer, only call from the task that receives the messages
+    /// @return The verified root table, or nullptr if the message was rejected
+    const Message* Verify(const std::uint8_t* data, std::size_t len) {
+      // Messages that fail before their type is known are counted under NONE
+      if (len >= m_options.max_size) {
+        record(0, len, 0, false);  // The verifier asserts on buffers at or above its max size
+        return nullptr;
+      }
+
+      std::int64_t startUs = OpenShock::micros();
+
+      flatbuffers::Verifier verifier(data, len, m_options);
+      bool verified = verifier.VerifyBuffer<Message>(nullptr);
+
+      std::uint32_t elapsedUs = static_cast<std::uint32_t>(OpenShock::micros() - startUs);
+
+      if (!verified) {
+        record(0, len, elapsedUs, false);
+        return nullptr;
+      }
+
+      const Message* msg = flatbuffers::GetRoot<Message>(data);
+
+      std::size_t index = static_cast<std::size_t>(msg->payload_type());
+      if (index >= kPayloadCount) {
+        record(0, len, elapsedUs, true);
+        return msg;  // Left to the invalid message handler
+      }
+
+      bool accepted = len <= m_payloadMaxSizes[index];
+      record(index, len, elapsedUs, accepted);
+
+      return accepted ? msg : nullptr;
+    }
+
+    /// @brief Gets the counters of every payload type that has been received, safe to call from any task
+    void GetStats(std::vector<VerifyStats>& out) const {
+      for (std::size_t i = 0; i < kPayloadCount; ++i) {
+        const Counters& counters = m_counters[i];
+
+        std::uint32_t messages = counters.messages.load(std::memory_order_relaxed);
+        std::uint32_t rejected = counters.rejected.load(std::memory_order_relaxed);
+        if (messages == 0 && rejected == 0) {
+          continue;
+        }
+
+        out.push_back({
+          .payloadType   = EnumName(static_cast<PayloadType>(i)),
+          .messages      = messages,
+          .rejected      = rejected,
+          .largestSize   = counters.largestSize.load(std::memory_order_relaxed),
+          .totalVerifyUs = counters.totalVerifyUs.load(std::memory_order_relaxed),
+          .maxVerifyUs   = counters.maxVerifyUs.load(std::memory_order_relaxed),
+        });
+      }
+    }
+
+  private:
+    // Only the receiving task writes, so plain load/store is enough for the maximums
+    struct Counters {
+      std::atomic<std::uint32_t> messages;
+      std::atomic<std::uint32_t> rejected;
+      std::atomic<std::uint32_t> largestSize;
+      std::atomic<std::uint32_t> totalVerifyUs;
+      std::atomic<std::uint32_t> maxVerifyUs;
+    };
+
+    void record(std::size_t index, std::size_t len, std::uint32_t elapsedUs, bool accepted) {
+      Counters& counters = m_counters[index];
+
+      if (accepted) {
+        counters.messages.fetch_add(1, std::memory_order_relaxed);
+      } else {
+        counters.rejected.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      counters.totalVerifyUs.fetch_add(elapsedUs, std::memory_order_relaxed);
+
+      if (len > counters.largestSize.load(std::memory_order_relaxed)) {
+        counters.largestSize.store(static_cast<std::uint32_t>(len), std::memory_order_relaxed);
+      }
+      if (elapsedUs > counters.maxVerifyUs.load(std::memory_order_relaxed)) {
+        counters.maxVerifyUs.store(elapsedUs, std::memory_order_relaxed);
+      }
+    }
+
+    flatbuffers::Verifier::Options m_options;
+    SizeLimits m_payloadMaxSizes;
+    std::array<Counters, kPayloadCount> m_counters;
+  };
+}  // namespace OpenShock::EventHandlers::WebSocket::_Private
@@ -18,4 +18,6 @@ namespace OpenShock::MessageHandlers::Local::_Private {
   WS_EVENT_HANDLER_SIGNATURE(HandleAccountLinkCommand);
   WS_EVENT_HANDLER_SIGNATURE(HandleAccountUnlinkCommand);
   WS_EVENT_HANDLER_SIGNATURE(HandleSetRfTxPinCommand);
+  WS_EVENT_HANDLER_SIGNATURE(HandleLatencyReportCommand);
+  WS_EVENT_HANDLER_SIGNATURE(HandleShockerCommandList);
 }  // namespace OpenShock::MessageHandlers::Local::_Private
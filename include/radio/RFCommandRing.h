@@ -0,0 +1,77 @@
+#pragma once
+
+#include "radio/rmt/MainEncoder.h"
+#include "ShockerModelType.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace OpenShock {
+  /// @brief Fixed-size single-producer single-consumer ring of inline RF commands
+  ///
+  /// Records are stored in place, so pushing and popping never touch the heap.
+  /// A command that is still waiting in the ring is replaced in place when a newer command for the same shocker may overwrite it.
+  /// Producers must be serialized by the caller, the consumer is the transmit task.
+  class RFCommandRing {
+  public:
+    static constexpr std::size_t kCapacity = 16;  // Pending commands are coalesced per shocker, so this only has to cover a burst of distinct shockers
+
+    struct Command {
+      ShockerModelType model;
+      std::uint16_t shockerId;
+      bool overwrite;
+      std::int64_t untilUs;
+      std::int64_t queuedUs;
+      std::uint32_t traceId;  // LatencyTrace ID, 0 if untraced
+      Rmt::Sequence sequence;
+      Rmt::Sequence zeroSequence;
+    };
+
+    struct Stats {
+      std::uint32_t pushed;
+      std::uint32_t coalesced;
+      std::uint32_t dropped;  // Ring was full
+    };
+
+    RFCommandRing();
+    RFCommandRing(const RFCommandRing&)   = delete;
+    void operator=(const RFCommandRing&) = delete;
+
+    /// @brief Producer side, replaces the newest pending command for the same shocker if that one may be overwritten
+    /// @return False if the ring is full
+    bool Push(const Command& command);
+
+    /// @brief Producer side, cancels every command the consumer has not started reading yet
+    void Cancel();
+
+    /// @brief Consumer side, takes the oldest pending command
+    /// @return False if there is nothing to read right now, the producer signals the consumer again once a command is ready
+    bool Pop(Command& out);
+
+    Stats GetStats() const;
+
+  private:
+    static_assert((kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of two");
+
+    enum class RecordState : std::uint8_t {
+      Free,
+      Ready,
+      Writing,  // Producer is replacing the command in place
+      Reading,  // Consumer is copying the command out
+      Cancelled,
+    };
+
+    struct Record {
+      std::atomic<RecordState> state;
+      Command command;
+    };
+
+    std::array<Record, kCapacity> m_records;
+    std::atomic<std::size_t> m_head;  // Next record to read, only written by the consumer
+    std::atomic<std::size_t> m_tail;  // Next record to write, only written by the producer
+    std::atomic<std::uint32_t> m_pushed;
+    std::atomic<std::uint32_t> m_coalesced;
+    std::atomic<std::uint32_t> m_dropped;
+  };
+}  // namespace OpenShock
@@ -0,0 +1,122 @@
+#pragma once
+
+#include "radio/rmt/MainEncoder.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace OpenShock {
+  /// @brief Decides which shocker gets the next RF frame
+  ///
+  /// Active commands live in a fixed-size table indexed by a hash of the shocker ID, and a min-heap orders them by the time their next frame is due.
+  /// All times are passed in by the caller in microseconds, so this class has no dependency on FreeRTOS or the RMT driver and can be driven by a simulated clock.
+  class RFScheduler {
+  public:
+    static constexpr std::size_t kSlotBits  = 4;
+    static constexpr std::size_t kSlotCount = 1 << kSlotBits;  // Keeps the table at most half full with 8 shockers
+
+    enum class FairnessPolicy : std::uint8_t {
+      RoundRobin,      // Slots are served back to back in least-recently-served order, using all available airtime
+      FixedFrameRate,  // Slots are paced to one frame per frameIntervalUs, leaving the radio idle in between
+    };
+
+    struct Config {
+      FairnessPolicy policy;
+      std::int64_t frameIntervalUs;        // Time a slot may go without a frame before it counts as a missed deadline (RoundRobin), or the frame period (FixedFrameRate)
+      std::int64_t transmitEndDurationUs;  // How long the zero sequence is repeated after a command ends
+    };
+
+    struct SlotStats {
+      std::uint16_t shockerId;
+      std::uint32_t framesSent;
+      std::uint32_t missedDeadlines;
+    };
+
+    struct Transmission {
+      std::uint8_t slotIndex;
+      ShockerModelType model;
+      const Rmt::Sequence* sequence;
+      std::int64_t deadlineUs;   // When the frame became due
+      std::int64_t submittedUs;  // When the command was submitted, 0 if an earlier frame of it already went out
+      std::uint32_t traceId;     // LatencyTrace ID of the command, 0 if untraced or an earlier frame of it already went out
+    };
+
+    RFScheduler(const Config& config);
+    RFScheduler(const RFScheduler&)     = delete;
+    void operator=(const RFScheduler&) = delete;
+
+    void SetConfig(const Config& config);
+
+    inline bool empty() const { return m_usedCount == 0; }
+
+    /// @brief Adds or replaces the command for a shocker
+    /// @return False if the command was dropped, either because the table is full or the existing command may not be overwritten
+    bool Submit(ShockerModelType model, std::uint16_t shockerId, std::int64_t untilUs, const Rmt::Sequence& sequence, const Rmt::Sequence& zeroSequence, bool overwrite, std::int64_t submittedUs, std::uint32_t traceId = 0);
+
+    /// @brief Cuts every active command short, so only the end sequence is sent from now on
+    void ExpireAll(std::int64_t untilUs);
+
+    /// @brief Removes every active command
+    void Clear();
+
+    /// @brief Time at which the next frame is due, only valid if the scheduler is not empty
+    std::int64_t NextDeadline() const;
+
+    /// @brief Takes the slot with the earliest deadline if it is due
+    /// @return True if a frame should be transmitted now, out is only valid until Complete is called
+    bool Pop(std::int64_t nowUs, Transmission& out);
+
+    /// @brief Like Pop, but only takes the slot if it is for the given model, used to batch frames into one burst
+    bool Pop(std::int64_t nowUs, ShockerModelType model, Transmission& out);
+
+    /// @brief Accounts for a transmitted frame and reschedules or releases the slot
+    void Complete(const Transmission& transmission, std::int64_t nowUs);
+
+    /// @brief Gets the counters of every active slot, safe to call from any task
+    void GetSlotStats(std::vector<SlotStats>& out) const;
+
+  private:
+    enum class SlotState : std::uint8_t {
+      Empty,
+      Used,
+      Deleted,  // Tombstone, keeps probe chains intact until the table drains
+    };
+
+    // State, ID and counters are atomic so GetSlotStats can be called from outside the transmit task
+    struct Slot {
+      std::atomic<SlotState> state;
+      std::atomic<std::uint16_t> shockerId;
+      bool scheduled;  // False while the slot is popped for transmission
+      bool overwrite;
+      ShockerModelType model;
+      std::int64_t untilUs;
+      std::int64_t deadlineUs;
+      std::int64_t submittedUs;
+      std::uint32_t traceId;
+      Rmt::Sequence sequence;
+      Rmt::Sequence zeroSequence;
+      std::atomic<std::uint32_t> framesSent;
+      std::atomic<std::uint32_t> missedDeadlines;
+    };
+
+    static constexpr std::size_t slotIndexFor(std::uint16_t shockerId) {
+      // Fibonacci hashing, sequential IDs spread over the whole table
+      return static_cast<std::uint16_t>(shockerId * 40503U) >> (16 - kSlotBits);
+    }
+
+    int findSlot(std::uint16_t shockerId) const;
+    int allocateSlot(std::uint16_t shockerId);
+    void releaseSlot(std::uint8_t slotIndex);
+    void heapPush(std::uint8_t slotIndex);
+    std::uint8_t heapPop();
+    bool pop(std::int64_t nowUs, const ShockerModelType* model, Transmission& out);
+
+    Config m_config;
+    std::array<Slot, kSlotCount> m_slots;
+    std::array<std::uint8_t, kSlotCount> m_heap;
+    std::size_t m_heapSize;
+    std::size_t m_usedCount;
+  };
+}  // namespace OpenShock
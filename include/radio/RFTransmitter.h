@@ -1,37 +1,71 @@
 #pragma once
 
+#include "radio/RFCommandRing.h"
+#include "radio/RFScheduler.h"
+#include "radio/rmt/MainEncoder.h"
 #include "ShockerCommandType.h"
 #include "ShockerModelType.h"
 
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <memory>
+#include <vector>
 
 // Forward definitions to remove clutter
 struct rmt_obj_s;
 typedef rmt_obj_s rmt_obj_t;
-struct QueueDefinition;
-typedef QueueDefinition* QueueHandle_t;
 typedef void* TaskHandle_t;
 
 namespace OpenShock {
   class RFTransmitter {
   public:
-    RFTransmitter(std::uint8_t gpioPin);
+    static constexpr std::size_t kMaxBurstFrames = 4;  // Due frames of the same model are sent back to back in a single write
+
+    struct TransmitStats {
+      std::uint8_t txPin;
+      std::uint32_t framesSent;
+      std::uint32_t burstsSent;  // RMT writes, each carrying one or more frames
+      std::uint32_t lastInterFrameGapUs;  // Idle time between two back to back frames
+      std::uint32_t maxInterFrameGapUs;
+      std::uint32_t lastLatencyUs;  // Time from a command being sent to its first frame going on air
+      std::uint32_t maxLatencyUs;
+      RFCommandRing::Stats commands;
+    };
+
+    /// @param coreId Core to pin the transmit task to, -1 lets the scheduler pick either core
+    RFTransmitter(std::uint8_t gpioPin, std::int8_t coreId = 1);
     ~RFTransmitter();
 
     inline std::uint8_t GetTxPin() const { return m_txPin; }
 
-    inline bool ok() const { return m_rmtHandle != nullptr && m_queueHandle != nullptr && m_taskHandle != nullptr; }
+    inline bool ok() const { return m_rmtHandle != nullptr && m_taskHandle != nullptr; }
 
-    bool SendCommand(ShockerModelType model, std::uint16_t shockerId, ShockerCommandType type, std::uint8_t intensity, std::uint16_t durationMs, bool overwriteExisting = true);
+    /// @note Commands go through a single-producer ring, calls to SendCommand and ClearPendingCommands must not overlap
+    bool SendCommand(ShockerModelType model, std::uint16_t shockerId, ShockerCommandType type, std::uint8_t intensity, std::uint16_t durationMs, bool overwriteExisting = true, std::uint32_t traceId = 0);
     void ClearPendingCommands();
 
+    void GetSlotStats(std::vector<RFScheduler::SlotStats>& out) const;
+    TransmitStats GetTransmitStats() const;
+
   private:
+    typedef Rmt::PulseFrame<Rmt::kMaxSequenceLength * kMaxBurstFrames> Burst;
+
     void destroy();
     static void TransmitTask(void* arg);
 
     std::uint8_t m_txPin;
     rmt_obj_t* m_rmtHandle;
-    QueueHandle_t m_queueHandle;
     TaskHandle_t m_taskHandle;
+    std::unique_ptr<RFCommandRing> m_commands;  // Producers are serialized by the caller, see CommandHandler
+    std::atomic<bool> m_stopRequested;
+    std::unique_ptr<RFScheduler> m_scheduler;  // Owned by the transmit task, only stats may be read from other tasks
+    std::array<Burst, 2> m_txBuffers;  // One is on air while the next burst is prepared in the other
+    std::atomic<std::uint32_t> m_framesSent;
+    std::atomic<std::uint32_t> m_burstsSent;
+    std::atomic<std::uint32_t> m_lastInterFrameGapUs;
+    std::atomic<std::uint32_t> m_maxInterFrameGapUs;
+    std::atomic<std::uint32_t> m_lastLatencyUs;
+    std::atomic<std::uint32_t> m_maxLatencyUs;
   };
 }  // namespace OpenShock
@@ -1,17 +1,48 @@
 #pragma once
 
+#include "radio/rmt/CaiXianlinEncoder.h"
+#include "radio/rmt/Petrainer998DREncoder.h"
+#include "radio/rmt/PetrainerEncoder.h"
+#include "radio/rmt/PulseFrame.h"
 #include "ShockerCommandType.h"
 #include "ShockerModelType.h"
 
 #include <esp32-hal-rmt.h>
 
+#include <algorithm>
 #include <cstdint>
-#include <memory>
-#include <vector>
 
 namespace OpenShock::Rmt {
-  std::vector<rmt_data_t> GetSequence(ShockerModelType model, std::uint16_t shockerId, OpenShock::ShockerCommandType type, std::uint8_t intensity);
-  inline std::vector<rmt_data_t> GetZeroSequence(ShockerModelType model, std::uint16_t shockerId) {
+  /// @brief Largest pulse count of any supported protocol
+  constexpr std::size_t kMaxSequenceLength = std::max({PetrainerEncoder::kPulseCount, Petrainer998DREncoder::kPulseCount, CaiXianlinEncoder::kPulseCount});
+  typedef PulseFrame<kMaxSequenceLength> Sequence;
+
+  constexpr Sequence GetSequence(ShockerModelType model, std::uint16_t shockerId, OpenShock::ShockerCommandType type, std::uint8_t intensity) {
+    switch (model) {
+      case ShockerModelType::Petrainer:
+        return PetrainerEncoder::GetSequence(shockerId, type, intensity);
+      case ShockerModelType::Petrainer998DR:
+        return Petrainer998DREncoder::GetSequence(shockerId, type, intensity);
+      case ShockerModelType::CaiXianlin:
+        return CaiXianlinEncoder::GetSequence(shockerId, 0, type, intensity);
+      default:
+        return {};  // Unknown model
+    }
+  }
+  /// @brief Quiet time in ticks to insert after a frame when frames are sent back to back in one write
+  constexpr std::uint16_t GetInterFrameGap(ShockerModelType model) {
+    switch (model) {
+      case ShockerModelType::Petrainer:
+        return PetrainerEncoder::kInterFrameGap;
+      case ShockerModelType::Petrainer998DR:
+        return Petrainer998DREncoder::kInterFrameGap;
+      case ShockerModelType::CaiXianlin:
+        return CaiXianlinEncoder::kInterFrameGap;
+      default:
+        return 0;
+    }
+  }
+  constexpr Sequence GetZeroSequence(ShockerModelType model, std::uint16_t shockerId) {
     return GetSequence(model, shockerId, ShockerCommandType::Vibrate, 0);
   }
-}
+}  // namespace OpenShock::Rmt
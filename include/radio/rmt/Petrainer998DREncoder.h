@@ -1,12 +1,71 @@
 #pragma once
 
+#include "radio/rmt/internal/Shared.h"
+#include "radio/rmt/PulseFrame.h"
 #include "ShockerCommandType.h"
 
 #include <esp32-hal-rmt.h>
 
+#include <algorithm>
 #include <cstdint>
-#include <vector>
 
 namespace OpenShock::Rmt::Petrainer998DREncoder {
-  std::vector<rmt_data_t> GetSequence(std::uint16_t shockerId, OpenShock::ShockerCommandType type, std::uint8_t intensity);
-}
+  constexpr std::size_t kPulseCount = 43;
+  typedef PulseFrame<kPulseCount> Frame;
+
+  constexpr rmt_data_t kRmtPreamble  = {1500, 1, 750, 0};
+  constexpr rmt_data_t kRmtOne       = {750, 1, 250, 0};
+  constexpr rmt_data_t kRmtZero      = {250, 1, 750, 0};
+  constexpr rmt_data_t kRmtPostamble = {1500, 0, 1500, 0}; // Some subvariants expect a quiet period between commands
+
+  constexpr std::uint16_t kInterFrameGap = 0;  // The postamble is the quiet period
+
+  constexpr Frame GetSequence(std::uint16_t shockerId, OpenShock::ShockerCommandType type, std::uint8_t intensity) {
+    // Intensity must be between 0 and 100
+    intensity = std::min(intensity, static_cast<std::uint8_t>(100));
+
+    std::uint8_t typeVal = 0;
+    // typeInvert has the value of typeVal but bits are reversed and inverted
+    std::uint8_t typeInvert = 0;
+    switch (type) {
+    case ShockerCommandType::Shock:
+      typeVal    = 0b0001;
+      typeInvert = 0b0111;
+      break;
+    case ShockerCommandType::Vibrate:
+      typeVal    = 0b0010;
+      typeInvert = 0b1011;
+      break;
+    case ShockerCommandType::Sound:
+      typeVal    = 0b0100;
+      typeInvert = 0b1101;
+      break;
+    // case ShockerCommandType::Light:
+    //   typeVal    = 0b1000;
+    //   typeInvert = 0b1110;
+    //   break;
+    default:
+      return {}; // Invalid type
+    }
+
+    // TODO: Channel argument?
+    // Can be [000] or [111], 3 bits wide
+    std::uint8_t channel = 0b000;
+    std::uint8_t channelInvert = 0b111;
+
+    // Payload layout: [channel:3][typeVal:4][shockerID:17][intensity:7][typeInvert:4][channelInvert:3]
+    std::uint64_t data = (static_cast<std::uint64_t>(channel & 0b111) << 35 | static_cast<std::uint64_t>(typeVal & 0b1111) << 31 | static_cast<std::uint64_t>(shockerId & 0x1FFFF) << 14 | static_cast<std::uint64_t>(intensity & 0x7F) << 7 | static_cast<std::uint64_t>(typeInvert & 0b1111) << 3 | static_cast<std::uint64_t>(channelInvert & 0b111));
+
+    Frame frame;
+
+    // Generate the sequence
+    frame.push_back(kRmtPreamble);
+    frame.push_back(kRmtOne);
+    Internal::EncodeBits<38>(frame, data, kRmtOne, kRmtZero);
+    frame.push_back(kRmtZero);
+    frame.push_back(kRmtZero);
+    frame.push_back(kRmtPostamble);
+
+    return frame;
+  }
+}  // namespace OpenShock::Rmt::Petrainer998DREncoder
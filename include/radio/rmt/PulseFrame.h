@@ -0,0 +1,69 @@
+#pragma once
+
+#include <esp32-hal-rmt.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace OpenShock::Rmt {
+  /// @brief Fixed-capacity RMT pulse buffer, usable in constant expressions
+  /// @tparam N Maximum number of pulses the frame can hold
+  template<std::size_t N>
+  struct PulseFrame {
+    static_assert(N > 0, "N must be greater than 0");
+
+    std::array<rmt_data_t, N> pulses;
+    std::size_t length;
+
+    constexpr PulseFrame() : pulses(), length(0) { }
+
+    /// @brief Widens a smaller frame into this one
+    template<std::size_t M>
+    constexpr PulseFrame(const PulseFrame<M>& other) : pulses(), length(other.length) {
+      static_assert(M <= N, "Source frame does not fit in destination frame");
+      for (std::size_t i = 0; i < other.length; ++i) {
+        pulses[i] = other.pulses[i];
+      }
+    }
+
+    static constexpr std::size_t capacity() { return N; }
+    constexpr std::size_t size() const { return length; }
+    constexpr bool empty() const { return length == 0; }
+    constexpr rmt_data_t* data() { return pulses.data(); }
+    constexpr const rmt_data_t* data() const { return pulses.data(); }
+
+    /// @brief Total airtime of the frame in RMT ticks
+    constexpr std::uint32_t duration() const {
+      std::uint32_t ticks = 0;
+      for (std::size_t i = 0; i < length; ++i) {
+        ticks += pulses[i].duration0 + pulses[i].duration1;
+      }
+      return ticks;
+    }
+
+    constexpr void clear() { length = 0; }
+
+    /// @note No bounds checking is done at runtime, encoders are sized at compile time
+    constexpr void push_back(const rmt_data_t& pulse) { pulses[length++] = pulse; }
+
+    /// @brief Appends another frame, followed by the given number of quiet ticks
+    /// @return False if the frame does not fit, leaving this frame unchanged
+    template<std::size_t M>
+    constexpr bool append(const PulseFrame<M>& other, std::uint16_t gapTicks = 0) {
+      if (other.length == 0 || other.length > N - length) {
+        return false;
+      }
+
+      for (std::size_t i = 0; i < other.length; ++i) {
+        pulses[length++] = other.pulses[i];
+      }
+
+      // Stretch the final low period instead of spending an item on the gap, durations are 15 bits wide
+      rmt_data_t& last = pulses[length - 1];
+      last.duration1   = std::min<std::uint32_t>(last.duration1 + gapTicks, 0x7FFF);
+
+      return true;
+    }
+  };
+}  // namespace OpenShock::Rmt
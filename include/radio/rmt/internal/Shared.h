@@ -1,22 +1,60 @@
 #pragma once
 
+#include "radio/rmt/PulseFrame.h"
+
 #include <esp32-hal-rmt.h>
 
 #include <cstdint>
 #include <limits>
 #include <type_traits>
-#include <vector>
+#include <utility>
 
 namespace OpenShock::Rmt::Internal {
-  template<std::size_t N, typename T>
-  inline void EncodeBits(std::vector<rmt_data_t>& pulses, T data, const rmt_data_t& rmtOne, const rmt_data_t& rmtZero) {
+  template<std::size_t N, typename T, std::size_t M, std::size_t... I>
+  constexpr void EncodeBitsUnrolled(PulseFrame<M>& frame, T data, const rmt_data_t& rmtOne, const rmt_data_t& rmtZero, std::index_sequence<I...>) {
+    // Most significant bit first
+    (frame.push_back((data >> (N - 1 - I)) & 1 ? rmtOne : rmtZero), ...);
+  }
+
+  template<std::size_t N, typename T, std::size_t M>
+  constexpr void EncodeBits(PulseFrame<M>& frame, T data, const rmt_data_t& rmtOne, const rmt_data_t& rmtZero) {
     static_assert(std::is_unsigned<T>::value, "T must be an unsigned integer");
     static_assert(N > 0, "N must be greater than 0");
     static_assert(N < std::numeric_limits<T>::digits, "N must be less or equal to the number of bits in T");
+    static_assert(N <= M, "N must fit in the frame");
+
+    EncodeBitsUnrolled<N>(frame, data, rmtOne, rmtZero, std::make_index_sequence<N>());
+  }
+
+  constexpr bool PulseEquals(const rmt_data_t& a, const rmt_data_t& b) {
+    return a.duration0 == b.duration0 && a.level0 == b.level0 && a.duration1 == b.duration1 && a.level1 == b.level1;
+  }
 
-    pulses.reserve(pulses.size() + N);
-    for (std::int64_t bit_pos = N - 1; bit_pos >= 0; --bit_pos) {
-      pulses.push_back((data >> bit_pos) & 1 ? rmtOne : rmtZero);
+  /// @brief Inverse of EncodeBits, reads N bits starting at the given pulse
+  /// @return False if the frame is too short, or a pulse is neither the one nor the zero symbol
+  template<std::size_t N, typename T, std::size_t M>
+  constexpr bool DecodeBits(const PulseFrame<M>& frame, std::size_t offset, T& out, const rmt_data_t& rmtOne, const rmt_data_t& rmtZero) {
+    static_assert(std::is_unsigned<T>::value, "T must be an unsigned integer");
+    static_assert(N > 0, "N must be greater than 0");
+    static_assert(N < std::numeric_limits<T>::digits, "N must be less or equal to the number of bits in T");
+
+    if (offset + N > frame.size()) {
+      return false;
     }
+
+    out = 0;
+    for (std::size_t i = 0; i < N; ++i) {
+      const rmt_data_t& pulse = frame.pulses[offset + i];
+
+      if (PulseEquals(pulse, rmtOne)) {
+        out = (out << 1) | 1;
+      } else if (PulseEquals(pulse, rmtZero)) {
+        out = out << 1;
+      } else {
+        return false;
+      }
+    }
+
+    return true;
   }
-}
+}  // namespace OpenShock::Rmt::Internal
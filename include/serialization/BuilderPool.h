@@ -0,0 +1,45 @@
+#pragma once
+
+#include <flatbuffers/flatbuffers.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace OpenShock::Serialization::BuilderPool {
+  constexpr std::size_t POOL_SIZE                 = 3;     // Gateway, captive portal and WiFi events may serialize at the same time
+  constexpr std::size_t BUILDER_INITIAL_SIZE      = 512;   // Covers everything but scan results and the ready message
+  constexpr std::size_t BUILDER_MAX_RETAINED_SIZE = 4096;  // Builders that grew past this give their memory back after use
+
+  struct MessageStats {
+    const char* name;
+    std::uint32_t uses;
+    std::uint32_t highWaterMark;  // Largest finished message in bytes
+  };
+
+  struct PoolStats {
+    std::uint32_t leases;
+    std::uint32_t fallbacks;  // Leases served by a temporary builder because all pooled ones were in use
+  };
+
+  /// @brief Borrows a builder from the pool for the lifetime of this object, falling back to a heap builder if the pool is exhausted
+  ///
+  /// The builder is cleared and returned to the pool on destruction, so its memory is reused by the next message instead of being freed.
+  class Lease {
+  public:
+    /// @param messageName Static string identifying the message type, used as the key for size tracking
+    Lease(const char* messageName);
+    ~Lease();
+    Lease(const Lease&)            = delete;
+    void operator=(const Lease&) = delete;
+
+    flatbuffers::FlatBufferBuilder& operator*() { return *m_builder; }
+    flatbuffers::FlatBufferBuilder* operator->() { return m_builder; }
+
+  private:
+    const char* m_messageName;
+    int m_poolIndex;  // -1 if the builder is not pooled
+    flatbuffers::FlatBufferBuilder* m_builder;
+  };
+
+  void GetStats(PoolStats& poolStats, std::vector<MessageStats>& messageStats);
+}  // namespace OpenShock::Serialization::BuilderPool
@@ -7,6 +7,9 @@
 
 #include <esp_wifi_types.h>
 
+#include <cstdint>
+#include <vector>
+
 namespace OpenShock {
   class WiFiNetwork;
 }
@@ -17,4 +20,5 @@ namespace OpenShock::Serialization::Local {
   bool SerializeWiFiScanStatusChangedEvent(OpenShock::WiFiScanStatus status, Common::SerializationCallbackFn callback);
   bool SerializeWiFiNetworkEvent(Types::WifiNetworkEventType eventType, const WiFiNetwork& network, Common::SerializationCallbackFn callback);
   bool SerializeWiFiNetworksEvent(Types::WifiNetworkEventType eventType, const std::vector<WiFiNetwork>& networks, Common::SerializationCallbackFn callback);
+  bool SerializeWiFiNetworkDeltaEvent(std::uint32_t generation, const std::vector<const WiFiNetwork*>& updated, const std::vector<const WiFiNetwork*>& lost, Common::SerializationCallbackFn callback);
 }  // namespace OpenShock::Serialization::Local
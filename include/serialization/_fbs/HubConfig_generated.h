@@ -17,6 +17,9 @@ namespace OpenShock {
 namespace Serialization {
 namespace Configuration {
 
+struct RFTransmitterConfig;
+struct RFTransmitterConfigBuilder;
+
 struct RFConfig;
 struct RFConfigBuilder;
 
@@ -116,6 +119,93 @@ inline const char *EnumNameOtaUpdateStep(OtaUpdateStep e) {
   return EnumNamesOtaUpdateStep()[index];
 }
 
+struct RFTransmitterConfig FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef RFTransmitterConfigBuilder Builder;
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Configuration.RFTransmitterConfig";
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_TX_PIN = 4,
+    VT_CORE_ID = 6,
+    VT_SHOCKER_IDS = 8
+  };
+  /// The GPIO pin connected to this transmitter's RF modulator data pin
+  uint8_t tx_pin() const {
+    return GetField<uint8_t>(VT_TX_PIN, 0);
+  }
+  /// The core the transmit task is pinned to, -1 lets the scheduler pick either core
+  int8_t core_id() const {
+    return GetField<int8_t>(VT_CORE_ID, -1);
+  }
+  /// IDs of the shockers that are sent through this transmitter instead of the main one
+  const ::flatbuffers::Vector<uint16_t> *shocker_ids() const {
+    return GetPointer<const ::flatbuffers::Vector<uint16_t> *>(VT_SHOCKER_IDS);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint8_t>(verifier, VT_TX_PIN, 1) &&
+           VerifyField<int8_t>(verifier, VT_CORE_ID, 1) &&
+           VerifyOffset(verifier, VT_SHOCKER_IDS) &&
+           verifier.VerifyVector(shocker_ids()) &&
+           verifier.EndTable();
+  }
+};
+
+struct RFTransmitterConfigBuilder {
+  typedef RFTransmitterConfig Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_tx_pin(uint8_t tx_pin) {
+    fbb_.AddElement<uint8_t>(RFTransmitterConfig::VT_TX_PIN, tx_pin, 0);
+  }
+  void add_core_id(int8_t core_id) {
+    fbb_.AddElement<int8_t>(RFTransmitterConfig::VT_CORE_ID, core_id, -1);
+  }
+  void add_shocker_ids(::flatbuffers::Offset<::flatbuffers::Vector<uint16_t>> shocker_ids) {
+    fbb_.AddOffset(RFTransmitterConfig::VT_SHOCKER_IDS, shocker_ids);
+  }
+  explicit RFTransmitterConfigBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<RFTransmitterConfig> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<RFTransmitterConfig>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<RFTransmitterConfig> CreateRFTransmitterConfig(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    uint8_t tx_pin = 0,
+    int8_t core_id = -1,
+    ::flatbuffers::Offset<::flatbuffers::Vector<uint16_t>> shocker_ids = 0) {
+  RFTransmitterConfigBuilder builder_(_fbb);
+  builder_.add_shocker_ids(shocker_ids);
+  builder_.add_core_id(core_id);
+  builder_.add_tx_pin(tx_pin);
+  return builder_.Finish();
+}
+
+struct RFTransmitterConfig::Traits {
+  using type = RFTransmitterConfig;
+  static auto constexpr Create = CreateRFTransmitterConfig;
+};
+
+inline ::flatbuffers::Offset<RFTransmitterConfig> CreateRFTransmitterConfigDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    uint8_t tx_pin = 0,
+    int8_t core_id = -1,
+    const std::vector<uint16_t> *shocker_ids = nullptr) {
+  auto shocker_ids__ = shocker_ids ? _fbb.CreateVector<uint16_t>(*shocker_ids) : 0;
+  return OpenShock::Serialization::Configuration::CreateRFTransmitterConfig(
+      _fbb,
+      tx_pin,
+      core_id,
+      shocker_ids__);
+}
+
 struct RFConfig FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef RFConfigBuilder Builder;
   struct Traits;
@@ -124,7 +214,8 @@ struct RFConfig FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   }
   enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
     VT_TX_PIN = 4,
-    VT_KEEPALIVE_ENABLED = 6
+    VT_KEEPALIVE_ENABLED = 6,
+    VT_TRANSMITTERS = 8
   };
   /// The GPIO pin connected to the RF modulator's data pin for transmitting (TX)
   uint8_t tx_pin() const {
@@ -134,10 +225,17 @@ struct RFConfig FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   bool keepalive_enabled() const {
     return GetField<uint8_t>(VT_KEEPALIVE_ENABLED, 0) != 0;
   }
+  /// Additional transmitters, each driving its own RF modulator
+  const ::flatbuffers::Vector<::flatbuffers::Offset<OpenShock::Serialization::Configuration::RFTransmitterConfig>> *transmitters() const {
+    return GetPointer<const ::flatbuffers::Vector<::flatbuffers::Offset<OpenShock::Serialization::Configuration::RFTransmitterConfig>> *>(VT_TRANSMITTERS);
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint8_t>(verifier, VT_TX_PIN, 1) &&
            VerifyField<uint8_t>(verifier, VT_KEEPALIVE_ENABLED, 1) &&
+           VerifyOffset(verifier, VT_TRANSMITTERS) &&
+           verifier.VerifyVector(transmitters()) &&
+           verifier.VerifyVectorOfTables(transmitters()) &&
            verifier.EndTable();
   }
 };
@@ -152,6 +250,9 @@ struct RFConfigBuilder {
   void add_keepalive_enabled(bool keepalive_enabled) {
     fbb_.AddElement<uint8_t>(RFConfig::VT_KEEPALIVE_ENABLED, static_cast<uint8_t>(keepalive_enabled), 0);
   }
+  void add_transmitters(::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<OpenShock::Serialization::Configuration::RFTransmitterConfig>>> transmitters) {
+    fbb_.AddOffset(RFConfig::VT_TRANSMITTERS, transmitters);
+  }
   explicit RFConfigBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
         : fbb_(_fbb) {
     start_ = fbb_.StartTable();
@@ -166,8 +267,10 @@ struct RFConfigBuilder {
 inline ::flatbuffers::Offset<RFConfig> CreateRFConfig(
     ::flatbuffers::FlatBufferBuilder &_fbb,
     uint8_t tx_pin = 0,
-    bool keepalive_enabled = false) {
+    bool keepalive_enabled = false,
+    ::flatbuffers::Offset<::flatbuffers::Vector<::flatbuffers::Offset<OpenShock::Serialization::Configuration::RFTransmitterConfig>>> transmitters = 0) {
   RFConfigBuilder builder_(_fbb);
+  builder_.add_transmitters(transmitters);
   builder_.add_keepalive_enabled(keepalive_enabled);
   builder_.add_tx_pin(tx_pin);
   return builder_.Finish();
@@ -178,6 +281,19 @@ struct RFConfig::Traits {
   static auto constexpr Create = CreateRFConfig;
 };
 
+inline ::flatbuffers::Offset<RFConfig> CreateRFConfigDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    uint8_t tx_pin = 0,
+    bool keepalive_enabled = false,
+    const std::vector<::flatbuffers::Offset<OpenShock::Serialization::Configuration::RFTransmitterConfig>> *transmitters = nullptr) {
+  auto transmitters__ = transmitters ? _fbb.CreateVector<::flatbuffers::Offset<OpenShock::Serialization::Configuration::RFTransmitterConfig>>(*transmitters) : 0;
+  return OpenShock::Serialization::Configuration::CreateRFConfig(
+      _fbb,
+      tx_pin,
+      keepalive_enabled,
+      transmitters__);
+}
+
 struct WiFiCredentials FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef WiFiCredentialsBuilder Builder;
   struct Traits;
@@ -43,6 +43,19 @@ struct AccountLinkCommandResult;
 
 struct SetRfTxPinCommandResult;
 
+struct LatencyStageStats;
+
+struct LatencyReport;
+struct LatencyReportBuilder;
+
+struct ShockerCommandListResult;
+struct ShockerCommandListResultBuilder;
+
+struct WifiNetworkDelta;
+
+struct WifiNetworkDeltaEvent;
+struct WifiNetworkDeltaEventBuilder;
+
 struct HubToLocalMessage;
 struct HubToLocalMessageBuilder;
 
@@ -121,6 +134,39 @@ inline const char *EnumNameSetRfPinResultCode(SetRfPinResultCode e) {
   return EnumNamesSetRfPinResultCode()[index];
 }
 
+enum class ShockerCommandResultCode : uint8_t {
+  Success = 0,
+  InvalidCommand = 1,
+  Rejected = 2,
+  MIN = Success,
+  MAX = Rejected
+};
+
+inline const ShockerCommandResultCode (&EnumValuesShockerCommandResultCode())[3] {
+  static const ShockerCommandResultCode values[] = {
+    ShockerCommandResultCode::Success,
+    ShockerCommandResultCode::InvalidCommand,
+    ShockerCommandResultCode::Rejected
+  };
+  return values;
+}
+
+inline const char * const *EnumNamesShockerCommandResultCode() {
+  static const char * const names[4] = {
+    "Success",
+    "InvalidCommand",
+    "Rejected",
+    nullptr
+  };
+  return names;
+}
+
+inline const char *EnumNameShockerCommandResultCode(ShockerCommandResultCode e) {
+  if (::flatbuffers::IsOutRange(e, ShockerCommandResultCode::Success, ShockerCommandResultCode::Rejected)) return "";
+  const size_t index = static_cast<size_t>(e);
+  return EnumNamesShockerCommandResultCode()[index];
+}
+
 enum class HubToLocalMessagePayload : uint8_t {
   NONE = 0,
   ReadyMessage = 1,
@@ -131,11 +177,14 @@ enum class HubToLocalMessagePayload : uint8_t {
   WifiLostIpEvent = 6,
   AccountLinkCommandResult = 7,
   SetRfTxPinCommandResult = 8,
+  LatencyReport = 9,
+  ShockerCommandListResult = 10,
+  WifiNetworkDeltaEvent = 11,
   MIN = NONE,
-  MAX = SetRfTxPinCommandResult
+  MAX = WifiNetworkDeltaEvent
 };
 
-inline const HubToLocalMessagePayload (&EnumValuesHubToLocalMessagePayload())[9] {
+inline const HubToLocalMessagePayload (&EnumValuesHubToLocalMessagePayload())[12] {
   static const HubToLocalMessagePayload values[] = {
     HubToLocalMessagePayload::NONE,
     HubToLocalMessagePayload::ReadyMessage,
@@ -145,13 +194,16 @@ inline const HubToLocalMessagePayload (&EnumValuesHubToLocalMessagePayload())[9]
     HubToLocalMessagePayload::WifiGotIpEvent,
     HubToLocalMessagePayload::WifiLostIpEvent,
     HubToLocalMessagePayload::AccountLinkCommandResult,
-    HubToLocalMessagePayload::SetRfTxPinCommandResult
+    HubToLocalMessagePayload::SetRfTxPinCommandResult,
+    HubToLocalMessagePayload::LatencyReport,
+    HubToLocalMessagePayload::ShockerCommandListResult,
+    HubToLocalMessagePayload::WifiNetworkDeltaEvent
   };
   return values;
 }
 
 inline const char * const *EnumNamesHubToLocalMessagePayload() {
-  static const char * const names[10] = {
+  static const char * const names[13] = {
     "NONE",
     "ReadyMessage",
     "ErrorMessage",
@@ -161,13 +213,16 @@ inline const char * const *EnumNamesHubToLocalMessagePayload() {
     "WifiLostIpEvent",
     "AccountLinkCommandResult",
     "SetRfTxPinCommandResult",
+    "LatencyReport",
+    "ShockerCommandListResult",
+    "WifiNetworkDeltaEvent",
     nullptr
   };
   return names;
 }
 
 inline const char *EnumNameHubToLocalMessagePayload(HubToLocalMessagePayload e) {
-  if (::flatbuffers::IsOutRange(e, HubToLocalMessagePayload::NONE, HubToLocalMessagePayload::SetRfTxPinCommandResult)) return "";
+  if (::flatbuffers::IsOutRange(e, HubToLocalMessagePayload::NONE, HubToLocalMessagePayload::WifiNetworkDeltaEvent)) return "";
   const size_t index = static_cast<size_t>(e);
   return EnumNamesHubToLocalMessagePayload()[index];
 }
@@ -208,6 +263,18 @@ template<> struct HubToLocalMessagePayloadTraits<OpenShock::Serialization::Local
   static const HubToLocalMessagePayload enum_value = HubToLocalMessagePayload::SetRfTxPinCommandResult;
 };
 
+template<> struct HubToLocalMessagePayloadTraits<OpenShock::Serialization::Local::LatencyReport> {
+  static const HubToLocalMessagePayload enum_value = HubToLocalMessagePayload::LatencyReport;
+};
+
+template<> struct HubToLocalMessagePayloadTraits<OpenShock::Serialization::Local::ShockerCommandListResult> {
+  static const HubToLocalMessagePayload enum_value = HubToLocalMessagePayload::ShockerCommandListResult;
+};
+
+template<> struct HubToLocalMessagePayloadTraits<OpenShock::Serialization::Local::WifiNetworkDeltaEvent> {
+  static const HubToLocalMessagePayload enum_value = HubToLocalMessagePayload::WifiNetworkDeltaEvent;
+};
+
 bool VerifyHubToLocalMessagePayload(::flatbuffers::Verifier &verifier, const void *obj, HubToLocalMessagePayload type);
 bool VerifyHubToLocalMessagePayloadVector(::flatbuffers::Verifier &verifier, const ::flatbuffers::Vector<::flatbuffers::Offset<void>> *values, const ::flatbuffers::Vector<HubToLocalMessagePayload> *types);
 
@@ -292,6 +359,106 @@ struct SetRfTxPinCommandResult::Traits {
   using type = SetRfTxPinCommandResult;
 };
 
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(4) LatencyStageStats FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint8_t stage_;
+  int8_t padding0__;  int16_t padding1__;
+  uint32_t count_;
+  uint32_t p50_us_;
+  uint32_t p95_us_;
+  uint32_t p99_us_;
+
+ public:
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Local.LatencyStageStats";
+  }
+  LatencyStageStats()
+      : stage_(0),
+        padding0__(0),
+        padding1__(0),
+        count_(0),
+        p50_us_(0),
+        p95_us_(0),
+        p99_us_(0) {
+    (void)padding0__;
+    (void)padding1__;
+  }
+  LatencyStageStats(uint8_t _stage, uint32_t _count, uint32_t _p50_us, uint32_t _p95_us, uint32_t _p99_us)
+      : stage_(::flatbuffers::EndianScalar(_stage)),
+        padding0__(0),
+        padding1__(0),
+        count_(::flatbuffers::EndianScalar(_count)),
+        p50_us_(::flatbuffers::EndianScalar(_p50_us)),
+        p95_us_(::flatbuffers::EndianScalar(_p95_us)),
+        p99_us_(::flatbuffers::EndianScalar(_p99_us)) {
+    (void)padding0__;
+    (void)padding1__;
+  }
+  uint8_t stage() const {
+    return ::flatbuffers::EndianScalar(stage_);
+  }
+  uint32_t count() const {
+    return ::flatbuffers::EndianScalar(count_);
+  }
+  uint32_t p50_us() const {
+    return ::flatbuffers::EndianScalar(p50_us_);
+  }
+  uint32_t p95_us() const {
+    return ::flatbuffers::EndianScalar(p95_us_);
+  }
+  uint32_t p99_us() const {
+    return ::flatbuffers::EndianScalar(p99_us_);
+  }
+};
+FLATBUFFERS_STRUCT_END(LatencyStageStats, 20);
+
+struct LatencyStageStats::Traits {
+  using type = LatencyStageStats;
+};
+
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(1) WifiNetworkDelta FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint8_t bssid_[6];
+  uint8_t channel_;
+  int8_t rssi_;
+
+ public:
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Local.WifiNetworkDelta";
+  }
+  WifiNetworkDelta()
+      : bssid_(),
+        channel_(0),
+        rssi_(0) {
+  }
+  WifiNetworkDelta(uint8_t _channel, int8_t _rssi)
+      : bssid_(),
+        channel_(::flatbuffers::EndianScalar(_channel)),
+        rssi_(::flatbuffers::EndianScalar(_rssi)) {
+  }
+  WifiNetworkDelta(::flatbuffers::span<const uint8_t, 6> _bssid, uint8_t _channel, int8_t _rssi)
+      : channel_(::flatbuffers::EndianScalar(_channel)),
+        rssi_(::flatbuffers::EndianScalar(_rssi)) {
+    ::flatbuffers::CastToArray(bssid_).CopyFromSpan(_bssid);
+  }
+  const ::flatbuffers::Array<uint8_t, 6> *bssid() const {
+    return &::flatbuffers::CastToArray(bssid_);
+  }
+  uint8_t channel() const {
+    return ::flatbuffers::EndianScalar(channel_);
+  }
+  int8_t rssi() const {
+    return ::flatbuffers::EndianScalar(rssi_);
+  }
+};
+FLATBUFFERS_STRUCT_END(WifiNetworkDelta, 8);
+
+struct WifiNetworkDelta::Traits {
+  using type = WifiNetworkDelta;
+};
+
 struct ReadyMessage FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef ReadyMessageBuilder Builder;
   struct Traits;
@@ -627,6 +794,212 @@ inline ::flatbuffers::Offset<WifiLostIpEvent> CreateWifiLostIpEventDirect(
       ip__);
 }
 
+struct LatencyReport FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef LatencyReportBuilder Builder;
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Local.LatencyReport";
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_STAGES = 4
+  };
+  const ::flatbuffers::Vector<const OpenShock::Serialization::Local::LatencyStageStats *> *stages() const {
+    return GetPointer<const ::flatbuffers::Vector<const OpenShock::Serialization::Local::LatencyStageStats *> *>(VT_STAGES);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_STAGES) &&
+           verifier.VerifyVector(stages()) &&
+           verifier.EndTable();
+  }
+};
+
+struct LatencyReportBuilder {
+  typedef LatencyReport Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_stages(::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Local::LatencyStageStats *>> stages) {
+    fbb_.AddOffset(LatencyReport::VT_STAGES, stages);
+  }
+  explicit LatencyReportBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<LatencyReport> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<LatencyReport>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<LatencyReport> CreateLatencyReport(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    ::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Local::LatencyStageStats *>> stages = 0) {
+  LatencyReportBuilder builder_(_fbb);
+  builder_.add_stages(stages);
+  return builder_.Finish();
+}
+
+struct LatencyReport::Traits {
+  using type = LatencyReport;
+  static auto constexpr Create = CreateLatencyReport;
+};
+
+inline ::flatbuffers::Offset<LatencyReport> CreateLatencyReportDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<OpenShock::Serialization::Local::LatencyStageStats> *stages = nullptr) {
+  auto stages__ = stages ? _fbb.CreateVectorOfStructs<OpenShock::Serialization::Local::LatencyStageStats>(*stages) : 0;
+  return OpenShock::Serialization::Local::CreateLatencyReport(
+      _fbb,
+      stages__);
+}
+
+struct ShockerCommandListResult FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef ShockerCommandListResultBuilder Builder;
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Local.ShockerCommandListResult";
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_RESULTS = 4
+  };
+  const ::flatbuffers::Vector<OpenShock::Serialization::Local::ShockerCommandResultCode> *results() const {
+    return GetPointer<const ::flatbuffers::Vector<OpenShock::Serialization::Local::ShockerCommandResultCode> *>(VT_RESULTS);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffset(verifier, VT_RESULTS) &&
+           verifier.VerifyVector(results()) &&
+           verifier.EndTable();
+  }
+};
+
+struct ShockerCommandListResultBuilder {
+  typedef ShockerCommandListResult Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_results(::flatbuffers::Offset<::flatbuffers::Vector<OpenShock::Serialization::Local::ShockerCommandResultCode>> results) {
+    fbb_.AddOffset(ShockerCommandListResult::VT_RESULTS, results);
+  }
+  explicit ShockerCommandListResultBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<ShockerCommandListResult> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<ShockerCommandListResult>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<ShockerCommandListResult> CreateShockerCommandListResult(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    ::flatbuffers::Offset<::flatbuffers::Vector<OpenShock::Serialization::Local::ShockerCommandResultCode>> results = 0) {
+  ShockerCommandListResultBuilder builder_(_fbb);
+  builder_.add_results(results);
+  return builder_.Finish();
+}
+
+struct ShockerCommandListResult::Traits {
+  using type = ShockerCommandListResult;
+  static auto constexpr Create = CreateShockerCommandListResult;
+};
+
+inline ::flatbuffers::Offset<ShockerCommandListResult> CreateShockerCommandListResultDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<OpenShock::Serialization::Local::ShockerCommandResultCode> *results = nullptr) {
+  auto results__ = results ? _fbb.CreateVector<OpenShock::Serialization::Local::ShockerCommandResultCode>(*results) : 0;
+  return OpenShock::Serialization::Local::CreateShockerCommandListResult(
+      _fbb,
+      results__);
+}
+
+struct WifiNetworkDeltaEvent FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef WifiNetworkDeltaEventBuilder Builder;
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Local.WifiNetworkDeltaEvent";
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_GENERATION = 4,
+    VT_UPDATED = 6,
+    VT_LOST = 8
+  };
+  uint32_t generation() const {
+    return GetField<uint32_t>(VT_GENERATION, 0);
+  }
+  const ::flatbuffers::Vector<const OpenShock::Serialization::Local::WifiNetworkDelta *> *updated() const {
+    return GetPointer<const ::flatbuffers::Vector<const OpenShock::Serialization::Local::WifiNetworkDelta *> *>(VT_UPDATED);
+  }
+  const ::flatbuffers::Vector<const OpenShock::Serialization::Local::WifiNetworkDelta *> *lost() const {
+    return GetPointer<const ::flatbuffers::Vector<const OpenShock::Serialization::Local::WifiNetworkDelta *> *>(VT_LOST);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyField<uint32_t>(verifier, VT_GENERATION, 4) &&
+           VerifyOffset(verifier, VT_UPDATED) &&
+           verifier.VerifyVector(updated()) &&
+           VerifyOffset(verifier, VT_LOST) &&
+           verifier.VerifyVector(lost()) &&
+           verifier.EndTable();
+  }
+};
+
+struct WifiNetworkDeltaEventBuilder {
+  typedef WifiNetworkDeltaEvent Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_generation(uint32_t generation) {
+    fbb_.AddElement<uint32_t>(WifiNetworkDeltaEvent::VT_GENERATION, generation, 0);
+  }
+  void add_updated(::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Local::WifiNetworkDelta *>> updated) {
+    fbb_.AddOffset(WifiNetworkDeltaEvent::VT_UPDATED, updated);
+  }
+  void add_lost(::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Local::WifiNetworkDelta *>> lost) {
+    fbb_.AddOffset(WifiNetworkDeltaEvent::VT_LOST, lost);
+  }
+  explicit WifiNetworkDeltaEventBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<WifiNetworkDeltaEvent> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<WifiNetworkDeltaEvent>(end);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<WifiNetworkDeltaEvent> CreateWifiNetworkDeltaEvent(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t generation = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Local::WifiNetworkDelta *>> updated = 0,
+    ::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Local::WifiNetworkDelta *>> lost = 0) {
+  WifiNetworkDeltaEventBuilder builder_(_fbb);
+  builder_.add_lost(lost);
+  builder_.add_updated(updated);
+  builder_.add_generation(generation);
+  return builder_.Finish();
+}
+
+struct WifiNetworkDeltaEvent::Traits {
+  using type = WifiNetworkDeltaEvent;
+  static auto constexpr Create = CreateWifiNetworkDeltaEvent;
+};
+
+inline ::flatbuffers::Offset<WifiNetworkDeltaEvent> CreateWifiNetworkDeltaEventDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    uint32_t generation = 0,
+    const std::vector<OpenShock::Serialization::Local::WifiNetworkDelta> *updated = nullptr,
+    const std::vector<OpenShock::Serialization::Local::WifiNetworkDelta> *lost = nullptr) {
+  auto updated__ = updated ? _fbb.CreateVectorOfStructs<OpenShock::Serialization::Local::WifiNetworkDelta>(*updated) : 0;
+  auto lost__ = lost ? _fbb.CreateVectorOfStructs<OpenShock::Serialization::Local::WifiNetworkDelta>(*lost) : 0;
+  return OpenShock::Serialization::Local::CreateWifiNetworkDeltaEvent(
+      _fbb,
+      generation,
+      updated__,
+      lost__);
+}
+
 struct HubToLocalMessage FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef HubToLocalMessageBuilder Builder;
   struct Traits;
@@ -668,6 +1041,15 @@ struct HubToLocalMessage FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table
   const OpenShock::Serialization::Local::SetRfTxPinCommandResult *payload_as_SetRfTxPinCommandResult() const {
     return payload_type() == OpenShock::Serialization::Local::HubToLocalMessagePayload::SetRfTxPinCommandResult ? static_cast<const OpenShock::Serialization::Local::SetRfTxPinCommandResult *>(payload()) : nullptr;
   }
+  const OpenShock::Serialization::Local::LatencyReport *payload_as_LatencyReport() const {
+    return payload_type() == OpenShock::Serialization::Local::HubToLocalMessagePayload::LatencyReport ? static_cast<const OpenShock::Serialization::Local::LatencyReport *>(payload()) : nullptr;
+  }
+  const OpenShock::Serialization::Local::ShockerCommandListResult *payload_as_ShockerCommandListResult() const {
+    return payload_type() == OpenShock::Serialization::Local::HubToLocalMessagePayload::ShockerCommandListResult ? static_cast<const OpenShock::Serialization::Local::ShockerCommandListResult *>(payload()) : nullptr;
+  }
+  const OpenShock::Serialization::Local::WifiNetworkDeltaEvent *payload_as_WifiNetworkDeltaEvent() const {
+    return payload_type() == OpenShock::Serialization::Local::HubToLocalMessagePayload::WifiNetworkDeltaEvent ? static_cast<const OpenShock::Serialization::Local::WifiNetworkDeltaEvent *>(payload()) : nullptr;
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint8_t>(verifier, VT_PAYLOAD_TYPE, 1) &&
@@ -709,6 +1091,18 @@ template<> inline const OpenShock::Serialization::Local::SetRfTxPinCommandResult
   return payload_as_SetRfTxPinCommandResult();
 }
 
+template<> inline const OpenShock::Serialization::Local::LatencyReport *HubToLocalMessage::payload_as<OpenShock::Serialization::Local::LatencyReport>() const {
+  return payload_as_LatencyReport();
+}
+
+template<> inline const OpenShock::Serialization::Local::ShockerCommandListResult *HubToLocalMessage::payload_as<OpenShock::Serialization::Local::ShockerCommandListResult>() const {
+  return payload_as_ShockerCommandListResult();
+}
+
+template<> inline const OpenShock::Serialization::Local::WifiNetworkDeltaEvent *HubToLocalMessage::payload_as<OpenShock::Serialization::Local::WifiNetworkDeltaEvent>() const {
+  return payload_as_WifiNetworkDeltaEvent();
+}
+
 struct HubToLocalMessageBuilder {
   typedef HubToLocalMessage Table;
   ::flatbuffers::FlatBufferBuilder &fbb_;
@@ -779,6 +1173,18 @@ inline bool VerifyHubToLocalMessagePayload(::flatbuffers::Verifier &verifier, co
     case HubToLocalMessagePayload::SetRfTxPinCommandResult: {
       return verifier.VerifyField<OpenShock::Serialization::Local::SetRfTxPinCommandResult>(static_cast<const uint8_t *>(obj), 0, 1);
     }
+    case HubToLocalMessagePayload::LatencyReport: {
+      auto ptr = reinterpret_cast<const OpenShock::Serialization::Local::LatencyReport *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case HubToLocalMessagePayload::ShockerCommandListResult: {
+      auto ptr = reinterpret_cast<const OpenShock::Serialization::Local::ShockerCommandListResult *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
+    case HubToLocalMessagePayload::WifiNetworkDeltaEvent: {
+      auto ptr = reinterpret_cast<const OpenShock::Serialization::Local::WifiNetworkDeltaEvent *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
     default: return true;
   }
 }
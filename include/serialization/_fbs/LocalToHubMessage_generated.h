@@ -13,6 +13,9 @@ static_assert(FLATBUFFERS_VERSION_MAJOR == 24 &&
               FLATBUFFERS_VERSION_REVISION == 25,
              "Non-compatible flatbuffers version included");
 
+#include "ShockerCommandType_generated.h"
+#include "ShockerModelType_generated.h"
+
 namespace OpenShock {
 namespace Serialization {
 namespace Local {
@@ -59,6 +62,13 @@ struct AccountUnlinkCommand;
 
 struct SetRfTxPinCommand;
 
+struct LatencyReportCommand;
+
+struct ShockerCommand;
+
+struct ShockerCommandList;
+struct ShockerCommandListBuilder;
+
 struct LocalToHubMessage;
 struct LocalToHubMessageBuilder;
 
@@ -81,11 +91,13 @@ enum class LocalToHubMessagePayload : uint8_t {
   AccountLinkCommand = 15,
   AccountUnlinkCommand = 16,
   SetRfTxPinCommand = 17,
+  LatencyReportCommand = 18,
+  ShockerCommandList = 19,
   MIN = NONE,
-  MAX = SetRfTxPinCommand
+  MAX = ShockerCommandList
 };
 
-inline const LocalToHubMessagePayload (&EnumValuesLocalToHubMessagePayload())[18] {
+inline const LocalToHubMessagePayload (&EnumValuesLocalToHubMessagePayload())[20] {
   static const LocalToHubMessagePayload values[] = {
     LocalToHubMessagePayload::NONE,
     LocalToHubMessagePayload::WifiScanCommand,
@@ -104,13 +116,15 @@ inline const LocalToHubMessagePayload (&EnumValuesLocalToHubMessagePayload())[18
     LocalToHubMessagePayload::OtaUpdateStartUpdateCommand,
     LocalToHubMessagePayload::AccountLinkCommand,
     LocalToHubMessagePayload::AccountUnlinkCommand,
-    LocalToHubMessagePayload::SetRfTxPinCommand
+    LocalToHubMessagePayload::SetRfTxPinCommand,
+    LocalToHubMessagePayload::LatencyReportCommand,
+    LocalToHubMessagePayload::ShockerCommandList
   };
   return values;
 }
 
 inline const char * const *EnumNamesLocalToHubMessagePayload() {
-  static const char * const names[19] = {
+  static const char * const names[21] = {
     "NONE",
     "WifiScanCommand",
     "WifiNetworkSaveCommand",
@@ -129,13 +143,15 @@ inline const char * const *EnumNamesLocalToHubMessagePayload() {
     "AccountLinkCommand",
     "AccountUnlinkCommand",
     "SetRfTxPinCommand",
+    "LatencyReportCommand",
+    "ShockerCommandList",
     nullptr
   };
   return names;
 }
 
 inline const char *EnumNameLocalToHubMessagePayload(LocalToHubMessagePayload e) {
-  if (::flatbuffers::IsOutRange(e, LocalToHubMessagePayload::NONE, LocalToHubMessagePayload::SetRfTxPinCommand)) return "";
+  if (::flatbuffers::IsOutRange(e, LocalToHubMessagePayload::NONE, LocalToHubMessagePayload::ShockerCommandList)) return "";
   const size_t index = static_cast<size_t>(e);
   return EnumNamesLocalToHubMessagePayload()[index];
 }
@@ -212,6 +228,14 @@ template<> struct LocalToHubMessagePayloadTraits<OpenShock::Serialization::Local
   static const LocalToHubMessagePayload enum_value = LocalToHubMessagePayload::SetRfTxPinCommand;
 };
 
+template<> struct LocalToHubMessagePayloadTraits<OpenShock::Serialization::Local::LatencyReportCommand> {
+  static const LocalToHubMessagePayload enum_value = LocalToHubMessagePayload::LatencyReportCommand;
+};
+
+template<> struct LocalToHubMessagePayloadTraits<OpenShock::Serialization::Local::ShockerCommandList> {
+  static const LocalToHubMessagePayload enum_value = LocalToHubMessagePayload::ShockerCommandList;
+};
+
 bool VerifyLocalToHubMessagePayload(::flatbuffers::Verifier &verifier, const void *obj, LocalToHubMessagePayload type);
 bool VerifyLocalToHubMessagePayloadVector(::flatbuffers::Verifier &verifier, const ::flatbuffers::Vector<::flatbuffers::Offset<void>> *values, const ::flatbuffers::Vector<LocalToHubMessagePayload> *types);
 
@@ -440,6 +464,85 @@ struct SetRfTxPinCommand::Traits {
   using type = SetRfTxPinCommand;
 };
 
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(1) LatencyReportCommand FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint8_t reset_;
+
+ public:
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Local.LatencyReportCommand";
+  }
+  LatencyReportCommand()
+      : reset_(0) {
+  }
+  LatencyReportCommand(bool _reset)
+      : reset_(::flatbuffers::EndianScalar(static_cast<uint8_t>(_reset))) {
+  }
+  bool reset() const {
+    return ::flatbuffers::EndianScalar(reset_) != 0;
+  }
+};
+FLATBUFFERS_STRUCT_END(LatencyReportCommand, 1);
+
+struct LatencyReportCommand::Traits {
+  using type = LatencyReportCommand;
+};
+
+FLATBUFFERS_MANUALLY_ALIGNED_STRUCT(2) ShockerCommand FLATBUFFERS_FINAL_CLASS {
+ private:
+  uint8_t model_;
+  int8_t padding0__;
+  uint16_t id_;
+  uint8_t type_;
+  uint8_t intensity_;
+  uint16_t duration_;
+
+ public:
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Local.ShockerCommand";
+  }
+  ShockerCommand()
+      : model_(0),
+        padding0__(0),
+        id_(0),
+        type_(0),
+        intensity_(0),
+        duration_(0) {
+    (void)padding0__;
+  }
+  ShockerCommand(OpenShock::Serialization::Types::ShockerModelType _model, uint16_t _id, OpenShock::Serialization::Types::ShockerCommandType _type, uint8_t _intensity, uint16_t _duration)
+      : model_(::flatbuffers::EndianScalar(static_cast<uint8_t>(_model))),
+        padding0__(0),
+        id_(::flatbuffers::EndianScalar(_id)),
+        type_(::flatbuffers::EndianScalar(static_cast<uint8_t>(_type))),
+        intensity_(::flatbuffers::EndianScalar(_intensity)),
+        duration_(::flatbuffers::EndianScalar(_duration)) {
+    (void)padding0__;
+  }
+  OpenShock::Serialization::Types::ShockerModelType model() const {
+    return static_cast<OpenShock::Serialization::Types::ShockerModelType>(::flatbuffers::EndianScalar(model_));
+  }
+  uint16_t id() const {
+    return ::flatbuffers::EndianScalar(id_);
+  }
+  OpenShock::Serialization::Types::ShockerCommandType type() const {
+    return static_cast<OpenShock::Serialization::Types::ShockerCommandType>(::flatbuffers::EndianScalar(type_));
+  }
+  uint8_t intensity() const {
+    return ::flatbuffers::EndianScalar(intensity_);
+  }
+  uint16_t duration() const {
+    return ::flatbuffers::EndianScalar(duration_);
+  }
+};
+FLATBUFFERS_STRUCT_END(ShockerCommand, 8);
+
+struct ShockerCommand::Traits {
+  using type = ShockerCommand;
+};
+
 struct WifiNetworkSaveCommand FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef WifiNetworkSaveCommandBuilder Builder;
   struct Traits;
@@ -960,6 +1063,67 @@ inline ::flatbuffers::Offset<AccountLinkCommand> CreateAccountLinkCommandDirect(
       code__);
 }
 
+struct ShockerCommandList FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
+  typedef ShockerCommandListBuilder Builder;
+  struct Traits;
+  static FLATBUFFERS_CONSTEXPR_CPP11 const char *GetFullyQualifiedName() {
+    return "OpenShock.Serialization.Local.ShockerCommandList";
+  }
+  enum FlatBuffersVTableOffset FLATBUFFERS_VTABLE_UNDERLYING_TYPE {
+    VT_COMMANDS = 4
+  };
+  const ::flatbuffers::Vector<const OpenShock::Serialization::Local::ShockerCommand *> *commands() const {
+    return GetPointer<const ::flatbuffers::Vector<const OpenShock::Serialization::Local::ShockerCommand *> *>(VT_COMMANDS);
+  }
+  bool Verify(::flatbuffers::Verifier &verifier) const {
+    return VerifyTableStart(verifier) &&
+           VerifyOffsetRequired(verifier, VT_COMMANDS) &&
+           verifier.VerifyVector(commands()) &&
+           verifier.EndTable();
+  }
+};
+
+struct ShockerCommandListBuilder {
+  typedef ShockerCommandList Table;
+  ::flatbuffers::FlatBufferBuilder &fbb_;
+  ::flatbuffers::uoffset_t start_;
+  void add_commands(::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Local::ShockerCommand *>> commands) {
+    fbb_.AddOffset(ShockerCommandList::VT_COMMANDS, commands);
+  }
+  explicit ShockerCommandListBuilder(::flatbuffers::FlatBufferBuilder &_fbb)
+        : fbb_(_fbb) {
+    start_ = fbb_.StartTable();
+  }
+  ::flatbuffers::Offset<ShockerCommandList> Finish() {
+    const auto end = fbb_.EndTable(start_);
+    auto o = ::flatbuffers::Offset<ShockerCommandList>(end);
+    fbb_.Required(o, ShockerCommandList::VT_COMMANDS);
+    return o;
+  }
+};
+
+inline ::flatbuffers::Offset<ShockerCommandList> CreateShockerCommandList(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    ::flatbuffers::Offset<::flatbuffers::Vector<const OpenShock::Serialization::Local::ShockerCommand *>> commands = 0) {
+  ShockerCommandListBuilder builder_(_fbb);
+  builder_.add_commands(commands);
+  return builder_.Finish();
+}
+
+struct ShockerCommandList::Traits {
+  using type = ShockerCommandList;
+  static auto constexpr Create = CreateShockerCommandList;
+};
+
+inline ::flatbuffers::Offset<ShockerCommandList> CreateShockerCommandListDirect(
+    ::flatbuffers::FlatBufferBuilder &_fbb,
+    const std::vector<OpenShock::Serialization::Local::ShockerCommand> *commands = nullptr) {
+  auto commands__ = commands ? _fbb.CreateVectorOfStructs<OpenShock::Serialization::Local::ShockerCommand>(*commands) : 0;
+  return OpenShock::Serialization::Local::CreateShockerCommandList(
+      _fbb,
+      commands__);
+}
+
 struct LocalToHubMessage FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table {
   typedef LocalToHubMessageBuilder Builder;
   struct Traits;
@@ -1028,6 +1192,12 @@ struct LocalToHubMessage FLATBUFFERS_FINAL_CLASS : private ::flatbuffers::Table
   const OpenShock::Serialization::Local::SetRfTxPinCommand *payload_as_SetRfTxPinCommand() const {
     return payload_type() == OpenShock::Serialization::Local::LocalToHubMessagePayload::SetRfTxPinCommand ? static_cast<const OpenShock::Serialization::Local::SetRfTxPinCommand *>(payload()) : nullptr;
   }
+  const OpenShock::Serialization::Local::LatencyReportCommand *payload_as_LatencyReportCommand() const {
+    return payload_type() == OpenShock::Serialization::Local::LocalToHubMessagePayload::LatencyReportCommand ? static_cast<const OpenShock::Serialization::Local::LatencyReportCommand *>(payload()) : nullptr;
+  }
+  const OpenShock::Serialization::Local::ShockerCommandList *payload_as_ShockerCommandList() const {
+    return payload_type() == OpenShock::Serialization::Local::LocalToHubMessagePayload::ShockerCommandList ? static_cast<const OpenShock::Serialization::Local::ShockerCommandList *>(payload()) : nullptr;
+  }
   bool Verify(::flatbuffers::Verifier &verifier) const {
     return VerifyTableStart(verifier) &&
            VerifyField<uint8_t>(verifier, VT_PAYLOAD_TYPE, 1) &&
@@ -1105,6 +1275,14 @@ template<> inline const OpenShock::Serialization::Local::SetRfTxPinCommand *Loca
   return payload_as_SetRfTxPinCommand();
 }
 
+template<> inline const OpenShock::Serialization::Local::LatencyReportCommand *LocalToHubMessage::payload_as<OpenShock::Serialization::Local::LatencyReportCommand>() const {
+  return payload_as_LatencyReportCommand();
+}
+
+template<> inline const OpenShock::Serialization::Local::ShockerCommandList *LocalToHubMessage::payload_as<OpenShock::Serialization::Local::ShockerCommandList>() const {
+  return payload_as_ShockerCommandList();
+}
+
 struct LocalToHubMessageBuilder {
   typedef LocalToHubMessage Table;
   ::flatbuffers::FlatBufferBuilder &fbb_;
@@ -1205,6 +1383,13 @@ inline bool VerifyLocalToHubMessagePayload(::flatbuffers::Verifier &verifier, co
     case LocalToHubMessagePayload::SetRfTxPinCommand: {
       return verifier.VerifyField<OpenShock::Serialization::Local::SetRfTxPinCommand>(static_cast<const uint8_t *>(obj), 0, 1);
     }
+    case LocalToHubMessagePayload::LatencyReportCommand: {
+      return verifier.VerifyField<OpenShock::Serialization::Local::LatencyReportCommand>(static_cast<const uint8_t *>(obj), 0, 1);
+    }
+    case LocalToHubMessagePayload::ShockerCommandList: {
+      auto ptr = reinterpret_cast<const OpenShock::Serialization::Local::ShockerCommandList *>(obj);
+      return verifier.VerifyTable(ptr);
+    }
     default: return true;
   }
 }
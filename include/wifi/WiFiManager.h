@@ -4,6 +4,7 @@
 #include "StringView.h"
 
 #include <cstdint>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -70,4 +71,11 @@ namespace OpenShock::WiFiManager {
   /// @brief Gets a copy of the vector of discovered WiFi networks
   /// @return Vector of discovered WiFiNetworks
   std::vector<WiFiNetwork> GetDiscoveredWiFiNetworks();
+
+  /// @brief Calls fn with the discovered networks while no change to them can be broadcast
+  ///
+  /// Anything fn queues is ordered after every broadcast the networks already reflect and before every later one.
+  /// The generation changes whenever the networks change in a way clients can see, equal values serialize the same.
+  /// @note fn must not call back into WiFiManager
+  void WithDiscoveredWiFiNetworks(const std::function<void(std::uint32_t generation, const std::vector<WiFiNetwork>& networks)>& fn);
 }  // namespace OpenShock::WiFiManager
@@ -24,5 +24,6 @@ namespace OpenShock {
     std::uint16_t connectAttempts;  // TODO: Add connectSuccesses as well, so we can track the success rate of a network
     std::int64_t lastConnectAttempt;
     std::uint8_t scansMissed;
+    std::int8_t reportedRssi;  // RSSI captive portal clients last got, small drifts from it are not broadcast
   };
 }  // namespace OpenShock
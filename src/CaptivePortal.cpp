@@ -173,3 +173,19 @@ bool CaptivePortal::BroadcastMessageBIN(const std::uint8_t* data, std::size_t le
 
   return true;
 }
+
+bool CaptivePortal::GetOutboundStats(LocalOutboundQueue::Stats& out) {
+  if (s_instance == nullptr) return false;
+
+  out = s_instance->outboundStats();
+
+  return true;
+}
+
+bool CaptivePortal::GetTaskWakeups(std::uint32_t& out) {
+  if (s_instance == nullptr) return false;
+
+  out = s_instance->taskWakeups();
+
+  return true;
+}
@@ -14,6 +14,13 @@
 
 #include <WiFi.h>
 
+#include <esp_vfs_eventfd.h>
+#include <sys/select.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+
 static const char* TAG = "CaptivePortalInstance";
 
 const std::uint16_t HTTP_PORT                 = 80;
@@ -22,10 +29,40 @@ const std::uint16_t DNS_PORT                  = 53;
 const std::uint32_t WEBSOCKET_PING_INTERVAL   = 10'000;
 const std::uint32_t WEBSOCKET_PING_TIMEOUT    = 1000;
 const std::uint8_t WEBSOCKET_PING_RETRIES     = 3;
-const std::uint32_t WEBSOCKET_UPDATE_INTERVAL = 10;  // 10ms / 100Hz
+const std::uint32_t WEBSOCKET_UPDATE_INTERVAL = 10;   // 10ms / 100Hz, polling fallback if producers can not wake the task
+const std::uint32_t WEBSOCKET_IDLE_INTERVAL   = 100;  // Longest sleep, the listening socket is not visible to select so new clients are accepted on this tick
+const std::size_t WEBSOCKET_SENDS_PER_CLIENT  = 4;    // Per update, bounds how long one client that reads slowly can hold up the loop
 
 using namespace OpenShock;
 
+// WebSocketsServer keeps its clients protected, this reaches their sockets without patching the library
+struct SocketServerAccess : public WebSocketsServer {
+  static auto& Clients(WebSocketsServer& server) { return server.*(&SocketServerAccess::_clients); }
+};
+
+int _createWakeFd() {
+  static bool s_eventFdRegistered = false;
+
+  if (!s_eventFdRegistered) {
+    esp_vfs_eventfd_config_t config = ESP_VFS_EVENTD_CONFIG_DEFAULT();
+
+    esp_err_t err = esp_vfs_eventfd_register(&config);
+    if (err != ESP_OK && err != ESP_ERR_INVALID_STATE) {  // Invalid state means someone else registered it already
+      ESP_LOGE(TAG, "Failed to register eventfd: %s", esp_err_to_name(err));
+      return -1;
+    }
+
+    s_eventFdRegistered = true;
+  }
+
+  int fd = eventfd(0, 0);
+  if (fd < 0) {
+    ESP_LOGE(TAG, "Failed to create eventfd");
+  }
+
+  return fd;
+}
+
 const esp_partition_t* _getStaticPartition() {
   const esp_partition_t* partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_DATA_SPIFFS, "static0");
   if (partition != nullptr) {
@@ -57,10 +94,21 @@ const char* _getPartitionHash() {
 CaptivePortalInstance::CaptivePortalInstance()
   : m_webServer(HTTP_PORT)
   , m_socketServer(WEBSOCKET_PORT, "/ws", "json")
-  , m_socketDeFragger(std::bind(&CaptivePortalInstance::handleWebSocketEvent, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4))
+  , m_socketDeFragger(std::bind(&CaptivePortalInstance::handleWebSocketEvent, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4), EventHandlers::WebSocket::LOCAL_MAX_MESSAGE_SIZE)
+  , m_outbound()
+  , m_networksSnapshot(nullptr)
+  , m_networksSnapshotGeneration(0)
   , m_fileSystem()
   , m_dnsServer()
-  , m_taskHandle(nullptr) {
+  , m_taskHandle(nullptr)
+  , m_stopWaiter(nullptr)
+  , m_running(true)
+  , m_taskWakeups(0)
+  , m_wakeFd(_createWakeFd()) {
+  if (m_wakeFd < 0) {
+    ESP_LOGW(TAG, "Falling back to polling every %ums", WEBSOCKET_UPDATE_INTERVAL);
+  }
+
   m_socketServer.onEvent(std::bind(&WebSocketDeFragger::handler, &m_socketDeFragger, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4));
   m_socketServer.begin();
   m_socketServer.enableHeartbeat(WEBSOCKET_PING_INTERVAL, WEBSOCKET_PING_TIMEOUT, WEBSOCKET_PING_RETRIES);
@@ -129,28 +177,122 @@ discord.gg/OpenShock
 
 CaptivePortalInstance::~CaptivePortalInstance() {
   if (m_taskHandle != nullptr) {
-    vTaskDelete(m_taskHandle);
+    // Let the task leave select on its own, deleting it while it waits inside lwIP would leave its wait state registered with the stack
+    m_stopWaiter = xTaskGetCurrentTaskHandle();
+    m_running.store(false, std::memory_order_release);
+    wakeIf(true);
+
+    if (ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(WEBSOCKET_IDLE_INTERVAL * 5)) == 0) {
+      ESP_LOGW(TAG, "Task did not stop in time, deleting it");
+      vTaskDelete(m_taskHandle);
+    }
+
     m_taskHandle = nullptr;
   }
   m_webServer.end();
   m_socketServer.close();
   m_fileSystem.end();
   m_dnsServer.stop();
+  if (m_wakeFd >= 0) {
+    close(m_wakeFd);
+    m_wakeFd = -1;
+  }
 }
 
 void CaptivePortalInstance::task(void* arg) {
   CaptivePortalInstance* instance = reinterpret_cast<CaptivePortalInstance*>(arg);
 
-  while (true) {
+  while (instance->m_running.load(std::memory_order_acquire)) {
     instance->m_socketServer.loop();
+    instance->m_outbound.Drain(WEBSOCKET_SENDS_PER_CLIENT, [instance](std::uint8_t socketId, bool binary, const std::uint8_t* data, std::size_t length) {
+      if (binary) {
+        return instance->m_socketServer.sendBIN(socketId, data, length);
+      }
+
+      return instance->m_socketServer.sendTXT(socketId, data, length);
+    });
     // instance->m_dnsServer.processNextRequest();
-    vTaskDelay(pdMS_TO_TICKS(WEBSOCKET_UPDATE_INTERVAL));
+    instance->waitForActivity();
   }
+
+  xTaskNotifyGive(instance->m_stopWaiter);
+  vTaskDelete(nullptr);
+}
+
+void CaptivePortalInstance::waitForActivity() {
+  // A drain that ran out of budget left work behind, go around again right away
+  if (m_outbound.HasPending()) {
+    return;
+  }
+
+  fd_set readFds;
+  FD_ZERO(&readFds);
+  int maxFd = -1;
+
+  if (m_wakeFd >= 0) {
+    FD_SET(m_wakeFd, &readFds);
+    maxFd = m_wakeFd;
+  }
+
+  for (WSclient_t& client : SocketServerAccess::Clients(m_socketServer)) {
+    if (client.status == WSC_NOT_CONNECTED || client.tcp == nullptr) {
+      continue;
+    }
+
+    // WiFiClient reads ahead into its own buffer, bytes already in there will not show up in select
+    if (client.tcp->available() > 0) {
+      return;
+    }
+
+    int fd = client.tcp->fd();
+    if (fd >= 0) {
+      FD_SET(fd, &readFds);
+      maxFd = std::max(maxFd, fd);
+    }
+  }
+
+  std::uint32_t timeoutMs = m_wakeFd >= 0 ? WEBSOCKET_IDLE_INTERVAL : WEBSOCKET_UPDATE_INTERVAL;
+
+  m_taskWakeups.fetch_add(1, std::memory_order_relaxed);
+
+  if (maxFd < 0) {
+    vTaskDelay(pdMS_TO_TICKS(timeoutMs));
+    return;
+  }
+
+  timeval timeout {.tv_sec = 0, .tv_usec = static_cast<suseconds_t>(timeoutMs * 1000)};
+
+  int ready = select(maxFd + 1, &readFds, nullptr, nullptr, &timeout);
+  if (ready < 0) {
+    ESP_LOGW(TAG, "select failed (errno %d)", errno);
+    vTaskDelay(pdMS_TO_TICKS(WEBSOCKET_UPDATE_INTERVAL));  // Do not spin if the failure persists
+    return;
+  }
+
+  if (ready > 0 && m_wakeFd >= 0 && FD_ISSET(m_wakeFd, &readFds)) {
+    std::uint64_t count;
+    read(m_wakeFd, &count, sizeof(count));  // Resets the counter, one wakeup covers every message queued so far
+  }
+}
+
+bool CaptivePortalInstance::wakeIf(bool queued) {
+  if (queued && m_wakeFd >= 0) {
+    std::uint64_t one = 1;
+    write(m_wakeFd, &one, sizeof(one));
+  }
+
+  return queued;
 }
 
 void CaptivePortalInstance::handleWebSocketClientConnected(std::uint8_t socketId) {
   ESP_LOGD(TAG, "WebSocket client #%u connected from %s", socketId, m_socketServer.remoteIP(socketId).toString().c_str());
 
+  // Broadcasts only reach subscribed clients, so subscribe before the network list is queued
+  if (!m_outbound.AddClient(socketId)) {
+    m_socketServer.disconnect(socketId);
+    return;
+  }
+
   WiFiNetwork connectedNetwork;
   WiFiNetwork* connectedNetworkPtr = nullptr;
   if (WiFiManager::GetConnectedNetwork(connectedNetwork)) {
@@ -159,14 +301,26 @@ void CaptivePortalInstance::handleWebSocketClientConnected(std::uint8_t socketId
 
   Serialization::Local::SerializeReadyMessage(connectedNetworkPtr, GatewayConnectionManager::IsLinked(), std::bind(&CaptivePortalInstance::sendMessageBIN, this, socketId, std::placeholders::_1, std::placeholders::_2));
 
-  // Send all previously scanned wifi networks
-  auto networks = OpenShock::WiFiManager::GetDiscoveredWiFiNetworks();
+  // Queue all previously scanned wifi networks while WiFiManager holds back its broadcasts. Taking the list and queueing it separately would let
+  // a lost or delta event slip in between, which the client then receives before a list that predates it, bringing lost networks back.
+  // The serialized list is shared between clients until the network table changes
+  OpenShock::WiFiManager::WithDiscoveredWiFiNetworks([this, socketId](std::uint32_t generation, const std::vector<WiFiNetwork>& networks) {
+    if (m_networksSnapshot == nullptr || m_networksSnapshotGeneration != generation) {
+      Serialization::Local::SerializeWiFiNetworksEvent(Serialization::Types::WifiNetworkEventType::Discovered, networks, [this](const std::uint8_t* data, std::size_t len) {
+        m_networksSnapshot = LocalOutboundQueue::MakeBuffer(data, len);
+        return true;
+      });
+      m_networksSnapshotGeneration = generation;
+    }
 
-  Serialization::Local::SerializeWiFiNetworksEvent(Serialization::Types::WifiNetworkEventType::Discovered, networks, std::bind(&CaptivePortalInstance::sendMessageBIN, this, socketId, std::placeholders::_1, std::placeholders::_2));
+    m_outbound.Send(socketId, true, m_networksSnapshot);
+  });
 }
 
 void CaptivePortalInstance::handleWebSocketClientDisconnected(std::uint8_t socketId) {
   ESP_LOGD(TAG, "WebSocket client #%u disconnected", socketId);
+
+  m_outbound.RemoveClient(socketId);
 }
 
 void CaptivePortalInstance::handleWebSocketClientError(std::uint8_t socketId, std::uint16_t code, const char* message) {
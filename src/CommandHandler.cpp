@@ -3,6 +3,7 @@
 #include "Chipset.h"
 #include "Common.h"
 #include "config/Config.h"
+#include "LatencyTrace.h"
 #include "Logging.h"
 #include "radio/RFTransmitter.h"
 #include "Time.h"
@@ -12,13 +13,22 @@
 #include <freertos/queue.h>
 #include <freertos/semphr.h>
 
+#include <algorithm>
+#include <functional>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 const char* const TAG = "CommandHandler";
 
-const std::int64_t KEEP_ALIVE_INTERVAL  = 60'000;
-const std::uint16_t KEEP_ALIVE_DURATION = 300;
+#ifndef OPENSHOCK_KEEPALIVE_IDLE_HORIZON_MS
+#define OPENSHOCK_KEEPALIVE_IDLE_HORIZON_MS (24LL * 60 * 60 * 1000)  // Shockers that have not been commanded for a day are forgotten
+#endif
+
+const std::int64_t KEEP_ALIVE_INTERVAL     = 60'000;
+const std::uint16_t KEEP_ALIVE_DURATION    = 300;
+const std::int64_t KEEP_ALIVE_BATCH_WINDOW = 1000;  // Keep-alives due within this window are sent together
+const std::int64_t KEEP_ALIVE_IDLE_HORIZON = OPENSHOCK_KEEPALIVE_IDLE_HORIZON_MS;
 
 using namespace OpenShock;
 
@@ -38,24 +48,100 @@ struct KnownShocker {
   std::int64_t lastActivityTimestamp;
 };
 
+struct KeepAliveState {
+  ShockerModelType model;
+  std::int64_t lastActivityTimestamp;  // Only commands refresh this, keep-alives do not
+  std::int64_t nextKeepAlive;
+};
+
+struct KeepAliveDeadline {
+  std::int64_t deadline;
+  std::uint16_t shockerId;
+
+  bool operator>(const KeepAliveDeadline& other) const { return deadline > other.deadline; }
+};
+
 static SemaphoreHandle_t s_rfTransmitterMutex         = nullptr;
-static std::unique_ptr<RFTransmitter> s_rfTransmitter = nullptr;
+static std::unique_ptr<RFTransmitter> s_rfTransmitter = nullptr;  // Main transmitter, serves every shocker that is not routed to another one
+static std::vector<std::unique_ptr<RFTransmitter>> s_extraRfTransmitters;
+static std::unordered_map<std::uint16_t, RFTransmitter*> s_rfTransmitterRoutes;  // Shocker ID to one of the extra transmitters
 
 static SemaphoreHandle_t s_keepAliveMutex = nullptr;
 static QueueHandle_t s_keepAliveQueue     = nullptr;
 static TaskHandle_t s_keepAliveTaskHandle = nullptr;
 
+/// @note Must be called with s_rfTransmitterMutex held
+RFTransmitter* _getRfTransmitter(std::uint16_t shockerId) {
+  auto it = s_rfTransmitterRoutes.find(shockerId);
+  if (it != s_rfTransmitterRoutes.end()) {
+    return it->second;
+  }
+
+  return s_rfTransmitter.get();
+}
+
+/// @note Must be called with s_rfTransmitterMutex held
+template<typename Fn>
+void _forEachRfTransmitter(Fn fn) {
+  if (s_rfTransmitter != nullptr) {
+    fn(*s_rfTransmitter);
+  }
+
+  for (auto& transmitter : s_extraRfTransmitters) {
+    fn(*transmitter);
+  }
+}
+
+bool _isExtraRfTxPin(std::uint8_t txPin) {
+  for (auto& transmitter : s_extraRfTransmitters) {
+    if (transmitter->GetTxPin() == txPin) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void _initExtraRfTransmitters(const std::vector<Config::RFTransmitterConfig>& configs, std::uint8_t mainTxPin) {
+  for (const auto& config : configs) {
+    if (!OpenShock::IsValidOutputPin(config.txPin) || config.txPin == mainTxPin || _isExtraRfTxPin(config.txPin)) {
+      ESP_LOGW(TAG, "Extra RF TX pin (%u) is invalid or already in use, skipping transmitter", config.txPin);
+      continue;
+    }
+
+    auto transmitter = std::make_unique<RFTransmitter>(config.txPin, config.coreId);
+    if (!transmitter->ok()) {
+      // RMT channels are limited, the main transmitter keeps serving the shockers of this one
+      ESP_LOGE(TAG, "Failed to initialize RF transmitter on pin %u", config.txPin);
+      continue;
+    }
+
+    for (std::uint16_t shockerId : config.shockerIds) {
+      if (!s_rfTransmitterRoutes.emplace(shockerId, transmitter.get()).second) {
+        ESP_LOGW(TAG, "Shocker %u is mapped to more than one RF transmitter, keeping the first", shockerId);
+      }
+    }
+
+    s_extraRfTransmitters.emplace_back(std::move(transmitter));
+  }
+}
+
 void _keepAliveTask(void* arg) {
   (void)arg;
 
-  std::int64_t timeToKeepAlive = KEEP_ALIVE_INTERVAL;
+  // Every known shocker, and a min-heap of their keep-alive deadlines.
+  // Heap entries are not removed when a shocker is commanded again, stale ones are skipped when they come up.
+  std::unordered_map<std::uint16_t, KeepAliveState> shockers;
+  std::vector<KeepAliveDeadline> deadlines;
+  std::vector<std::pair<std::uint16_t, ShockerModelType>> batch;
 
-  // Map of shocker IDs to time of next keep-alive
-  std::unordered_map<std::uint16_t, KnownShocker> activityMap;
+  auto pushDeadline = [&deadlines](std::int64_t deadline, std::uint16_t shockerId) {
+    deadlines.push_back({deadline, shockerId});
+    std::push_heap(deadlines.begin(), deadlines.end(), std::greater<KeepAliveDeadline>());
+  };
 
   while (true) {
-    // Calculate eepyTime based on the timeToKeepAlive
-    std::uint32_t eepyTime = calculateEepyTime(timeToKeepAlive);
+    std::uint32_t eepyTime = calculateEepyTime(deadlines.empty() ? OpenShock::millis() + KEEP_ALIVE_INTERVAL : deadlines.front().deadline);
 
     KnownShocker cmd;
     while (xQueueReceive(s_keepAliveQueue, &cmd, pdMS_TO_TICKS(eepyTime)) == pdTRUE) {
@@ -65,38 +151,73 @@ void _keepAliveTask(void* arg) {
         break;  // This should never be reached
       }
 
-      activityMap[cmd.shockerId] = cmd;
+      std::int64_t nextKeepAlive = cmd.lastActivityTimestamp + KEEP_ALIVE_INTERVAL;
+
+      shockers[cmd.shockerId] = {.model = cmd.model, .lastActivityTimestamp = cmd.lastActivityTimestamp, .nextKeepAlive = nextKeepAlive};
+      pushDeadline(nextKeepAlive, cmd.shockerId);
 
-      eepyTime = calculateEepyTime(std::min(timeToKeepAlive, cmd.lastActivityTimestamp + KEEP_ALIVE_INTERVAL));
+      eepyTime = calculateEepyTime(deadlines.front().deadline);
+    }
+
+    // Frequent commands leave many stale entries behind, rebuild the heap from the live ones when they dominate
+    if (deadlines.size() > shockers.size() * 2 + 16) {
+      deadlines.clear();
+      for (const auto& [shockerId, state] : shockers) {
+        deadlines.push_back({state.nextKeepAlive, shockerId});
+      }
+      std::make_heap(deadlines.begin(), deadlines.end(), std::greater<KeepAliveDeadline>());
     }
 
-    // Update the time to now
     std::int64_t now = OpenShock::millis();
 
-    // Keep track of the minimum activity time, so we know when to wake up
-    timeToKeepAlive = now + KEEP_ALIVE_INTERVAL;
+    // Collect everything that is due, or will be shortly, so it goes out together
+    batch.clear();
+    while (!deadlines.empty() && deadlines.front().deadline <= now + KEEP_ALIVE_BATCH_WINDOW) {
+      std::pop_heap(deadlines.begin(), deadlines.end(), std::greater<KeepAliveDeadline>());
+      KeepAliveDeadline due = deadlines.back();
+      deadlines.pop_back();
 
-    // For every entry that has a keep-alive time less than now, send a keep-alive
-    for (auto it = activityMap.begin(); it != activityMap.end(); ++it) {
-      auto& cmdRef = it->second;
+      auto it = shockers.find(due.shockerId);
+      if (it == shockers.end() || it->second.nextKeepAlive != due.deadline) {
+        continue;  // Stale
+      }
 
-      if (cmdRef.lastActivityTimestamp + KEEP_ALIVE_INTERVAL < now) {
-        ESP_LOGV(TAG, "Sending keep-alive for shocker %u", cmdRef.shockerId);
+      KeepAliveState& state = it->second;
 
-        if (s_rfTransmitter == nullptr) {
-          ESP_LOGW(TAG, "RF Transmitter is not initialized, ignoring keep-alive");
-          break;
-        }
+      if (now - state.lastActivityTimestamp > KEEP_ALIVE_IDLE_HORIZON) {
+        ESP_LOGD(TAG, "Shocker %u has been idle for too long, no longer sending keep-alives", due.shockerId);
+        shockers.erase(it);
+        continue;
+      }
+
+      batch.emplace_back(due.shockerId, state.model);
+
+      state.nextKeepAlive = std::max(now, due.deadline) + KEEP_ALIVE_INTERVAL;
+      pushDeadline(state.nextKeepAlive, due.shockerId);
+    }
+
+    if (batch.empty()) {
+      continue;
+    }
+
+    ESP_LOGV(TAG, "Sending %zu keep-alives", batch.size());
 
-        if (!s_rfTransmitter->SendCommand(cmdRef.model, cmdRef.shockerId, ShockerCommandType::Vibrate, 0, KEEP_ALIVE_DURATION, false)) {
-          ESP_LOGW(TAG, "Failed to send keep-alive for shocker %u", cmdRef.shockerId);
-        }
+    // The transmitter only accepts one producer at a time, take it once for the whole batch
+    xSemaphoreTake(s_rfTransmitterMutex, portMAX_DELAY);
 
-        cmdRef.lastActivityTimestamp = now;
+    for (const auto& [shockerId, model] : batch) {
+      RFTransmitter* transmitter = _getRfTransmitter(shockerId);
+      if (transmitter == nullptr) {
+        ESP_LOGW(TAG, "RF Transmitter is not initialized, ignoring keep-alive");
+        break;
       }
 
-      timeToKeepAlive = std::min(timeToKeepAlive, cmdRef.lastActivityTimestamp + KEEP_ALIVE_INTERVAL);
+      if (!transmitter->SendCommand(model, shockerId, ShockerCommandType::Vibrate, 0, KEEP_ALIVE_DURATION, false)) {
+        ESP_LOGW(TAG, "Failed to send keep-alive for shocker %u", shockerId);
+      }
     }
+
+    xSemaphoreGive(s_rfTransmitterMutex);
   }
 }
 
@@ -193,6 +314,8 @@ bool CommandHandler::Init() {
     return false;
   }
 
+  _initExtraRfTransmitters(rfConfig.transmitters, txPin);
+
   if (rfConfig.keepAliveEnabled) {
     _internalSetKeepAliveEnabled(true);
   }
@@ -211,6 +334,13 @@ SetRfPinResultCode CommandHandler::SetRfTxPin(std::uint8_t txPin) {
 
   xSemaphoreTake(s_rfTransmitterMutex, portMAX_DELAY);
 
+  if (_isExtraRfTxPin(txPin)) {
+    ESP_LOGE(TAG, "RF TX pin %u is already used by another transmitter", txPin);
+
+    xSemaphoreGive(s_rfTransmitterMutex);
+    return SetRfPinResultCode::InvalidPin;
+  }
+
   if (s_rfTransmitter != nullptr) {
     ESP_LOGV(TAG, "Destroying existing RF transmitter");
     s_rfTransmitter = nullptr;
@@ -279,10 +409,50 @@ std::uint8_t CommandHandler::GetRfTxPin() {
   return txPin;
 }
 
+bool CommandHandler::GetRfSlotStats(std::vector<RFScheduler::SlotStats>& out) {
+  if (s_rfTransmitterMutex == nullptr) {
+    return false;
+  }
+
+  out.clear();
+
+  xSemaphoreTake(s_rfTransmitterMutex, portMAX_DELAY);
+
+  // Extra transmitters keep running if SetRfTxPin fails to bring the main one back, so only having none at all counts as nothing to report
+  bool anyTransmitter = false;
+
+  std::vector<RFScheduler::SlotStats> slotStats;
+  _forEachRfTransmitter([&](RFTransmitter& transmitter) {
+    transmitter.GetSlotStats(slotStats);
+    out.insert(out.end(), slotStats.begin(), slotStats.end());
+    anyTransmitter = true;
+  });
+
+  xSemaphoreGive(s_rfTransmitterMutex);
+  return anyTransmitter;
+}
+
+bool CommandHandler::GetRfTransmitStats(std::vector<RFTransmitter::TransmitStats>& out) {
+  if (s_rfTransmitterMutex == nullptr) {
+    return false;
+  }
+
+  out.clear();
+
+  xSemaphoreTake(s_rfTransmitterMutex, portMAX_DELAY);
+  _forEachRfTransmitter([&](RFTransmitter& transmitter) { out.push_back(transmitter.GetTransmitStats()); });
+  xSemaphoreGive(s_rfTransmitterMutex);
+
+  return !out.empty();
+}
+
 bool CommandHandler::HandleCommand(ShockerModelType model, std::uint16_t shockerId, ShockerCommandType type, std::uint8_t intensity, std::uint16_t durationMs) {
+  std::uint32_t traceId = LatencyTrace::Begin(OpenShock::micros());
+
   xSemaphoreTake(s_rfTransmitterMutex, portMAX_DELAY);
 
-  if (s_rfTransmitter == nullptr) {
+  RFTransmitter* transmitter = _getRfTransmitter(shockerId);
+  if (transmitter == nullptr) {
     ESP_LOGW(TAG, "RF Transmitter is not initialized, ignoring command");
 
     xSemaphoreGive(s_rfTransmitterMutex);
@@ -297,12 +467,12 @@ bool CommandHandler::HandleCommand(ShockerModelType model, std::uint16_t shocker
     intensity  = 0;
     durationMs = 300;
 
-    s_rfTransmitter->ClearPendingCommands();
+    _forEachRfTransmitter([](RFTransmitter& transmitter) { transmitter.ClearPendingCommands(); });
   } else {
     ESP_LOGD(TAG, "Command received: %u %u %u %u", model, shockerId, type, intensity);
   }
 
-  bool ok = s_rfTransmitter->SendCommand(model, shockerId, type, intensity, durationMs);
+  bool ok = transmitter->SendCommand(model, shockerId, type, intensity, durationMs, true, traceId);
 
   xSemaphoreGive(s_rfTransmitterMutex);
   xSemaphoreTake(s_keepAliveMutex, portMAX_DELAY);
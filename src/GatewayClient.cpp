@@ -14,9 +14,48 @@ const char* const TAG = "GatewayClient";
 
 using namespace OpenShock;
 
-static bool s_bootStatusSent = false;
+const std::size_t MAX_SENDS_PER_LOOP = 4;  // Bounds how long one loop() can spend writing
 
-GatewayClient::GatewayClient(const std::string& authToken) : m_webSocket(), m_lastKeepAlive(0), m_state(State::Disconnected) {
+static bool s_bootStatusSent = false;  // Only set once the message was actually written, queueing it is not enough
+
+void _classifyMessage(const std::uint8_t* data, GatewayOutboundQueue::Priority& priority, std::uint32_t& coalesceKey) {
+  typedef Serialization::Gateway::HubToGatewayMessagePayload PayloadType;
+
+  // Outgoing buffers come from our own serializers, so the root can be read without verification
+  auto msg = flatbuffers::GetRoot<Serialization::Gateway::HubToGatewayMessage>(data);
+
+  PayloadType type = msg->payload_type();
+  switch (type) {
+    case PayloadType::KeepAlive:
+      priority    = GatewayOutboundQueue::Priority::Normal;
+      coalesceKey = static_cast<std::uint32_t>(type) << 8;  // A newer keep-alive makes a pending one pointless
+      break;
+    case PayloadType::OtaInstallProgress:
+      priority    = GatewayOutboundQueue::Priority::Low;
+      coalesceKey = (static_cast<std::uint32_t>(type) << 8) | static_cast<std::uint8_t>(msg->payload_as_OtaInstallProgress()->task());  // Only the newest progress per task matters
+      break;
+    case PayloadType::BootStatus:
+      priority    = GatewayOutboundQueue::Priority::High;
+      coalesceKey = static_cast<std::uint32_t>(type) << 8;  // Re-sent on every connect until it goes out, so keep just one
+      break;
+    case PayloadType::OtaInstallStarted:
+    case PayloadType::OtaInstallFailed:
+      priority    = GatewayOutboundQueue::Priority::High;
+      coalesceKey = 0;
+      break;
+    default:
+      priority    = GatewayOutboundQueue::Priority::Normal;
+      coalesceKey = 0;
+      break;
+  }
+}
+
+GatewayClient::GatewayClient(const std::string& authToken)
+  : m_webSocket()
+  , m_deFragger([this](std::uint8_t socketId, WebSocketMessageType type, const std::uint8_t* data, std::uint32_t length) { _handleEvent(type, data, length); }, EventHandlers::WebSocket::GATEWAY_MAX_MESSAGE_SIZE)
+  , m_outbound()
+  , m_lastKeepAlive(0)
+  , m_state(State::Disconnected) {
   ESP_LOGD(TAG, "Creating GatewayClient");
 
   std::string headers = "Firmware-Version: " OPENSHOCK_FW_VERSION "\r\n"
@@ -25,7 +64,8 @@ GatewayClient::GatewayClient(const std::string& authToken) : m_webSocket(), m_la
 
   m_webSocket.setUserAgent(OpenShock::Constants::FW_USERAGENT);
   m_webSocket.setExtraHeaders(headers.c_str());
-  m_webSocket.onEvent(std::bind(&GatewayClient::_handleEvent, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+  // There is only one connection, so it always uses socket 0 of the defragmenter
+  m_webSocket.onEvent([this](WStype_t type, std::uint8_t* payload, std::size_t length) { m_deFragger.handler(0, type, payload, length); });
 }
 GatewayClient::~GatewayClient() {
   ESP_LOGD(TAG, "Destroying GatewayClient");
@@ -69,7 +109,7 @@ bool GatewayClient::sendMessageTXT(StringView data) {
     return false;
   }
 
-  return m_webSocket.sendTXT(data.data(), data.length());
+  return m_outbound.Push(false, reinterpret_cast<const std::uint8_t*>(data.data()), data.length(), GatewayOutboundQueue::Priority::Normal, 0);
 }
 
 bool GatewayClient::sendMessageBIN(const std::uint8_t* data, std::size_t length) {
@@ -77,7 +117,11 @@ bool GatewayClient::sendMessageBIN(const std::uint8_t* data, std::size_t length)
     return false;
   }
 
-  return m_webSocket.sendBIN(data, length);
+  GatewayOutboundQueue::Priority priority;
+  std::uint32_t coalesceKey;
+  _classifyMessage(data, priority, coalesceKey);
+
+  return m_outbound.Push(true, data, length, priority, coalesceKey);
 }
 
 bool GatewayClient::loop() {
@@ -102,6 +146,20 @@ bool GatewayClient::loop() {
     m_lastKeepAlive = msNow;
   }
 
+  // Only this task touches the socket, producers on other tasks just queue
+  m_outbound.Drain(MAX_SENDS_PER_LOOP, [this](bool binary, const std::uint8_t* data, std::size_t length) {
+    if (!binary) {
+      return m_webSocket.sendTXT(data, length);
+    }
+
+    bool ok = m_webSocket.sendBIN(data, length);
+    if (ok && !s_bootStatusSent && flatbuffers::GetRoot<Serialization::Gateway::HubToGatewayMessage>(data)->payload_type() == Serialization::Gateway::HubToGatewayMessagePayload::BootStatus) {
+      _onBootStatusSent();
+    }
+
+    return ok;
+  });
+
   return true;
 }
 
@@ -115,6 +173,7 @@ void GatewayClient::_setState(State state) {
   switch (m_state) {
     case State::Disconnected:
       ESP_LOGI(TAG, "Disconnected from API");
+      m_outbound.Clear();  // Messages belong to the session that just ended
       OpenShock::VisualStateManager::SetWebSocketConnected(false);
       break;
     case State::Connected:
@@ -128,7 +187,7 @@ void GatewayClient::_setState(State state) {
 
 void GatewayClient::_sendKeepAlive() {
   ESP_LOGV(TAG, "Sending Gateway keep-alive message");
-  Serialization::Gateway::SerializeKeepAliveMessage([this](const std::uint8_t* data, std::size_t len) { return m_webSocket.sendBIN(data, len); });
+  Serialization::Gateway::SerializeKeepAliveMessage([this](const std::uint8_t* data, std::size_t len) { return sendMessageBIN(data, len); });
 }
 
 void GatewayClient::_sendBootStatus() {
@@ -142,66 +201,60 @@ void GatewayClient::_sendBootStatus() {
     return;
   }
 
-  OpenShock::OtaUpdateStep updateStep;
-  if (!Config::GetOtaUpdateStep(updateStep)) {
-    ESP_LOGE(TAG, "Failed to get OTA firmware boot type");
-    return;
-  }
-
   OpenShock::SemVer version;
   if (!OpenShock::TryParseSemVer(OPENSHOCK_FW_VERSION, version)) {
     ESP_LOGE(TAG, "Failed to parse firmware version");
     return;
   }
 
-  s_bootStatusSent = Serialization::Gateway::SerializeBootStatusMessage(updateId, OtaUpdateManager::GetFirmwareBootType(), version, [this](const std::uint8_t* data, std::size_t len) { return m_webSocket.sendBIN(data, len); });
+  if (!Serialization::Gateway::SerializeBootStatusMessage(updateId, OtaUpdateManager::GetFirmwareBootType(), version, [this](const std::uint8_t* data, std::size_t len) { return sendMessageBIN(data, len); })) {
+    ESP_LOGE(TAG, "Failed to queue boot status message");
+  }
+}
+
+void GatewayClient::_onBootStatusSent() {
+  s_bootStatusSent = true;
 
-  if (s_bootStatusSent && updateStep != OpenShock::OtaUpdateStep::None) {
+  // The OTA result is only forgotten once the gateway has it, a lost message gets re-sent on the next connect instead
+  OpenShock::OtaUpdateStep updateStep;
+  if (!Config::GetOtaUpdateStep(updateStep)) {
+    ESP_LOGE(TAG, "Failed to get OTA firmware boot type");
+    return;
+  }
+
+  if (updateStep != OpenShock::OtaUpdateStep::None) {
     if (!Config::SetOtaUpdateStep(OpenShock::OtaUpdateStep::None)) {
       ESP_LOGE(TAG, "Failed to reset firmware boot type to normal");
     }
   }
 }
 
-void GatewayClient::_handleEvent(WStype_t type, std::uint8_t* payload, std::size_t length) {
-  (void)payload;
-
+void GatewayClient::_handleEvent(WebSocketMessageType type, const std::uint8_t* payload, std::size_t length) {
   switch (type) {
-    case WStype_DISCONNECTED:
+    case WebSocketMessageType::Disconnected:
       _setState(State::Disconnected);
       break;
-    case WStype_CONNECTED:
+    case WebSocketMessageType::Connected:
       _setState(State::Connected);
       _sendKeepAlive();
       _sendBootStatus();
       break;
-    case WStype_TEXT:
+    case WebSocketMessageType::Text:
       ESP_LOGW(TAG, "Received text from API, JSON parsing is not supported anymore :D");
       break;
-    case WStype_ERROR:
-      ESP_LOGE(TAG, "Received error from API");
+    case WebSocketMessageType::Error:
+      ESP_LOGE(TAG, "Received error from API: %.*s", static_cast<int>(length), reinterpret_cast<const char*>(payload));
       break;
-    case WStype_FRAGMENT_TEXT_START:
-      ESP_LOGD(TAG, "Received fragment text start from API");
-      break;
-    case WStype_FRAGMENT:
-      ESP_LOGD(TAG, "Received fragment from API");
-      break;
-    case WStype_FRAGMENT_FIN:
-      ESP_LOGD(TAG, "Received fragment fin from API");
-      break;
-    case WStype_PING:
+    case WebSocketMessageType::Ping:
       ESP_LOGD(TAG, "Received ping from API");
       break;
-    case WStype_PONG:
+    case WebSocketMessageType::Pong:
       ESP_LOGD(TAG, "Received pong from API");
       break;
-    case WStype_BIN:
+    case WebSocketMessageType::Binary:
+      // Fragmented messages arrive here once fully reassembled
       EventHandlers::WebSocket::HandleGatewayBinary(payload, length);
       break;
-    case WStype_FRAGMENT_BIN_START:
-      ESP_LOGE(TAG, "Received binary fragment start from API, this is not supported!");
-      break;
     default:
       ESP_LOGE(TAG, "Received unknown event from API");
       break;
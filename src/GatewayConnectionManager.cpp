@@ -147,6 +147,31 @@ bool GatewayConnectionManager::SendMessageBIN(const std::uint8_t* data, std::siz
   return s_wsClient->sendMessageBIN(data, length);
 }
 
+bool GatewayConnectionManager::GetOutboundStats(GatewayOutboundQueue::Stats& out) {
+  if (s_wsClient == nullptr) {
+    return false;
+  }
+
+  out = s_wsClient->outboundStats();
+
+  return true;
+}
+
+bool GatewayConnectionManager::FlushOutbound(std::uint32_t timeoutMs) {
+  std::int64_t deadline = OpenShock::millis() + timeoutMs;
+
+  // Only the task running Update() may write to the socket, so this just polls until it caught up
+  while (s_wsClient != nullptr && s_wsClient->state() == GatewayClient::State::Connected && s_wsClient->hasPendingOutbound()) {
+    if (OpenShock::millis() >= deadline) {
+      return false;
+    }
+
+    vTaskDelay(pdMS_TO_TICKS(10));
+  }
+
+  return true;
+}
+
 bool FetchDeviceInfo(StringView authToken) {
   // TODO: this function is very slow, should be optimized!
   if ((s_flags & FLAG_HAS_IP) == 0) {
@@ -0,0 +1,243 @@
+#include "GatewayOutboundQueue.h"
+
+#include "Logging.h"
+#include "Time.h"
+
+const char* const TAG = "GatewayOutboundQueue";
+
+using namespace OpenShock;
+
+GatewayOutboundQueue::GatewayOutboundQueue() : m_mutex(xSemaphoreCreateMutex()), m_entries(), m_sending(), m_inFlight(false), m_nextSequence(0), m_stats() { }
+
+GatewayOutboundQueue::~GatewayOutboundQueue() {
+  vSemaphoreDelete(m_mutex);
+}
+
+int GatewayOutboundQueue::findOldest() const {
+  int oldest = -1;
+  for (std::size_t i = 0; i < kCapacity; ++i) {
+    const Entry& entry = m_entries[i];
+    if (!entry.used) {
+      continue;
+    }
+
+    // Sequence numbers wrap, so compare by distance
+    if (oldest < 0 || static_cast<std::int32_t>(entry.sequence - m_entries[oldest].sequence) < 0) {
+      oldest = static_cast<int>(i);
+    }
+  }
+
+  return oldest;
+}
+
+int GatewayOutboundQueue::findVictim(Priority priority) const {
+  // Oldest message of the lowest priority below the incoming one
+  int victim = -1;
+  for (std::size_t i = 0; i < kCapacity; ++i) {
+    const Entry& entry = m_entries[i];
+    if (!entry.used || entry.priority >= priority) {
+      continue;
+    }
+
+    if (victim < 0) {
+      victim = static_cast<int>(i);
+      continue;
+    }
+
+    const Entry& current = m_entries[victim];
+    if (entry.priority < current.priority || (entry.priority == current.priority && static_cast<std::int32_t>(entry.sequence - current.sequence) < 0)) {
+      victim = static_cast<int>(i);
+    }
+  }
+
+  return victim;
+}
+
+int GatewayOutboundQueue::findSlot(Priority priority) {
+  for (std::size_t i = 0; i < kCapacity; ++i) {
+    if (!m_entries[i].used) {
+      return static_cast<int>(i);
+    }
+  }
+
+  int index = findVictim(priority);
+  if (index >= 0) {
+    m_entries[index].used = false;
+    ++m_stats.dropped;
+    --m_stats.depth;
+  }
+
+  return index;
+}
+
+bool GatewayOutboundQueue::Push(bool binary, const std::uint8_t* data, std::size_t length, Priority priority, std::uint32_t coalesceKey) {
+  std::int64_t nowUs = OpenShock::micros();
+
+  xSemaphoreTake(m_mutex, portMAX_DELAY);
+
+  if (coalesceKey != 0) {
+    for (auto& entry : m_entries) {
+      if (entry.used && entry.coalesceKey == coalesceKey) {
+        // Keeps its place in the queue and its original timestamp, so latency shows how stale the stream got
+        entry.binary   = binary;
+        entry.priority = priority;
+        entry.data.assign(data, data + length);
+
+        ++m_stats.coalesced;
+
+        xSemaphoreGive(m_mutex);
+        return true;
+      }
+    }
+  }
+
+  int index = findSlot(priority);
+  if (index < 0) {
+    ++m_stats.dropped;
+    xSemaphoreGive(m_mutex);
+
+    ESP_LOGW(TAG, "Queue full, dropping message");
+    return false;
+  }
+
+  Entry& entry      = m_entries[index];
+  entry.used        = true;
+  entry.binary      = binary;
+  entry.priority    = priority;
+  entry.coalesceKey = coalesceKey;
+  entry.sequence    = m_nextSequence++;
+  entry.queuedUs    = nowUs;
+  entry.data.assign(data, data + length);
+
+  ++m_stats.queued;
+  if (++m_stats.depth > m_stats.maxDepth) {
+    m_stats.maxDepth = m_stats.depth;
+  }
+
+  xSemaphoreGive(m_mutex);
+
+  return true;
+}
+
+std::size_t GatewayOutboundQueue::Drain(std::size_t maxMessages, const SendFn& send) {
+  std::size_t drained = 0;
+
+  while (drained < maxMessages) {
+    xSemaphoreTake(m_mutex, portMAX_DELAY);
+
+    int index = findOldest();
+    if (index < 0) {
+      xSemaphoreGive(m_mutex);
+      break;
+    }
+
+    // Swap the buffer out so the slot can be reused while the write is in progress, the capacities just trade places
+    Entry& entry = m_entries[index];
+    m_sending.swap(entry.data);
+    bool binary               = entry.binary;
+    Priority priority         = entry.priority;
+    std::uint32_t coalesceKey = entry.coalesceKey;
+    std::uint32_t sequence    = entry.sequence;
+    std::int64_t queuedUs     = entry.queuedUs;
+    entry.used                = false;
+    m_inFlight                = true;
+    --m_stats.depth;
+
+    xSemaphoreGive(m_mutex);
+
+    std::int64_t startUs = OpenShock::micros();
+    bool ok              = send(binary, m_sending.data(), m_sending.size());
+    std::int64_t endUs   = OpenShock::micros();
+
+    std::uint32_t latencyUs = static_cast<std::uint32_t>(endUs - queuedUs);
+    std::uint32_t sendUs    = static_cast<std::uint32_t>(endUs - startUs);
+
+    xSemaphoreTake(m_mutex, portMAX_DELAY);
+
+    m_inFlight = false;
+
+    bool requeued = false;
+    if (ok) {
+      ++m_stats.sent;
+    } else {
+      ++m_stats.sendFailures;
+
+      // Only High priority messages are retried, anything else would just wait behind a connection that is going down
+      bool superseded = false;
+      for (const auto& pending : m_entries) {
+        superseded = superseded || (coalesceKey != 0 && pending.used && pending.coalesceKey == coalesceKey);
+      }
+
+      int slot = priority == Priority::High && !superseded ? findSlot(priority) : -1;
+      if (slot >= 0) {
+        // Keeps its original sequence, so it is the first to go out once the connection is back
+        Entry& retry      = m_entries[slot];
+        retry.used        = true;
+        retry.binary      = binary;
+        retry.priority    = priority;
+        retry.coalesceKey = coalesceKey;
+        retry.sequence    = sequence;
+        retry.queuedUs    = queuedUs;
+        retry.data.swap(m_sending);
+
+        ++m_stats.requeued;
+        ++m_stats.depth;
+        requeued = true;
+      }
+    }
+
+    m_stats.lastLatencyUs = latencyUs;
+    if (latencyUs > m_stats.maxLatencyUs) {
+      m_stats.maxLatencyUs = latencyUs;
+    }
+    if (sendUs > m_stats.maxSendUs) {
+      m_stats.maxSendUs = sendUs;
+    }
+
+    xSemaphoreGive(m_mutex);
+
+    ++drained;
+
+    if (requeued) {
+      break;
+    }
+  }
+
+  return drained;
+}
+
+void GatewayOutboundQueue::Clear() {
+  xSemaphoreTake(m_mutex, portMAX_DELAY);
+
+  // Boot status and OTA results still matter to the gateway after a reconnect, everything else belonged to the old session
+  for (auto& entry : m_entries) {
+    if (entry.used && entry.priority != Priority::High) {
+      entry.used = false;
+      ++m_stats.dropped;
+      --m_stats.depth;
+    }
+  }
+
+  xSemaphoreGive(m_mutex);
+}
+
+bool GatewayOutboundQueue::HasPending() const {
+  xSemaphoreTake(m_mutex, portMAX_DELAY);
+
+  bool pending = m_inFlight;
+  for (const auto& entry : m_entries) {
+    pending = pending || entry.used;
+  }
+
+  xSemaphoreGive(m_mutex);
+
+  return pending;
+}
+
+GatewayOutboundQueue::Stats GatewayOutboundQueue::GetStats() const {
+  xSemaphoreTake(m_mutex, portMAX_DELAY);
+  Stats stats = m_stats;
+  xSemaphoreGive(m_mutex);
+
+  return stats;
+}
@@ -0,0 +1,167 @@
+#include "LatencyTrace.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <limits>
+
+using namespace OpenShock;
+
+const std::size_t TRACE_RING_SIZE = 64;  // Enough for a few seconds of interactive use, older traces are overwritten
+
+const std::uint32_t UNSET     = std::numeric_limits<std::uint32_t>::max();
+const std::size_t STAGE_COUNT = static_cast<std::size_t>(LatencyTrace::Stage::Count);
+
+static const char* const STAGE_NAMES[STAGE_COUNT] = {"Received", "Verified", "Handled", "Queued", "Dequeued", "Transmitted"};
+
+// Offsets are relative to receipt and 32 bits wide, 64-bit atomics are not lock-free on the ESP32
+struct TraceRecord {
+  std::atomic<std::uint32_t> id;
+  std::int64_t receivedUs;  // Written before id is published
+  std::array<std::atomic<std::uint32_t>, STAGE_COUNT> offsetsUs;
+};
+
+struct MessageContext {
+  bool active;
+  std::int64_t receivedUs;
+  std::int64_t verifiedUs;
+};
+
+static std::array<TraceRecord, TRACE_RING_SIZE> s_records {};
+static std::atomic<std::uint32_t> s_nextId {1};
+// Per task, so Begin() on any other task sees no message instead of racing the gateway task's writes.
+// The FreeRTOS thread local storage pointer slot is already owned by pthreads on ESP-IDF, compiler TLS gives each task its own copy without one.
+static thread_local MessageContext s_message {};
+
+void LatencyTrace::BeginMessage(std::int64_t receivedUs) {
+  s_message = {.active = true, .receivedUs = receivedUs, .verifiedUs = 0};
+}
+
+void LatencyTrace::MarkMessageVerified(std::int64_t verifiedUs) {
+  s_message.verifiedUs = verifiedUs;
+}
+
+void LatencyTrace::EndMessage() {
+  s_message.active = false;
+}
+
+std::uint32_t LatencyTrace::Begin(std::int64_t handledUs) {
+  if (!s_message.active) {
+    return 0;  // Keep-alives, serial commands and the like are not traced
+  }
+
+  std::uint32_t id = s_nextId.fetch_add(1, std::memory_order_relaxed);
+  if (id == 0) {
+    id = s_nextId.fetch_add(1, std::memory_order_relaxed);  // 0 means untraced
+  }
+
+  TraceRecord& record = s_records[id % TRACE_RING_SIZE];
+
+  // Unpublish first, so marks for the previous occupant stop landing here
+  record.id.store(0, std::memory_order_relaxed);
+  record.receivedUs = s_message.receivedUs;
+  for (auto& offset : record.offsetsUs) {
+    offset.store(UNSET, std::memory_order_relaxed);
+  }
+
+  record.offsetsUs[static_cast<std::size_t>(Stage::Received)].store(0, std::memory_order_relaxed);
+  if (s_message.verifiedUs != 0) {
+    record.offsetsUs[static_cast<std::size_t>(Stage::Verified)].store(static_cast<std::uint32_t>(s_message.verifiedUs - s_message.receivedUs), std::memory_order_relaxed);
+  }
+  record.offsetsUs[static_cast<std::size_t>(Stage::Handled)].store(static_cast<std::uint32_t>(handledUs - s_message.receivedUs), std::memory_order_relaxed);
+
+  record.id.store(id, std::memory_order_release);
+
+  return id;
+}
+
+void LatencyTrace::Mark(std::uint32_t traceId, Stage stage, std::int64_t timeUs) {
+  if (traceId == 0) {
+    return;
+  }
+
+  TraceRecord& record = s_records[traceId % TRACE_RING_SIZE];
+  if (record.id.load(std::memory_order_acquire) != traceId) {
+    return;
+  }
+
+  std::int64_t offsetUs = std::clamp<std::int64_t>(timeUs - record.receivedUs, 0, UNSET - 1);
+
+  // Each stage is marked by a single task, so a plain check is enough to keep the first time
+  auto& slot = record.offsetsUs[static_cast<std::size_t>(stage)];
+  if (slot.load(std::memory_order_relaxed) == UNSET) {
+    slot.store(static_cast<std::uint32_t>(offsetUs), std::memory_order_relaxed);
+  }
+}
+
+std::uint32_t _percentile(std::vector<std::uint32_t>& samples, std::size_t percent) {
+  // Nearest rank
+  std::size_t rank  = (samples.size() * percent + 99) / 100;
+  std::size_t index = rank == 0 ? 0 : rank - 1;
+
+  std::nth_element(samples.begin(), samples.begin() + index, samples.end());
+
+  return samples[index];
+}
+
+void _appendStats(std::vector<LatencyTrace::StageStats>& out, const char* name, std::vector<std::uint32_t>& samples) {
+  LatencyTrace::StageStats stats {.name = name, .count = static_cast<std::uint32_t>(samples.size()), .p50Us = 0, .p95Us = 0, .p99Us = 0};
+
+  if (!samples.empty()) {
+    stats.p50Us = _percentile(samples, 50);
+    stats.p95Us = _percentile(samples, 95);
+    stats.p99Us = _percentile(samples, 99);
+  }
+
+  out.push_back(stats);
+}
+
+void LatencyTrace::GetStageStats(std::vector<StageStats>& out) {
+  // Snapshot the offsets of every published record, a record being rewritten concurrently may show up half updated, which only skews one sample
+  std::vector<std::array<std::uint32_t, STAGE_COUNT>> snapshot;
+  snapshot.reserve(TRACE_RING_SIZE);
+
+  for (const auto& record : s_records) {
+    if (record.id.load(std::memory_order_acquire) == 0) {
+      continue;
+    }
+
+    auto& offsets = snapshot.emplace_back();
+    for (std::size_t i = 0; i < STAGE_COUNT; ++i) {
+      offsets[i] = record.offsetsUs[i].load(std::memory_order_relaxed);
+    }
+  }
+
+  std::size_t snapshotSize = snapshot.size();
+
+  std::vector<std::uint32_t> samples;
+  samples.reserve(snapshotSize);
+
+  for (std::size_t stage = 1; stage < STAGE_COUNT; ++stage) {
+    samples.clear();
+    for (std::size_t i = 0; i < snapshotSize; ++i) {
+      const auto& offsets = snapshot[i];
+      if (offsets[stage] != UNSET && offsets[stage - 1] != UNSET && offsets[stage] >= offsets[stage - 1]) {
+        samples.push_back(offsets[stage] - offsets[stage - 1]);
+      }
+    }
+
+    _appendStats(out, STAGE_NAMES[stage], samples);
+  }
+
+  samples.clear();
+  for (std::size_t i = 0; i < snapshotSize; ++i) {
+    std::uint32_t transmitted = snapshot[i][static_cast<std::size_t>(Stage::Transmitted)];
+    if (transmitted != UNSET) {
+      samples.push_back(transmitted);
+    }
+  }
+
+  _appendStats(out, "Total", samples);
+}
+
+void LatencyTrace::Reset() {
+  for (auto& record : s_records) {
+    record.id.store(0, std::memory_order_relaxed);
+  }
+}
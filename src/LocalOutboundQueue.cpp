@@ -0,0 +1,221 @@
+#include "LocalOutboundQueue.h"
+
+#include "Logging.h"
+#include "Time.h"
+
+const char* const TAG = "LocalOutboundQueue";
+
+using namespace OpenShock;
+
+LocalOutboundQueue::Buffer LocalOutboundQueue::MakeBuffer(const std::uint8_t* data, std::size_t length) {
+  return std::make_shared<const std::vector<std::uint8_t>>(data, data + length);
+}
+
+LocalOutboundQueue::LocalOutboundQueue() : m_mutex(xSemaphoreCreateMutex()), m_clients(), m_stats() { }
+
+LocalOutboundQueue::~LocalOutboundQueue() {
+  vSemaphoreDelete(m_mutex);
+}
+
+void LocalOutboundQueue::push(Client& client, bool binary, const Buffer& buffer, std::int64_t nowUs) {
+  if (client.size == kClientCapacity) {
+    // The client is not keeping up, the oldest message is the most likely to be superseded already
+    client.entries[client.head].buffer.reset();
+    client.head = (client.head + 1) % kClientCapacity;
+    --client.size;
+
+    ++m_stats.dropped;
+  }
+
+  Entry& entry   = client.entries[(client.head + client.size) % kClientCapacity];
+  entry.binary   = binary;
+  entry.queuedUs = nowUs;
+  entry.buffer   = buffer;
+
+  if (++client.size > m_stats.maxDepth) {
+    m_stats.maxDepth = client.size;
+  }
+}
+
+void LocalOutboundQueue::clear(Client& client) {
+  for (auto& entry : client.entries) {
+    entry.buffer.reset();
+  }
+
+  client.head = 0;
+  client.size = 0;
+}
+
+bool LocalOutboundQueue::AddClient(std::uint8_t socketId) {
+  if (socketId >= kMaxClients) {
+    ESP_LOGE(TAG, "Socket ID %u is out of range", socketId);
+    return false;
+  }
+
+  xSemaphoreTake(m_mutex, portMAX_DELAY);
+
+  Client& client = m_clients[socketId];
+  clear(client);
+
+  if (!client.active) {
+    client.active = true;
+    ++m_stats.clients;
+  }
+
+  xSemaphoreGive(m_mutex);
+
+  return true;
+}
+
+void LocalOutboundQueue::RemoveClient(std::uint8_t socketId) {
+  if (socketId >= kMaxClients) {
+    return;
+  }
+
+  xSemaphoreTake(m_mutex, portMAX_DELAY);
+
+  Client& client = m_clients[socketId];
+  clear(client);
+
+  if (client.active) {
+    client.active = false;
+    --m_stats.clients;
+  }
+
+  xSemaphoreGive(m_mutex);
+}
+
+bool LocalOutboundQueue::Send(std::uint8_t socketId, bool binary, const Buffer& buffer) {
+  if (socketId >= kMaxClients || buffer == nullptr) {
+    return false;
+  }
+
+  std::int64_t nowUs = OpenShock::micros();
+
+  xSemaphoreTake(m_mutex, portMAX_DELAY);
+
+  Client& client = m_clients[socketId];
+  if (!client.active) {
+    xSemaphoreGive(m_mutex);
+    return false;
+  }
+
+  push(client, binary, buffer, nowUs);
+  ++m_stats.unicasts;
+
+  xSemaphoreGive(m_mutex);
+
+  return true;
+}
+
+bool LocalOutboundQueue::Broadcast(bool binary, const std::uint8_t* data, std::size_t length) {
+  // Copy outside of the lock, the callers serialize into a pooled builder that is reused as soon as this returns
+  Buffer buffer      = MakeBuffer(data, length);
+  std::int64_t nowUs = OpenShock::micros();
+
+  xSemaphoreTake(m_mutex, portMAX_DELAY);
+
+  bool queued = false;
+  for (auto& client : m_clients) {
+    if (client.active) {
+      push(client, binary, buffer, nowUs);
+      queued = true;
+    }
+  }
+
+  if (queued) {
+    ++m_stats.broadcasts;
+  }
+
+  xSemaphoreGive(m_mutex);
+
+  return queued;
+}
+
+std::size_t LocalOutboundQueue::Drain(std::size_t maxPerClient, const SendFn& send) {
+  std::size_t drained = 0;
+
+  // One message per client per round, so a client with a long backlog does not delay the others
+  for (std::size_t round = 0; round < maxPerClient; ++round) {
+    std::size_t drainedThisRound = 0;
+
+    for (std::size_t socketId = 0; socketId < kMaxClients; ++socketId) {
+      xSemaphoreTake(m_mutex, portMAX_DELAY);
+
+      Client& client = m_clients[socketId];
+      if (!client.active || client.size == 0) {
+        xSemaphoreGive(m_mutex);
+        continue;
+      }
+
+      // Take a reference, the buffer stays alive during the write even if the client is removed or the slot reused meanwhile
+      Entry& entry          = client.entries[client.head];
+      bool binary           = entry.binary;
+      std::int64_t queuedUs = entry.queuedUs;
+      Buffer buffer         = std::move(entry.buffer);
+      client.head           = (client.head + 1) % kClientCapacity;
+      --client.size;
+
+      xSemaphoreGive(m_mutex);
+
+      std::int64_t startUs = OpenShock::micros();
+      bool ok              = send(static_cast<std::uint8_t>(socketId), binary, buffer->data(), buffer->size());
+      std::int64_t endUs   = OpenShock::micros();
+
+      std::uint32_t latencyUs = static_cast<std::uint32_t>(endUs - queuedUs);
+      std::uint32_t sendUs    = static_cast<std::uint32_t>(endUs - startUs);
+
+      xSemaphoreTake(m_mutex, portMAX_DELAY);
+
+      if (ok) {
+        ++m_stats.sent;
+      } else {
+        ++m_stats.sendFailures;
+      }
+
+      m_stats.lastLatencyUs = latencyUs;
+      if (latencyUs > m_stats.maxLatencyUs) {
+        m_stats.maxLatencyUs = latencyUs;
+      }
+      if (sendUs > m_stats.maxSendUs) {
+        m_stats.maxSendUs = sendUs;
+      }
+
+      xSemaphoreGive(m_mutex);
+
+      ++drainedThisRound;
+    }
+
+    if (drainedThisRound == 0) {
+      break;
+    }
+
+    drained += drainedThisRound;
+  }
+
+  return drained;
+}
+
+bool LocalOutboundQueue::HasPending() const {
+  xSemaphoreTake(m_mutex, portMAX_DELAY);
+
+  bool pending = false;
+  for (const auto& client : m_clients) {
+    if (client.active && client.size != 0) {
+      pending = true;
+      break;
+    }
+  }
+
+  xSemaphoreGive(m_mutex);
+
+  return pending;
+}
+
+LocalOutboundQueue::Stats LocalOutboundQueue::GetStats() const {
+  xSemaphoreTake(m_mutex, portMAX_DELAY);
+  Stats stats = m_stats;
+  xSemaphoreGive(m_mutex);
+
+  return stats;
+}
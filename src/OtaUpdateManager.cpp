@@ -42,6 +42,8 @@
 
 const char* const TAG = "OtaUpdateManager";
 
+const std::uint32_t OTA_REBOOT_FLUSH_TIMEOUT_MS = 2000;
+
 /// @brief Stops initArduino() from handling OTA rollbacks
 /// @todo Get rid of Arduino entirely. >:(
 ///
@@ -320,6 +322,10 @@ void _otaUpdateTask(void* arg) {
       ESP_LOGE(TAG, "Failed to set OTA update step");
       continue;
     }
+    if (!Config::Flush()) {
+      ESP_LOGE(TAG, "Failed to save OTA update step");
+      continue;
+    }
 
     if (!Serialization::Gateway::SerializeOtaInstallStartedMessage(updateId, version, GatewayConnectionManager::SendMessageBIN)) {
       ESP_LOGE(TAG, "Failed to serialize OTA install started message");
@@ -371,7 +377,7 @@ void _otaUpdateTask(void* arg) {
     if (!_flashAppPartition(appPartition, release.appBinaryUrl, release.appBinaryHash)) continue;
 
     // Set OTA boot type in config.
-    if (!Config::SetOtaUpdateStep(OpenShock::OtaUpdateStep::Updated)) {
+    if (!Config::SetOtaUpdateStep(OpenShock::OtaUpdateStep::Updated) || !Config::Flush()) {
       ESP_LOGE(TAG, "Failed to set OTA update step");
       _sendFailureMessage("Failed to set OTA update step"_sv);
       continue;
@@ -383,9 +389,13 @@ void _otaUpdateTask(void* arg) {
     // Send reboot message.
     _sendProgressMessage(Serialization::Gateway::OtaInstallProgressTask::Rebooting, 0.0f);
 
+    // Give the gateway task a bounded window to write the reboot message, a restart would discard anything still queued.
+    if (!GatewayConnectionManager::FlushOutbound(OTA_REBOOT_FLUSH_TIMEOUT_MS)) {
+      ESP_LOGW(TAG, "Gateway messages still pending, restarting anyway");
+    }
+
     // Reboot into new firmware.
     ESP_LOGI(TAG, "Restarting into new firmware...");
-    vTaskDelay(pdMS_TO_TICKS(200));
     break;
   }
 
@@ -467,7 +477,7 @@ bool OtaUpdateManager::Init() {
   }
 
   if (updateStep == OtaUpdateStep::Updated) {
-    if (!Config::SetOtaUpdateStep(OtaUpdateStep::Validating)) {
+    if (!Config::SetOtaUpdateStep(OtaUpdateStep::Validating) || !Config::Flush()) {
       ESP_PANIC(TAG, "Failed to set OTA update step in critical section");  // TODO: THIS IS A CRITICAL SECTION, WHAT DO WE DO?
     }
   }
@@ -647,7 +657,7 @@ bool OtaUpdateManager::IsValidatingApp() {
 
 void OtaUpdateManager::InvalidateAndRollback() {
   // Set OTA boot type in config.
-  if (!Config::SetOtaUpdateStep(OpenShock::OtaUpdateStep::RollingBack)) {
+  if (!Config::SetOtaUpdateStep(OpenShock::OtaUpdateStep::RollingBack) || !Config::Flush()) {
     ESP_PANIC(TAG, "Failed to set OTA firmware boot type in critical section");  // TODO: THIS IS A CRITICAL SECTION, WHAT DO WE DO?
     return;
   }
@@ -678,7 +688,7 @@ void OtaUpdateManager::ValidateApp() {
   }
 
   // Set OTA boot type in config.
-  if (!Config::SetOtaUpdateStep(OpenShock::OtaUpdateStep::Validated)) {
+  if (!Config::SetOtaUpdateStep(OpenShock::OtaUpdateStep::Validated) || !Config::Flush()) {
     ESP_PANIC(TAG, "Failed to set OTA firmware boot type in critical section");  // TODO: THIS IS A CRITICAL SECTION, WHAT DO WE DO?
   }
 
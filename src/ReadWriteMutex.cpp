@@ -2,57 +2,232 @@
 
 #include "Logging.h"
 
+#include <esp_timer.h>
+
 const char* const TAG = "ReadWriteMutex";
 
-OpenShock::ReadWriteMutex::ReadWriteMutex() : m_mutex(xSemaphoreCreateMutex()), m_readSem(xSemaphoreCreateBinary()), m_readers(0) {
-  xSemaphoreGive(m_readSem);
+using namespace OpenShock;
+
+static portMUX_TYPE s_registrySpinlock = portMUX_INITIALIZER_UNLOCKED;
+static ReadWriteMutex* s_registryHead  = nullptr;
+
+void _updateMax(std::uint32_t& max, std::int64_t durationUs) {
+  if (static_cast<std::uint32_t>(durationUs) > max) {
+    max = static_cast<std::uint32_t>(durationUs);
+  }
 }
 
-OpenShock::ReadWriteMutex::~ReadWriteMutex() {
-  vSemaphoreDelete(m_mutex);
-  vSemaphoreDelete(m_readSem);
+ReadWriteMutex::ReadWriteMutex(const char* name)
+  : m_name(name)
+  , m_next(nullptr)
+  , m_writeMutex(xSemaphoreCreateMutex())
+  , m_readersDrained(xSemaphoreCreateBinary())
+  , m_readers(0)
+  , m_writer(false)
+  , m_stats {.name = name}
+  , m_readHoldStartUs(0)
+  , m_writeHoldStartUs(0) {
+  portMUX_INITIALIZE(&m_spinlock);
+
+  if (m_name != nullptr) {
+    portENTER_CRITICAL(&s_registrySpinlock);
+    m_next         = s_registryHead;
+    s_registryHead = this;
+    portEXIT_CRITICAL(&s_registrySpinlock);
+  }
 }
 
-bool OpenShock::ReadWriteMutex::lockRead(TickType_t xTicksToWait) {
-  if (xSemaphoreTake(m_readSem, xTicksToWait) == pdFALSE) {
-    ESP_LOGE(TAG, "Failed to take read semaphore");
-    return false;
+ReadWriteMutex::~ReadWriteMutex() {
+  if (m_name != nullptr) {
+    portENTER_CRITICAL(&s_registrySpinlock);
+    for (ReadWriteMutex** it = &s_registryHead; *it != nullptr; it = &(*it)->m_next) {
+      if (*it == this) {
+        *it = m_next;
+        break;
+      }
+    }
+    portEXIT_CRITICAL(&s_registrySpinlock);
   }
 
-  if (++m_readers == 1) {
-    if (xSemaphoreTake(m_mutex, xTicksToWait) == pdFALSE) {
-      xSemaphoreGive(m_readSem);
+  vSemaphoreDelete(m_writeMutex);
+  vSemaphoreDelete(m_readersDrained);
+}
+
+bool ReadWriteMutex::lockRead(TickType_t xTicksToWait) {
+  TimeOut_t timeout;
+  vTaskSetTimeOutState(&timeout);
+
+  bool contended       = false;
+  std::int64_t startUs = m_name != nullptr ? esp_timer_get_time() : 0;
+
+  while (true) {
+    portENTER_CRITICAL(&m_spinlock);
+    if (!m_writer) {
+      if (m_readers++ == 0 && m_name != nullptr) {
+        m_readHoldStartUs = esp_timer_get_time();
+      }
+      ++m_stats.readLocks;
+      portEXIT_CRITICAL(&m_spinlock);
+
+      if (contended) {
+        recordWait(startUs);
+      }
+
+      return true;
+    }
+    portEXIT_CRITICAL(&m_spinlock);
+
+    contended = true;
+
+    // A writer is inside or waiting for readers to drain, queue on its mutex so it inherits this task's priority
+    if (xTaskCheckForTimeOut(&timeout, &xTicksToWait) == pdTRUE || xSemaphoreTake(m_writeMutex, xTicksToWait) == pdFALSE) {
+      recordTimeout();
       return false;
     }
+
+    xSemaphoreGive(m_writeMutex);
+  }
+}
+
+void ReadWriteMutex::unlockRead() {
+  portENTER_CRITICAL(&m_spinlock);
+  if (m_readers <= 0) {
+    portEXIT_CRITICAL(&m_spinlock);
+    ESP_LOGE(TAG, "Read unlock without a matching read lock");
+    return;
   }
 
-  xSemaphoreGive(m_readSem);
+  bool drained = --m_readers == 0;
+  if (drained && m_name != nullptr) {
+    _updateMax(m_stats.maxReadHoldUs, esp_timer_get_time() - m_readHoldStartUs);
+  }
 
-  return true;
+  bool signalWriter = drained && m_writer;
+  portEXIT_CRITICAL(&m_spinlock);
+
+  if (signalWriter) {
+    xSemaphoreGive(m_readersDrained);
+  }
 }
 
-void OpenShock::ReadWriteMutex::unlockRead() {
-  if (xSemaphoreTake(m_readSem, portMAX_DELAY) == pdFALSE) {
-    ESP_LOGE(TAG, "Failed to take read semaphore");
-    return;
+bool ReadWriteMutex::lockWrite(TickType_t xTicksToWait) {
+  TimeOut_t timeout;
+  vTaskSetTimeOutState(&timeout);
+
+  bool contended       = false;
+  std::int64_t startUs = m_name != nullptr ? esp_timer_get_time() : 0;
+
+  // Only one writer gets past this point, later writers and new readers block here and lend it their priority
+  if (xSemaphoreTake(m_writeMutex, 0) == pdFALSE) {
+    contended = true;
+
+    if (xTaskCheckForTimeOut(&timeout, &xTicksToWait) == pdTRUE || xSemaphoreTake(m_writeMutex, xTicksToWait) == pdFALSE) {
+      recordTimeout();
+      return false;
+    }
   }
 
-  if (--m_readers == 0) {
-    xSemaphoreGive(m_mutex);
+  portENTER_CRITICAL(&m_spinlock);
+  m_writer    = true;
+  int readers = m_readers;
+  portEXIT_CRITICAL(&m_spinlock);
+
+  while (readers > 0) {
+    contended = true;
+
+    if (xTaskCheckForTimeOut(&timeout, &xTicksToWait) == pdTRUE || xSemaphoreTake(m_readersDrained, xTicksToWait) == pdFALSE) {
+      portENTER_CRITICAL(&m_spinlock);
+      m_writer = false;
+      portEXIT_CRITICAL(&m_spinlock);
+
+      xSemaphoreGive(m_writeMutex);
+
+      recordTimeout();
+      return false;
+    }
+
+    // A writer that timed out can leave a stale give behind, so check the count instead of trusting the semaphore
+    portENTER_CRITICAL(&m_spinlock);
+    readers = m_readers;
+    portEXIT_CRITICAL(&m_spinlock);
+  }
+
+  portENTER_CRITICAL(&m_spinlock);
+  ++m_stats.writeLocks;
+  if (m_name != nullptr) {
+    m_writeHoldStartUs = esp_timer_get_time();
+  }
+  portEXIT_CRITICAL(&m_spinlock);
+
+  if (contended) {
+    recordWait(startUs);
+  }
+
+  return true;
+}
+
+void ReadWriteMutex::unlockWrite() {
+  portENTER_CRITICAL(&m_spinlock);
+  m_writer = false;
+  if (m_name != nullptr) {
+    _updateMax(m_stats.maxWriteHoldUs, esp_timer_get_time() - m_writeHoldStartUs);
   }
+  portEXIT_CRITICAL(&m_spinlock);
 
-  xSemaphoreGive(m_readSem);
+  xSemaphoreGive(m_writeMutex);
 }
 
-bool OpenShock::ReadWriteMutex::lockWrite(TickType_t xTicksToWait) {
-  if (xSemaphoreTake(m_mutex, xTicksToWait) == pdFALSE) {
-    ESP_LOGE(TAG, "Failed to take mutex");
+bool ReadWriteMutex::getStats(Stats& out) const {
+  if (m_name == nullptr) {
     return false;
   }
 
+  portENTER_CRITICAL(&m_spinlock);
+  out = m_stats;
+  portEXIT_CRITICAL(&m_spinlock);
+
   return true;
 }
 
-void OpenShock::ReadWriteMutex::unlockWrite() {
-  xSemaphoreGive(m_mutex);
+void ReadWriteMutex::GetAllStats(std::vector<Stats>& out) {
+  std::size_t count = 0;
+
+  portENTER_CRITICAL(&s_registrySpinlock);
+  for (const ReadWriteMutex* it = s_registryHead; it != nullptr; it = it->m_next) {
+    ++count;
+  }
+  portEXIT_CRITICAL(&s_registrySpinlock);
+
+  // Allocating is not allowed inside a critical section, so reserve up front and skip locks registered in between
+  out.reserve(out.size() + count);
+
+  portENTER_CRITICAL(&s_registrySpinlock);
+  for (const ReadWriteMutex* it = s_registryHead; it != nullptr && out.size() < out.capacity(); it = it->m_next) {
+    Stats stats;
+    it->getStats(stats);
+    out.push_back(stats);
+  }
+  portEXIT_CRITICAL(&s_registrySpinlock);
+}
+
+void ReadWriteMutex::recordWait(std::int64_t startUs) {
+  if (m_name == nullptr) {
+    return;
+  }
+
+  std::int64_t waitUs = esp_timer_get_time() - startUs;
+
+  portENTER_CRITICAL(&m_spinlock);
+  ++m_stats.contended;
+  m_stats.totalWaitUs += static_cast<std::uint32_t>(waitUs);
+  _updateMax(m_stats.maxWaitUs, waitUs);
+  portEXIT_CRITICAL(&m_spinlock);
+}
+
+void ReadWriteMutex::recordTimeout() {
+  ESP_LOGE(TAG, "Timed out waiting for lock %s", m_name != nullptr ? m_name : "(unnamed)");
+
+  portENTER_CRITICAL(&m_spinlock);
+  ++m_stats.timeouts;
+  portEXIT_CRITICAL(&m_spinlock);
 }
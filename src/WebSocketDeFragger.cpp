@@ -2,26 +2,19 @@
 
 #include "Logging.h"
 
+#include <algorithm>
 #include <cstring>
 
 const char* const TAG = "WebSocketDeFragger";
 
 using namespace OpenShock;
 
-std::uint8_t* _reallocOrFree(std::uint8_t* ptr, std::size_t size) {
-  void* newPtr = realloc(ptr, size);
-  if (newPtr == nullptr) {
-    free(ptr);
-    ESP_PANIC(TAG, "Failed to allocate memory");
-  }
-
-  return reinterpret_cast<std::uint8_t*>(newPtr);
-}
-
-WebSocketDeFragger::WebSocketDeFragger(EventCallback callback) : m_messages(), m_callback(callback) { }
+WebSocketDeFragger::WebSocketDeFragger(EventCallback callback, std::uint32_t maxMessageSize) : m_messages(), m_maxMessageSize(maxMessageSize), m_callback(callback) { }
 
 WebSocketDeFragger::~WebSocketDeFragger() {
-  clear();
+  for (auto& message : m_messages) {
+    free(message.data);
+  }
 }
 
 void WebSocketDeFragger::handler(std::uint8_t socketId, WStype_t type, const std::uint8_t* payload, std::size_t length) {
@@ -38,9 +31,15 @@ void WebSocketDeFragger::handler(std::uint8_t socketId, WStype_t type, const std
     case WStype_FRAGMENT_FIN:
       finish(socketId, payload, length);
       return;
-    [[likely]] default:
+    [[likely]] case WStype_BIN:
+    case WStype_TEXT:
+    case WStype_CONNECTED:
+    case WStype_DISCONNECTED:
+      // A new unfragmented message or a connection boundary ends any unfinished message, control frames may arrive between fragments and leave it alone
       clear(socketId);
       break;
+    default:
+      break;
   }
 
   WebSocketMessageType messageType;
@@ -72,6 +71,7 @@ void WebSocketDeFragger::handler(std::uint8_t socketId, WStype_t type, const std
       return;
   }
 
+  // Unfragmented messages are handed straight through without being copied
   m_callback(socketId, messageType, payload, length);
 }
 
@@ -80,55 +80,106 @@ void WebSocketDeFragger::onEvent(const EventCallback& callback) {
 }
 
 void WebSocketDeFragger::clear(std::uint8_t socketId) {
-  auto it = m_messages.find(socketId);
-  if (it != m_messages.end()) {
-    free(it->second.data);
-    m_messages.erase(it);
+  if (socketId >= kMaxSockets) {
+    return;
+  }
+
+  auto& message = m_messages[socketId];
+
+  message.active = false;
+  message.size   = 0;
+
+  if (message.capacity > kMaxRetainedCapacity) {
+    free(message.data);
+    message.data     = nullptr;
+    message.capacity = 0;
   }
 }
 
 void WebSocketDeFragger::clear() {
-  for (auto it = m_messages.begin(); it != m_messages.end(); ++it) {
-    free(it->second.data);
+  for (auto& message : m_messages) {
+    free(message.data);
+    message = {};
   }
-  m_messages.clear();
+}
+
+bool WebSocketDeFragger::reserve(Message& message, std::uint32_t size) {
+  if (message.capacity >= size) {
+    return true;
+  }
+
+  std::uint32_t capacity = std::max(message.capacity, kMinCapacity);
+  while (capacity < size) {
+    capacity *= 2;
+  }
+  capacity = std::min(capacity, m_maxMessageSize);
+
+  void* data = realloc(message.data, capacity);
+  if (data == nullptr) {
+    return false;  // Old buffer is still valid and owned by the message
+  }
+
+  message.data     = reinterpret_cast<std::uint8_t*>(data);
+  message.capacity = capacity;
+
+  return true;
+}
+
+void WebSocketDeFragger::reject(std::uint8_t socketId, const char* errorMessage) {
+  ESP_LOGE(TAG, "Dropping message from socket %u: %s", socketId, errorMessage);
+
+  clear(socketId);
+
+  m_callback(socketId, WebSocketMessageType::Error, reinterpret_cast<const std::uint8_t*>(errorMessage), strlen(errorMessage));
 }
 
 void WebSocketDeFragger::start(std::uint8_t socketId, WebSocketMessageType type, const std::uint8_t* data, std::uint32_t length) {
-  auto it = m_messages.find(socketId);
-  if (it != m_messages.end()) {
-    auto& message = it->second;
+  if (socketId >= kMaxSockets) {
+    ESP_LOGE(TAG, "Socket ID %u is out of range", socketId);
+    return;
+  }
 
-    if (message.capacity < length) {
-      message.data     = _reallocOrFree(message.data, length);
-      message.capacity = length;
-    }
+  auto& message = m_messages[socketId];
 
-    memcpy(message.data, data, length);
-    message.size = length;
+  // A new start discards any unfinished message on the same socket
+  message.active = false;
+  message.size   = 0;
 
+  if (length > m_maxMessageSize) {
+    reject(socketId, "Message too large");
     return;
   }
 
-  Message message {.data = reinterpret_cast<std::uint8_t*>(malloc(length)), .size = length, .capacity = length, .type = type};
+  if (!reserve(message, length)) {
+    reject(socketId, "Failed to allocate memory");
+    return;
+  }
 
   memcpy(message.data, data, length);
-
-  m_messages.insert(std::make_pair(socketId, message));
+  message.size   = length;
+  message.type   = type;
+  message.active = true;
 }
 
 void WebSocketDeFragger::append(std::uint8_t socketId, const std::uint8_t* data, std::uint32_t length) {
-  auto it = m_messages.find(socketId);
-  if (it == m_messages.end()) {
+  if (socketId >= kMaxSockets) {
     return;
   }
 
-  auto& message = it->second;
+  auto& message = m_messages[socketId];
+  if (!message.active) {
+    return;  // Rejected earlier, or no start was seen
+  }
+
+  if (length > m_maxMessageSize - message.size) {
+    reject(socketId, "Message too large");
+    return;
+  }
 
   std::uint32_t newLength = message.size + length;
-  if (message.capacity < newLength) {
-    message.data     = _reallocOrFree(message.data, newLength);
-    message.capacity = newLength;
+  if (!reserve(message, newLength)) {
+    reject(socketId, "Failed to allocate memory");
+    return;
   }
 
   memcpy(message.data + message.size, data, length);
@@ -136,24 +187,18 @@ void WebSocketDeFragger::append(std::uint8_t socketId, const std::uint8_t* data,
 }
 
 void WebSocketDeFragger::finish(std::uint8_t socketId, const std::uint8_t* data, std::uint32_t length) {
-  auto it = m_messages.find(socketId);
-  if (it == m_messages.end()) {
+  append(socketId, data, length);
+
+  if (socketId >= kMaxSockets) {
     return;
   }
 
-  auto& message = it->second;
-
-  std::uint32_t newLength = message.size + length;
-  if (message.capacity < newLength) {
-    message.data     = _reallocOrFree(message.data, newLength);
-    message.capacity = newLength;
+  auto& message = m_messages[socketId];
+  if (!message.active) {
+    return;
   }
 
-  memcpy(message.data + message.size, data, length);
-  message.size = newLength;
-
   m_callback(socketId, message.type, message.data, message.size);
 
-  free(message.data);
-  m_messages.erase(it);
+  clear(socketId);
 }
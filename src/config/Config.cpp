@@ -1,34 +1,119 @@
 #include "config/Config.h"
 
 #include "Common.h"
+#include "config/internal/RawPartition.h"
+#include "config/internal/SectionStore.h"
 #include "config/RootConfig.h"
 #include "Logging.h"
 #include "ReadWriteMutex.h"
+#include "util/TaskUtils.h"
 
 #include <FS.h>
 #include <LittleFS.h>
 
+#include <esp_system.h>
+#include <esp_timer.h>
+
 #include <cJSON.h>
 
+#include <algorithm>
+#include <atomic>
 #include <bitset>
+#include <memory>
 
 const char* const TAG = "Config";
 
+// Single-file format written by older firmware, only read to migrate it into sections
+const char* const CONFIG_PATH      = "/config";
+const char* const CONFIG_TEMP_PATH = "/config.tmp";
+
+const std::uint32_t CONFIG_SAVE_DEBOUNCE_MS  = 500;   // Setters must be quiet this long before the config is written
+const std::uint32_t CONFIG_SAVE_MAX_DELAY_MS = 5000;  // A steady stream of setters can not hold off a write longer than this
+const std::uint32_t CONFIG_SHUTDOWN_FLUSH_MS = 1000;
+
 using namespace OpenShock;
 
-static fs::LittleFSFS _configFS;
-static Config::RootConfig _configData;
-static ReadWriteMutex _configMutex;
+using Config::Internal::SectionStore::Section;
+using Config::Internal::SectionStore::SectionBit;
 
-#define CONFIG_LOCK_READ_ACTION(retval, action)   \
-  ScopedReadLock lock__(&_configMutex);           \
-  if (!lock__.isLocked()) {                       \
-    ESP_LOGE(TAG, "Failed to acquire read lock"); \
-    action;                                       \
-    return retval;                                \
-  }
+const std::uint8_t ALL_SECTIONS = Config::Internal::SectionStore::kAllSections;
 
+static fs::LittleFSFS _configFS;
+static Config::RootConfig _configData;  // Working copy, only touched by writers under the write lock
+static ReadWriteMutex _configMutex("Config");
+
+// Immutable copy of _configData published after every change. The spinlock only guards copying the pointer,
+// which is the reference count increment, so readers never wait on a writer and never touch a FreeRTOS semaphore
+static portMUX_TYPE s_snapshotSpinlock = portMUX_INITIALIZER_UNLOCKED;
+static std::shared_ptr<const Config::RootConfig> s_snapshot;
+
+// Sections changed since the last save, only set under the write lock and only cleared under the save mutex
+static std::atomic<std::uint8_t> s_dirtySections {0};
+static std::atomic<TickType_t> s_firstDirtyTick {0};
+static std::atomic<TickType_t> s_lastDirtyTick {0};
+static SemaphoreHandle_t s_saveMutex = xSemaphoreCreateMutex();  // Serializes file writes, always taken before _configMutex
+static TaskHandle_t s_saveTaskHandle = nullptr;
+
+static std::atomic<std::uint32_t> s_changes {0};
+static std::atomic<std::uint32_t> s_flashWrites {0};
+static std::atomic<std::uint32_t> s_sectionsWritten {0};
+static std::atomic<std::uint32_t> s_writeFailures {0};
+static std::atomic<std::uint32_t> s_lastWriteUs {0};
+static std::atomic<std::uint32_t> s_maxWriteUs {0};
+static std::atomic<std::uint32_t> s_lastSetterUs {0};
+static std::atomic<std::uint32_t> s_maxSetterUs {0};
+
+void _recordDuration(std::atomic<std::uint32_t>& last, std::atomic<std::uint32_t>& max, std::int64_t durationUs) {
+  std::uint32_t duration = static_cast<std::uint32_t>(durationUs);
+
+  last.store(duration, std::memory_order_relaxed);
+
+  std::uint32_t prev = max.load(std::memory_order_relaxed);
+  while (duration > prev && !max.compare_exchange_weak(prev, duration, std::memory_order_relaxed)) { }
+}
+
+std::shared_ptr<const Config::RootConfig> _getSnapshot() {
+  portENTER_CRITICAL(&s_snapshotSpinlock);
+  std::shared_ptr<const Config::RootConfig> snapshot = s_snapshot;
+  portEXIT_CRITICAL(&s_snapshotSpinlock);
+
+  return snapshot;
+}
+/// @note Must be called with the write lock held
+/// @note Deep-copies the whole RootConfig, the credentials vector and every string, on every setter. test/test_config_snapshot measures what that buys readers
+void _publishSnapshot() {
+  // Copy outside of the spinlock, interrupts are masked while it is held
+  std::shared_ptr<const Config::RootConfig> snapshot = std::make_shared<const Config::RootConfig>(_configData);
+
+  portENTER_CRITICAL(&s_snapshotSpinlock);
+  s_snapshot.swap(snapshot);
+  portEXIT_CRITICAL(&s_snapshotSpinlock);
+
+  // The previous snapshot is released here, or by whichever reader still holds it
+}
+
+/// @brief Measures how long a setter spends waiting for the write lock and changing the config
+class SetterTimer {
+public:
+  SetterTimer() : m_startUs(esp_timer_get_time()) { }
+  ~SetterTimer() { _recordDuration(s_lastSetterUs, s_maxSetterUs, esp_timer_get_time() - m_startUs); }
+
+private:
+  std::int64_t m_startUs;
+};
+
+// Readers take the latest snapshot instead of a lock, config stays valid for as long as the function holds it
+#define CONFIG_SNAPSHOT(retval)                                          \
+  std::shared_ptr<const Config::RootConfig> snapshot__ = _getSnapshot(); \
+  if (snapshot__ == nullptr) {                                           \
+    ESP_LOGE(TAG, "Config has not been loaded");                         \
+    return retval;                                                       \
+  }                                                                      \
+  const Config::RootConfig& config = *snapshot__
+
+// The timer is declared before the lock so the recorded latency includes releasing it
 #define CONFIG_LOCK_WRITE_ACTION(retval, action)   \
+  SetterTimer timer__;                             \
   ScopedWriteLock lock__(&_configMutex);           \
   if (!lock__.isLocked()) {                        \
     ESP_LOGE(TAG, "Failed to acquire write lock"); \
@@ -36,7 +121,6 @@ static ReadWriteMutex _configMutex;
     return retval;                                 \
   }
 
-#define CONFIG_LOCK_READ(retval) CONFIG_LOCK_READ_ACTION(retval, {})
 #define CONFIG_LOCK_WRITE(retval) CONFIG_LOCK_WRITE_ACTION(retval, {})
 
 bool _tryDeserializeConfig(const std::uint8_t* buffer, std::size_t bufferLen, OpenShock::Config::RootConfig& config) {
@@ -70,8 +154,8 @@ bool _tryDeserializeConfig(const std::uint8_t* buffer, std::size_t bufferLen, Op
 
   return true;
 }
-bool _tryLoadConfig(std::vector<std::uint8_t>& buffer) {
-  File file = _configFS.open("/config", "rb");
+bool _tryLoadConfig(const char* path, std::vector<std::uint8_t>& buffer) {
+  File file = _configFS.open(path, "rb");
   if (!file) {
     ESP_LOGE(TAG, "Failed to open config file for reading");
     return false;
@@ -93,65 +177,251 @@ bool _tryLoadConfig(std::vector<std::uint8_t>& buffer) {
 
   return true;
 }
-bool _tryLoadConfig() {
+bool _tryLoadConfig(const char* path) {
   std::vector<std::uint8_t> buffer;
-  if (!_tryLoadConfig(buffer)) {
+  if (!_tryLoadConfig(path, buffer)) {
     return false;
   }
 
   return _tryDeserializeConfig(buffer.data(), buffer.size(), _configData);
 }
-bool _trySaveConfig(const std::uint8_t* data, std::size_t dataLen) {
-  File file = _configFS.open("/config", "wb");
-  if (!file) {
-    ESP_LOGE(TAG, "Failed to open config file for writing");
+bool _tryLoadConfig() {
+  // A temp file is only left behind if power was lost between closing it and renaming it over the config, in which case it holds the newest config
+  if (_configFS.exists(CONFIG_TEMP_PATH)) {
+    if (_tryLoadConfig(CONFIG_TEMP_PATH) && _configFS.rename(CONFIG_TEMP_PATH, CONFIG_PATH)) {
+      ESP_LOGW(TAG, "Recovered config from interrupted write");
+      return true;
+    }
+
+    ESP_LOGW(TAG, "Discarding incomplete config write");
+    _configFS.remove(CONFIG_TEMP_PATH);
+  }
+
+  return _tryLoadConfig(CONFIG_PATH);
+}
+bool _tryLoadRawConfig() {
+  const std::uint8_t* data;
+  std::uint32_t size;
+  if (!Config::Internal::RawPartition::GetLatest(data, size)) {
     return false;
   }
 
-  // Write file
-  if (file.write(data, dataLen) != dataLen) {
-    ESP_LOGE(TAG, "Failed to write config file");
+  // Verified straight from mapped flash without reading it into a buffer first, the fields are still copied into _configData like any other load
+  return _tryDeserializeConfig(data, size, _configData);
+}
+/// @brief Writes the given sections to whichever storage the board uses
+/// @param failed Bits of the sections that are still unsaved
+bool _trySaveConfig(const Config::RootConfig& config, std::uint8_t sections, std::uint8_t& failed) {
+  std::int64_t startUs = esp_timer_get_time();
+
+  bool result;
+  if (Config::Internal::RawPartition::IsAvailable()) {
+    // The raw partition holds a single blob, so any change rewrites all of it instead of just the dirty sections like on LittleFS.
+    // That costs more erases per save, boards opt into the partition for the faster boot and take that wear on its two slots.
+    flatbuffers::FlatBufferBuilder builder;
+    builder.Finish(config.ToFlatbuffers(builder, true));
+
+    result = Config::Internal::RawPartition::Write(builder.GetBufferPointer(), builder.GetSize());
+    failed = result ? 0 : sections;
+
+    s_sectionsWritten += result ? Config::Internal::SectionStore::kSectionCount : 0;
+  } else {
+    result = Config::Internal::SectionStore::Save(_configFS, config, sections, failed);
+
+    s_sectionsWritten += std::bitset<8>(sections & ~failed).count();
+  }
+
+  if (!result) {
+    ++s_writeFailures;
     return false;
   }
 
-  file.close();
+  ++s_flashWrites;
+  _recordDuration(s_lastWriteUs, s_maxWriteUs, esp_timer_get_time() - startUs);
 
   return true;
 }
-bool _trySaveConfig() {
-  flatbuffers::FlatBufferBuilder builder;
+/// @brief Marks sections of the config as changed, the save task writes it once setters have been quiet for the debounce window
+/// @note Must be called with the write lock held
+bool _markDirty(std::uint8_t sections) {
+  // Publish before marking dirty, so a save that clears the bits always sees this change in the snapshot it serializes
+  _publishSnapshot();
+
+  TickType_t now = xTaskGetTickCount();
+
+  if (s_dirtySections.load() == 0) {
+    s_firstDirtyTick = now;
+  }
+  s_lastDirtyTick = now;
+  s_dirtySections |= sections;
 
-  auto fbsConfig = _configData.ToFlatbuffers(builder, true);
+  ++s_changes;
 
-  builder.Finish(fbsConfig);
+  if (s_saveTaskHandle != nullptr) {
+    xTaskNotifyGive(s_saveTaskHandle);
+  }
 
-  return _trySaveConfig(builder.GetBufferPointer(), builder.GetSize());
+  return true;
 }
+bool _flushConfig(TickType_t xTicksToWait) {
+  // Taken before looking at the dirty bits, the save task clears them before its write lands, so an empty set alone does not mean it is on flash
+  if (xSemaphoreTake(s_saveMutex, xTicksToWait) != pdTRUE) {
+    ESP_LOGE(TAG, "Failed to acquire save mutex");
+    return false;
+  }
 
-void Config::Init() {
-  CONFIG_LOCK_WRITE();
+  std::uint8_t sections = s_dirtySections.exchange(0);
+  if (sections == 0) {
+    xSemaphoreGive(s_saveMutex);
+    return true;
+  }
+
+  // Serialized from the snapshot, setters are not blocked while the config is written to flash
+  std::shared_ptr<const Config::RootConfig> snapshot = _getSnapshot();
+
+  std::uint8_t failed;
+  bool result = _trySaveConfig(*snapshot, sections, failed);
+  if (!result) {
+    // Leave it to the save task to retry
+    s_dirtySections |= failed;
+  }
+
+  xSemaphoreGive(s_saveMutex);
+
+  return result;
+}
+void _configSaveTask(void*) {
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+    // Wait until setters have been quiet for the debounce window, or the first change has waited long enough
+    while (s_dirtySections.load() != 0) {
+      TickType_t now      = xTaskGetTickCount();
+      TickType_t quiet    = now - s_lastDirtyTick.load();
+      TickType_t pending  = now - s_firstDirtyTick.load();
+      TickType_t debounce = pdMS_TO_TICKS(CONFIG_SAVE_DEBOUNCE_MS);
+      TickType_t maxDelay = pdMS_TO_TICKS(CONFIG_SAVE_MAX_DELAY_MS);
+      if (quiet >= debounce || pending >= maxDelay) {
+        break;
+      }
+
+      ulTaskNotifyTake(pdTRUE, std::min(debounce - quiet, maxDelay - pending));
+    }
+
+    if (!_flushConfig(portMAX_DELAY)) {
+      // Back off instead of hammering a failing flash, the next change or Flush tries again
+      ESP_LOGE(TAG, "Failed to save config");
+      vTaskDelay(pdMS_TO_TICKS(CONFIG_SAVE_MAX_DELAY_MS));
+      if (s_dirtySections.load() != 0) {
+        xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+      }
+    }
+  }
+}
+void _flushConfigOnShutdown() {
+  // Runs inside esp_restart, so every ESP.restart() after a setter still persists it. Bounded, the restarting task may hold the write lock
+  if (!_flushConfig(pdMS_TO_TICKS(CONFIG_SHUTDOWN_FLUSH_MS))) {
+    ESP_LOGE(TAG, "Failed to save config before restart");
+  }
+}
+
+void _loadConfig() {
+  // Not a setter, so the lock is taken directly to keep mount time out of the setter latency
+  ScopedWriteLock lock(&_configMutex);
+  if (!lock.isLocked()) {
+    ESP_PANIC(TAG, "Failed to acquire write lock");
+  }
+
+  // Boards with a raw config partition read the config from mapped flash, and only mount LittleFS once to migrate from it
+  bool rawPartition = Config::Internal::RawPartition::Init();
+  if (rawPartition) {
+    if (_tryLoadRawConfig()) {
+      _publishSnapshot();
+      return;
+    }
+
+    ESP_LOGW(TAG, "Raw config partition holds no config, migrating from LittleFS");
+  }
 
   if (!_configFS.begin(true, "/config", 3, "config")) {
     ESP_PANIC(TAG, "Unable to mount config LittleFS partition!");
   }
 
-  if (_tryLoadConfig()) {
-    return;
+  // The single-file format is only removed once every section has been written, so if it is still there it is the newest config
+  bool singleFile = _configFS.exists(CONFIG_PATH) || _configFS.exists(CONFIG_TEMP_PATH);
+  bool loaded     = true;
+
+  std::uint8_t unsaved = 0;
+  if (singleFile && _tryLoadConfig()) {
+    ESP_LOGI(TAG, "Migrating config to per-section files");
+    unsaved = ALL_SECTIONS;
+  } else if (Config::Internal::SectionStore::Exists(_configFS)) {
+    Config::Internal::SectionStore::Load(_configFS, _configData, unsaved);
+  } else {
+    ESP_LOGW(TAG, "Failed to load config, writing default config");
+    _configData.ToDefault();
+    unsaved = ALL_SECTIONS;
+    loaded  = false;
   }
 
-  ESP_LOGW(TAG, "Failed to load config, writing default config");
+  if (rawPartition) {
+    unsaved = ALL_SECTIONS;
+  }
 
-  _configData.ToDefault();
+  std::uint8_t failed = 0;
+  if (unsaved != 0 && !_trySaveConfig(_configData, unsaved, failed)) {
+    if (!loaded) {
+      ESP_PANIC(TAG, "Failed to save default config. Recommend formatting microcontroller and re-flashing firmware");
+    }
 
-  if (!_trySaveConfig()) {
-    ESP_PANIC(TAG, "Failed to save default config. Recommend formatting microcontroller and re-flashing firmware");
+    ESP_LOGE(TAG, "Failed to migrate config, it will be retried on the next boot");
+  }
+
+  if (singleFile && failed == 0) {
+    _configFS.remove(CONFIG_PATH);
+    _configFS.remove(CONFIG_TEMP_PATH);
+  }
+
+  _publishSnapshot();
+}
+
+void Config::Init() {
+  _loadConfig();
+
+  if (TaskUtils::TaskCreateExpensive(_configSaveTask, "ConfigSave", 4096, nullptr, 1, &s_saveTaskHandle) != pdPASS) {
+    ESP_PANIC(TAG, "Failed to create config save task");
+  }
+
+  if (esp_register_shutdown_handler(_flushConfigOnShutdown) != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to register config shutdown handler");
   }
 }
 
+bool Config::Flush() {
+  return _flushConfig(portMAX_DELAY);
+}
+
+void Config::GetPersistStats(Config::PersistStats& out) {
+  out = {
+    .changes         = s_changes.load(),
+    .flashWrites     = s_flashWrites.load(),
+    .sectionsWritten = s_sectionsWritten.load(),
+    .writeFailures   = s_writeFailures.load(),
+    .lastWriteUs     = s_lastWriteUs.load(),
+    .maxWriteUs      = s_maxWriteUs.load(),
+    .lastSetterUs    = s_lastSetterUs.load(),
+    .maxSetterUs     = s_maxSetterUs.load(),
+  };
+}
+
+std::shared_ptr<const Config::RootConfig> Config::GetSnapshot() {
+  return _getSnapshot();
+}
+
 cJSON* _getAsCJSON(bool withSensitiveData) {
-  CONFIG_LOCK_READ(nullptr);
+  CONFIG_SNAPSHOT(nullptr);
 
-  return _configData.ToJSON(withSensitiveData);
+  return config.ToJSON(withSensitiveData);
 }
 
 std::string Config::GetAsJSON(bool withSensitiveData) {
@@ -185,13 +455,13 @@ bool Config::SaveFromJSON(StringView json) {
     return false;
   }
 
-  return _trySaveConfig();
+  return _markDirty(ALL_SECTIONS);
 }
 
 flatbuffers::Offset<Serialization::Configuration::HubConfig> Config::GetAsFlatBuffer(flatbuffers::FlatBufferBuilder& builder, bool withSensitiveData) {
-  CONFIG_LOCK_READ(0);
+  CONFIG_SNAPSHOT(0);
 
-  return _configData.ToFlatbuffers(builder, withSensitiveData);
+  return config.ToFlatbuffers(builder, withSensitiveData);
 }
 
 bool Config::SaveFromFlatBuffer(const Serialization::Configuration::HubConfig* config) {
@@ -202,37 +472,53 @@ bool Config::SaveFromFlatBuffer(const Serialization::Configuration::HubConfig* c
     return false;
   }
 
-  return _trySaveConfig();
+  return _markDirty(ALL_SECTIONS);
 }
 
 bool Config::GetRaw(std::vector<std::uint8_t>& buffer) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
+
+  // Serialized from memory, the file may not have caught up with the latest setters yet
+  flatbuffers::FlatBufferBuilder builder;
+  builder.Finish(config.ToFlatbuffers(builder, true));
+
+  buffer.assign(builder.GetBufferPointer(), builder.GetBufferPointer() + builder.GetSize());
 
-  return _tryLoadConfig(buffer);
+  return true;
 }
 
-bool Config::SetRaw(const std::uint8_t* buffer, std::size_t size) {
+bool _replaceConfig(const OpenShock::Config::RootConfig& config) {
   CONFIG_LOCK_WRITE(false);
 
+  _configData = config;
+  return _markDirty(ALL_SECTIONS);
+}
+
+bool Config::SetRaw(const std::uint8_t* buffer, std::size_t size) {
   OpenShock::Config::RootConfig config;
   if (!_tryDeserializeConfig(buffer, size, config)) {
     ESP_LOGE(TAG, "Failed to deserialize config");
     return false;
   }
 
-  return _trySaveConfig(buffer, size);
+  if (!_replaceConfig(config)) {
+    return false;
+  }
+
+  return Config::Flush();
 }
 
-void Config::FactoryReset() {
+void _resetConfig() {
   CONFIG_LOCK_WRITE();
 
   _configData.ToDefault();
+  _markDirty(ALL_SECTIONS);
+}
 
-  if (!_configFS.remove("/config") && _configFS.exists("/config")) {
-    ESP_PANIC(TAG, "Failed to remove existing config file for factory reset. Reccomend formatting microcontroller and re-flashing firmware");
-  }
+void Config::FactoryReset() {
+  _resetConfig();
 
-  if (!_trySaveConfig()) {
+  if (!Config::Flush()) {
     ESP_PANIC(TAG, "Failed to save default config. Recommend formatting microcontroller and re-flashing firmware");
   }
 
@@ -240,33 +526,33 @@ void Config::FactoryReset() {
 }
 
 bool Config::GetRFConfig(Config::RFConfig& out) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  out = _configData.rf;
+  out = config.rf;
 
   return true;
 }
 
 bool Config::GetWiFiConfig(Config::WiFiConfig& out) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  out = _configData.wifi;
+  out = config.wifi;
 
   return true;
 }
 
 bool Config::GetOtaUpdateConfig(Config::OtaUpdateConfig& out) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  out = _configData.otaUpdate;
+  out = config.otaUpdate;
 
   return true;
 }
 
 bool Config::GetWiFiCredentials(cJSON* array, bool withSensitiveData) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  for (auto& creds : _configData.wifi.credentialsList) {
+  for (const auto& creds : config.wifi.credentialsList) {
     cJSON* jsonCreds = creds.ToJSON(withSensitiveData);
 
     cJSON_AddItemToArray(array, jsonCreds);
@@ -276,9 +562,9 @@ bool Config::GetWiFiCredentials(cJSON* array, bool withSensitiveData) {
 }
 
 bool Config::GetWiFiCredentials(std::vector<Config::WiFiCredentials>& out) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  out = _configData.wifi.credentialsList;
+  out = config.wifi.credentialsList;
 
   return true;
 }
@@ -287,14 +573,14 @@ bool Config::SetRFConfig(const Config::RFConfig& config) {
   CONFIG_LOCK_WRITE(false);
 
   _configData.rf = config;
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::RF));
 }
 
 bool Config::SetWiFiConfig(const Config::WiFiConfig& config) {
   CONFIG_LOCK_WRITE(false);
 
   _configData.wifi = config;
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::WiFi));
 }
 
 bool Config::SetWiFiCredentials(const std::vector<Config::WiFiCredentials>& credentials) {
@@ -307,27 +593,27 @@ bool Config::SetWiFiCredentials(const std::vector<Config::WiFiCredentials>& cred
   CONFIG_LOCK_WRITE(false);
 
   _configData.wifi.credentialsList = credentials;
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::WiFi));
 }
 
 bool Config::SetCaptivePortalConfig(const Config::CaptivePortalConfig& config) {
   CONFIG_LOCK_WRITE(false);
 
   _configData.captivePortal = config;
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::CaptivePortal));
 }
 
 bool Config::SetSerialInputConfig(const Config::SerialInputConfig& config) {
   CONFIG_LOCK_WRITE(false);
 
   _configData.serialInput = config;
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::SerialInput));
 }
 
 bool Config::GetSerialInputConfigEchoEnabled(bool& out) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  out = _configData.serialInput.echoEnabled;
+  out = config.serialInput.echoEnabled;
   return true;
 }
 
@@ -335,20 +621,20 @@ bool Config::SetSerialInputConfigEchoEnabled(bool enabled) {
   CONFIG_LOCK_WRITE(false);
 
   _configData.serialInput.echoEnabled = enabled;
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::SerialInput));
 }
 
 bool Config::SetBackendConfig(const Config::BackendConfig& config) {
   CONFIG_LOCK_WRITE(false);
 
   _configData.backend = config;
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::Backend));
 }
 
 bool Config::GetRFConfigTxPin(std::uint8_t& out) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  out = _configData.rf.txPin;
+  out = config.rf.txPin;
 
   return true;
 }
@@ -357,13 +643,13 @@ bool Config::SetRFConfigTxPin(std::uint8_t txPin) {
   CONFIG_LOCK_WRITE(false);
 
   _configData.rf.txPin = txPin;
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::RF));
 }
 
 bool Config::GetRFConfigKeepAliveEnabled(bool& out) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  out = _configData.rf.keepAliveEnabled;
+  out = config.rf.keepAliveEnabled;
 
   return true;
 }
@@ -372,13 +658,13 @@ bool Config::SetRFConfigKeepAliveEnabled(bool enabled) {
   CONFIG_LOCK_WRITE(false);
 
   _configData.rf.keepAliveEnabled = enabled;
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::RF));
 }
 
 bool Config::AnyWiFiCredentials(std::function<bool(const Config::WiFiCredentials&)> predicate) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  auto& creds = _configData.wifi.credentialsList;
+  const auto& creds = config.wifi.credentialsList;
 
   return std::any_of(creds.begin(), creds.end(), predicate);
 }
@@ -428,15 +714,15 @@ std::uint8_t Config::AddWiFiCredentials(StringView ssid, StringView password) {
     .ssid     = ssid.toString(),
     .password = password.toString(),
   });
-  _trySaveConfig();
+  _markDirty(SectionBit(Section::WiFi));
 
   return id;
 }
 
 bool Config::TryGetWiFiCredentialsByID(std::uint8_t id, Config::WiFiCredentials& credentials) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  for (const auto& creds : _configData.wifi.credentialsList) {
+  for (const auto& creds : config.wifi.credentialsList) {
     if (creds.id == id) {
       credentials = creds;
       return true;
@@ -447,9 +733,9 @@ bool Config::TryGetWiFiCredentialsByID(std::uint8_t id, Config::WiFiCredentials&
 }
 
 bool Config::TryGetWiFiCredentialsBySSID(const char* ssid, Config::WiFiCredentials& credentials) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  for (const auto& creds : _configData.wifi.credentialsList) {
+  for (const auto& creds : config.wifi.credentialsList) {
     if (creds.ssid == ssid) {
       credentials = creds;
       return true;
@@ -460,9 +746,9 @@ bool Config::TryGetWiFiCredentialsBySSID(const char* ssid, Config::WiFiCredentia
 }
 
 std::uint8_t Config::GetWiFiCredentialsIDbySSID(const char* ssid) {
-  CONFIG_LOCK_READ(0);
+  CONFIG_SNAPSHOT(0);
 
-  for (const auto& creds : _configData.wifi.credentialsList) {
+  for (const auto& creds : config.wifi.credentialsList) {
     if (creds.ssid == ssid) {
       return creds.id;
     }
@@ -477,7 +763,7 @@ bool Config::RemoveWiFiCredentials(std::uint8_t id) {
   for (auto it = _configData.wifi.credentialsList.begin(); it != _configData.wifi.credentialsList.end(); ++it) {
     if (it->id == id) {
       _configData.wifi.credentialsList.erase(it);
-      _trySaveConfig();
+      _markDirty(SectionBit(Section::WiFi));
       return true;
     }
   }
@@ -490,13 +776,13 @@ bool Config::ClearWiFiCredentials() {
 
   _configData.wifi.credentialsList.clear();
 
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::WiFi));
 }
 
 bool Config::GetOtaUpdateId(std::int32_t& out) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  out = _configData.otaUpdate.updateId;
+  out = config.otaUpdate.updateId;
 
   return true;
 }
@@ -509,13 +795,13 @@ bool Config::SetOtaUpdateId(std::int32_t updateId) {
   }
 
   _configData.otaUpdate.updateId = updateId;
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::OtaUpdate));
 }
 
 bool Config::GetOtaUpdateStep(OtaUpdateStep& out) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  out = _configData.otaUpdate.updateStep;
+  out = config.otaUpdate.updateStep;
 
   return true;
 }
@@ -528,13 +814,13 @@ bool Config::SetOtaUpdateStep(OtaUpdateStep updateStep) {
   }
 
   _configData.otaUpdate.updateStep = updateStep;
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::OtaUpdate));
 }
 
 bool Config::GetBackendDomain(std::string& out) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  out = _configData.backend.domain;
+  out = config.backend.domain;
 
   return true;
 }
@@ -543,19 +829,19 @@ bool Config::SetBackendDomain(StringView domain) {
   CONFIG_LOCK_WRITE(false);
 
   _configData.backend.domain = domain.toString();
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::Backend));
 }
 
 bool Config::HasBackendAuthToken() {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  return !_configData.backend.authToken.empty();
+  return !config.backend.authToken.empty();
 }
 
 bool Config::GetBackendAuthToken(std::string& out) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  out = _configData.backend.authToken;
+  out = config.backend.authToken;
 
   return true;
 }
@@ -564,26 +850,26 @@ bool Config::SetBackendAuthToken(StringView token) {
   CONFIG_LOCK_WRITE(false);
 
   _configData.backend.authToken = token.toString();
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::Backend));
 }
 
 bool Config::ClearBackendAuthToken() {
   CONFIG_LOCK_WRITE(false);
 
   _configData.backend.authToken.clear();
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::Backend));
 }
 
 bool Config::HasBackendLCGOverride() {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  return !_configData.backend.lcgOverride.empty();
+  return !config.backend.lcgOverride.empty();
 }
 
 bool Config::GetBackendLCGOverride(std::string& out) {
-  CONFIG_LOCK_READ(false);
+  CONFIG_SNAPSHOT(false);
 
-  out = _configData.backend.lcgOverride;
+  out = config.backend.lcgOverride;
 
   return true;
 }
@@ -592,12 +878,12 @@ bool Config::SetBackendLCGOverride(StringView lcgOverride) {
   CONFIG_LOCK_WRITE(false);
 
   _configData.backend.lcgOverride = lcgOverride.toString();
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::Backend));
 }
 
 bool Config::ClearBackendLCGOverride() {
   CONFIG_LOCK_WRITE(false);
 
   _configData.backend.lcgOverride.clear();
-  return _trySaveConfig();
+  return _markDirty(SectionBit(Section::Backend));
 }
@@ -8,13 +8,14 @@ const char* const TAG = "Config::RFConfig";
 
 using namespace OpenShock::Config;
 
-RFConfig::RFConfig() : txPin(OPENSHOCK_RF_TX_GPIO), keepAliveEnabled(true) { }
+RFConfig::RFConfig() : txPin(OPENSHOCK_RF_TX_GPIO), keepAliveEnabled(true), transmitters() { }
 
-RFConfig::RFConfig(std::uint8_t txPin, bool keepAliveEnabled) : txPin(txPin), keepAliveEnabled(keepAliveEnabled) { }
+RFConfig::RFConfig(std::uint8_t txPin, bool keepAliveEnabled, const std::vector<RFTransmitterConfig>& transmitters) : txPin(txPin), keepAliveEnabled(keepAliveEnabled), transmitters(transmitters) { }
 
 void RFConfig::ToDefault() {
   txPin            = OPENSHOCK_RF_TX_GPIO;
   keepAliveEnabled = true;
+  transmitters.clear();
 }
 
 bool RFConfig::FromFlatbuffers(const Serialization::Configuration::RFConfig* config) {
@@ -25,12 +26,20 @@ bool RFConfig::FromFlatbuffers(const Serialization::Configuration::RFConfig* con
 
   txPin            = config->tx_pin();
   keepAliveEnabled = config->keepalive_enabled();
+  Internal::Utils::FromFbsVec(transmitters, config->transmitters());
 
   return true;
 }
 
 flatbuffers::Offset<OpenShock::Serialization::Configuration::RFConfig> RFConfig::ToFlatbuffers(flatbuffers::FlatBufferBuilder& builder, bool withSensitiveData) const {
-  return Serialization::Configuration::CreateRFConfig(builder, txPin, keepAliveEnabled);
+  std::vector<flatbuffers::Offset<OpenShock::Serialization::Configuration::RFTransmitterConfig>> fbsTransmitters;
+  fbsTransmitters.reserve(transmitters.size());
+
+  for (auto& transmitter : transmitters) {
+    fbsTransmitters.emplace_back(transmitter.ToFlatbuffers(builder, withSensitiveData));
+  }
+
+  return Serialization::Configuration::CreateRFConfig(builder, txPin, keepAliveEnabled, builder.CreateVector(fbsTransmitters));
 }
 
 bool RFConfig::FromJSON(const cJSON* json) {
@@ -47,6 +56,15 @@ bool RFConfig::FromJSON(const cJSON* json) {
   Internal::Utils::FromJsonU8(txPin, json, "txPin", OPENSHOCK_RF_TX_GPIO);
   Internal::Utils::FromJsonBool(keepAliveEnabled, json, "keepAliveEnabled", true);
 
+  // Optional, older configs only have a single transmitter
+  const cJSON* transmittersJson = cJSON_GetObjectItemCaseSensitive(json, "transmitters");
+  if (transmittersJson != nullptr && cJSON_IsArray(transmittersJson) == 0) {
+    ESP_LOGE(TAG, "transmitters is not an array");
+    return false;
+  }
+
+  Internal::Utils::FromJsonArray(transmitters, transmittersJson);
+
   return true;
 }
 
@@ -56,5 +74,13 @@ cJSON* RFConfig::ToJSON(bool withSensitiveData) const {
   cJSON_AddNumberToObject(root, "txPin", txPin);  //-V2564
   cJSON_AddBoolToObject(root, "keepAliveEnabled", keepAliveEnabled);
 
+  cJSON* transmittersJson = cJSON_CreateArray();
+
+  for (auto& transmitter : transmitters) {
+    cJSON_AddItemToArray(transmittersJson, transmitter.ToJSON(withSensitiveData));
+  }
+
+  cJSON_AddItemToObject(root, "transmitters", transmittersJson);
+
   return root;
 }
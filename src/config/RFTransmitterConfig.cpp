@@ -0,0 +1,101 @@
+#include "config/RFTransmitterConfig.h"
+
+#include "config/internal/utils.h"
+#include "Common.h"
+#include "Logging.h"
+
+const char* const TAG = "Config::RFTransmitterConfig";
+
+using namespace OpenShock::Config;
+
+RFTransmitterConfig::RFTransmitterConfig() : txPin(OPENSHOCK_GPIO_INVALID), coreId(-1), shockerIds() { }
+
+RFTransmitterConfig::RFTransmitterConfig(std::uint8_t txPin, std::int8_t coreId, const std::vector<std::uint16_t>& shockerIds) : txPin(txPin), coreId(coreId), shockerIds(shockerIds) { }
+
+void RFTransmitterConfig::ToDefault() {
+  txPin  = OPENSHOCK_GPIO_INVALID;
+  coreId = -1;
+  shockerIds.clear();
+}
+
+bool RFTransmitterConfig::FromFlatbuffers(const Serialization::Configuration::RFTransmitterConfig* config) {
+  if (config == nullptr) {
+    ESP_LOGE(TAG, "config is null");
+    return false;
+  }
+
+  txPin  = config->tx_pin();
+  coreId = config->core_id();
+
+  shockerIds.clear();
+
+  auto fbsShockerIds = config->shocker_ids();
+  if (fbsShockerIds != nullptr) {
+    shockerIds.assign(fbsShockerIds->begin(), fbsShockerIds->end());
+  }
+
+  return true;
+}
+
+flatbuffers::Offset<OpenShock::Serialization::Configuration::RFTransmitterConfig> RFTransmitterConfig::ToFlatbuffers(flatbuffers::FlatBufferBuilder& builder, bool withSensitiveData) const {
+  return Serialization::Configuration::CreateRFTransmitterConfig(builder, txPin, coreId, builder.CreateVector(shockerIds));
+}
+
+bool RFTransmitterConfig::FromJSON(const cJSON* json) {
+  if (json == nullptr) {
+    ESP_LOGE(TAG, "json is null");
+    return false;
+  }
+
+  if (cJSON_IsObject(json) == 0) {
+    ESP_LOGE(TAG, "json is not an object");
+    return false;
+  }
+
+  Internal::Utils::FromJsonU8(txPin, json, "txPin", OPENSHOCK_GPIO_INVALID);
+
+  std::int32_t core = -1;
+  Internal::Utils::FromJsonI32(core, json, "coreId", -1);
+  coreId = static_cast<std::int8_t>(core);
+
+  shockerIds.clear();
+
+  const cJSON* shockerIdsJson = cJSON_GetObjectItemCaseSensitive(json, "shockerIds");
+  if (shockerIdsJson == nullptr) {
+    return true;
+  }
+
+  if (cJSON_IsArray(shockerIdsJson) == 0) {
+    ESP_LOGE(TAG, "shockerIds is not an array");
+    return false;
+  }
+
+  const cJSON* shockerIdJson = nullptr;
+  cJSON_ArrayForEach(shockerIdJson, shockerIdsJson) {
+    if (cJSON_IsNumber(shockerIdJson) == 0 || shockerIdJson->valueint < 0 || shockerIdJson->valueint > UINT16_MAX) {
+      ESP_LOGE(TAG, "shockerIds contains an invalid shocker ID");
+      return false;
+    }
+
+    shockerIds.push_back(static_cast<std::uint16_t>(shockerIdJson->valueint));
+  }
+
+  return true;
+}
+
+cJSON* RFTransmitterConfig::ToJSON(bool withSensitiveData) const {
+  cJSON* root = cJSON_CreateObject();
+
+  cJSON_AddNumberToObject(root, "txPin", txPin);    //-V2564
+  cJSON_AddNumberToObject(root, "coreId", coreId);  //-V2564
+
+  cJSON* shockerIdsJson = cJSON_CreateArray();
+
+  for (std::uint16_t shockerId : shockerIds) {
+    cJSON_AddItemToArray(shockerIdsJson, cJSON_CreateNumber(shockerId));
+  }
+
+  cJSON_AddItemToObject(root, "shockerIds", shockerIdsJson);
+
+  return root;
+}
@@ -0,0 +1,148 @@
+#include "config/internal/RawPartition.h"
+
+#include "Checksum.h"
+#include "Logging.h"
+
+#include <esp_partition.h>
+
+#include <cstring>
+
+const char* const TAG = "RawPartition";
+
+using namespace OpenShock::Config::Internal;
+
+static const esp_partition_t* s_partition = nullptr;
+static const std::uint8_t* s_mapped       = nullptr;
+static spi_flash_mmap_handle_t s_mmapHandle;
+static std::uint32_t s_slotSize = 0;
+
+bool _readSlotHeader(const std::uint8_t* base, std::uint32_t slotSize, int slot, RawPartition::SlotHeader& header) {
+  const std::uint8_t* slotBase = base + slot * slotSize;
+
+  std::memcpy(&header, slotBase, sizeof(header));
+  if (header.magic != RawPartition::kSlotMagic || header.size == 0 || header.size > slotSize - sizeof(header)) {
+    return false;
+  }
+
+  return OpenShock::Checksum::ComputeBuffer<OpenShock::Checksum::CRC8Autosar>(slotBase + sizeof(header), header.size) == header.checksum;
+}
+
+int RawPartition::FindLatestSlot(const std::uint8_t* base, std::uint32_t partitionSize, std::uint32_t slotSize) {
+  if (base == nullptr || slotSize < sizeof(SlotHeader) || slotSize * 2 > partitionSize) {
+    return -1;
+  }
+
+  int latest                   = -1;
+  std::uint32_t latestSequence = 0;
+  for (int slot = 0; slot < 2; ++slot) {
+    SlotHeader header;
+    if (!_readSlotHeader(base, slotSize, slot, header)) {
+      continue;
+    }
+
+    // Compared as a signed difference, so the sequence can wrap
+    if (latest < 0 || static_cast<std::int32_t>(header.sequence - latestSequence) > 0) {
+      latest         = slot;
+      latestSequence = header.sequence;
+    }
+  }
+
+  return latest;
+}
+
+bool RawPartition::Init() {
+  s_mapped    = nullptr;
+  s_partition = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, ESP_PARTITION_SUBTYPE_ANY, kPartitionLabel);
+  if (s_partition == nullptr) {
+    return false;
+  }
+
+  // Two slots, each a whole number of sectors so either can be erased without touching the other
+  s_slotSize = (s_partition->size / 2) & ~(kSectorSize - 1);
+  if (s_slotSize < kSectorSize) {
+    ESP_LOGE(TAG, "Raw config partition is too small, need at least %u bytes", kSectorSize * 2);
+    s_partition = nullptr;
+    return false;
+  }
+
+  const void* mapped = nullptr;
+  if (esp_partition_mmap(s_partition, 0, s_slotSize * 2, SPI_FLASH_MMAP_DATA, &mapped, &s_mmapHandle) != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to map raw config partition");
+    s_partition = nullptr;
+    return false;
+  }
+
+  s_mapped = reinterpret_cast<const std::uint8_t*>(mapped);
+
+  return true;
+}
+
+bool RawPartition::IsAvailable() {
+  return s_mapped != nullptr;
+}
+
+bool RawPartition::GetLatest(const std::uint8_t*& data, std::uint32_t& size) {
+  int slot = FindLatestSlot(s_mapped, s_slotSize * 2, s_slotSize);
+  if (slot < 0) {
+    return false;
+  }
+
+  SlotHeader header;
+  std::memcpy(&header, s_mapped + slot * s_slotSize, sizeof(header));
+
+  data = s_mapped + slot * s_slotSize + sizeof(header);
+  size = header.size;
+
+  return true;
+}
+
+bool RawPartition::Write(const std::uint8_t* data, std::uint32_t size) {
+  if (s_mapped == nullptr) {
+    return false;
+  }
+
+  if (size == 0 || size > s_slotSize - sizeof(SlotHeader)) {
+    ESP_LOGE(TAG, "Config of %u bytes does not fit in a %u byte slot", size, s_slotSize);
+    return false;
+  }
+
+  SlotHeader header {
+    .magic    = kSlotMagic,
+    .sequence = 1,
+    .size     = size,
+    .checksum = OpenShock::Checksum::ComputeBuffer<OpenShock::Checksum::CRC8Autosar>(data, size),
+    .reserved = {0xFF, 0xFF, 0xFF},
+  };
+
+  // Overwrite the older slot, the current one stays intact until the new header lands
+  int target = 0;
+  int latest = FindLatestSlot(s_mapped, s_slotSize * 2, s_slotSize);
+  if (latest >= 0) {
+    SlotHeader latestHeader;
+    std::memcpy(&latestHeader, s_mapped + latest * s_slotSize, sizeof(latestHeader));
+
+    target          = latest ^ 1;
+    header.sequence = latestHeader.sequence + 1;
+  }
+
+  std::uint32_t offset = target * s_slotSize;
+
+  // Only the sectors the new config covers are erased, whatever is left past the payload is never read
+  std::uint32_t eraseSize = (sizeof(header) + size + kSectorSize - 1) & ~(kSectorSize - 1);
+
+  // Writes and erases invalidate the cache for the mapped range, so reads through s_mapped see the new data
+  if (esp_partition_erase_range(s_partition, offset, eraseSize) != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to erase config slot %d", target);
+    return false;
+  }
+  if (esp_partition_write(s_partition, offset + sizeof(header), data, size) != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to write config slot %d", target);
+    return false;
+  }
+  if (esp_partition_write(s_partition, offset, &header, sizeof(header)) != ESP_OK) {
+    ESP_LOGE(TAG, "Failed to commit config slot %d", target);
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,366 @@
+#include "config/internal/SectionStore.h"
+
+#include "Checksum.h"
+#include "Logging.h"
+
+#include <array>
+#include <string>
+#include <vector>
+
+const char* const TAG = "SectionStore";
+
+const std::uint32_t SECTION_MAX_SIZE = 4096;
+
+// Present from the moment a multi-section save commits until all of its temp files have been renamed into place
+const char* const COMMIT_PATH      = "/sections.commit";
+const char* const COMMIT_TEMP_PATH = "/sections.commit.tmp";
+
+using namespace OpenShock::Config::Internal;
+using SectionStore::Section;
+
+static const std::array<const char*, SectionStore::kSectionCount> s_sectionPaths = {
+  "/rf.cfg",
+  "/wifi.cfg",
+  "/captiveportal.cfg",
+  "/backend.cfg",
+  "/serialinput.cfg",
+  "/otaupdate.cfg",
+};
+
+template<typename T>
+void _serializeSection(flatbuffers::FlatBufferBuilder& builder, const OpenShock::Config::ConfigBase<T>& section) {
+  builder.Finish(section.ToFlatbuffers(builder, true));
+}
+void _serializeSection(flatbuffers::FlatBufferBuilder& builder, Section section, const OpenShock::Config::RootConfig& config) {
+  switch (section) {
+    case Section::RF:
+      return _serializeSection(builder, config.rf);
+    case Section::WiFi:
+      return _serializeSection(builder, config.wifi);
+    case Section::CaptivePortal:
+      return _serializeSection(builder, config.captivePortal);
+    case Section::Backend:
+      return _serializeSection(builder, config.backend);
+    case Section::SerialInput:
+      return _serializeSection(builder, config.serialInput);
+    case Section::OtaUpdate:
+      return _serializeSection(builder, config.otaUpdate);
+  }
+}
+
+template<typename T>
+bool _deserializeSection(const std::uint8_t* data, std::size_t size, OpenShock::Config::ConfigBase<T>& section) {
+  flatbuffers::Verifier::Options verifierOptions {
+    .max_size = SECTION_MAX_SIZE,
+  };
+  flatbuffers::Verifier verifier(data, size, verifierOptions);
+  if (!verifier.VerifyBuffer<T>(nullptr)) {
+    return false;
+  }
+
+  return section.FromFlatbuffers(flatbuffers::GetRoot<T>(data));
+}
+bool _deserializeSection(const std::uint8_t* data, std::size_t size, Section section, OpenShock::Config::RootConfig& config) {
+  switch (section) {
+    case Section::RF:
+      return _deserializeSection(data, size, config.rf);
+    case Section::WiFi:
+      return _deserializeSection(data, size, config.wifi);
+    case Section::CaptivePortal:
+      return _deserializeSection(data, size, config.captivePortal);
+    case Section::Backend:
+      return _deserializeSection(data, size, config.backend);
+    case Section::SerialInput:
+      return _deserializeSection(data, size, config.serialInput);
+    case Section::OtaUpdate:
+      return _deserializeSection(data, size, config.otaUpdate);
+  }
+
+  return false;
+}
+void _resetSection(Section section, OpenShock::Config::RootConfig& config) {
+  switch (section) {
+    case Section::RF:
+      return config.rf.ToDefault();
+    case Section::WiFi:
+      return config.wifi.ToDefault();
+    case Section::CaptivePortal:
+      return config.captivePortal.ToDefault();
+    case Section::Backend:
+      return config.backend.ToDefault();
+    case Section::SerialInput:
+      return config.serialInput.ToDefault();
+    case Section::OtaUpdate:
+      return config.otaUpdate.ToDefault();
+  }
+}
+
+bool _tryLoadSectionFile(fs::FS& fs, const char* path, Section section, OpenShock::Config::RootConfig& config) {
+  File file = fs.open(path, "rb");
+  if (!file) {
+    return false;
+  }
+
+  SectionStore::SectionHeader header;
+  if (file.read(reinterpret_cast<std::uint8_t*>(&header), sizeof(header)) != sizeof(header)) {
+    ESP_LOGE(TAG, "Failed to read header of %s", path);
+    return false;
+  }
+
+  if (header.magic != SectionStore::kSectionMagic || header.section != static_cast<std::uint8_t>(section) || header.size == 0 || header.size > SECTION_MAX_SIZE) {
+    ESP_LOGE(TAG, "Invalid header in %s", path);
+    return false;
+  }
+
+  if (header.version != SectionStore::kSectionVersion) {
+    ESP_LOGE(TAG, "Unsupported version %u in %s", header.version, path);
+    return false;
+  }
+
+  std::vector<std::uint8_t> buffer(header.size);
+  if (file.read(buffer.data(), buffer.size()) != buffer.size()) {
+    ESP_LOGE(TAG, "Failed to read %s, size mismatch", path);
+    return false;
+  }
+
+  file.close();
+
+  if (OpenShock::Checksum::ComputeBuffer<OpenShock::Checksum::CRC8Autosar>(buffer.data(), buffer.size()) != header.checksum) {
+    ESP_LOGE(TAG, "Checksum mismatch in %s", path);
+    return false;
+  }
+
+  if (!_deserializeSection(buffer.data(), buffer.size(), section, config)) {
+    ESP_LOGE(TAG, "Failed to deserialize %s", path);
+    return false;
+  }
+
+  return true;
+}
+std::string _tempPath(Section section) {
+  return std::string(s_sectionPaths[static_cast<std::uint8_t>(section)]) + ".tmp";
+}
+bool _tryWriteSectionTemp(fs::FS& fs, Section section, const OpenShock::Config::RootConfig& config, flatbuffers::FlatBufferBuilder& builder) {
+  std::string tempPath = _tempPath(section);
+
+  builder.Clear();
+  _serializeSection(builder, section, config);
+
+  SectionStore::SectionHeader header {
+    .magic    = SectionStore::kSectionMagic,
+    .section  = static_cast<std::uint8_t>(section),
+    .version  = SectionStore::kSectionVersion,
+    .checksum = OpenShock::Checksum::ComputeBuffer<OpenShock::Checksum::CRC8Autosar>(builder.GetBufferPointer(), builder.GetSize()),
+    .reserved = 0,
+    .size     = builder.GetSize(),
+  };
+
+  File file = fs.open(tempPath.c_str(), "wb");
+  if (!file) {
+    ESP_LOGE(TAG, "Failed to open %s for writing", tempPath.c_str());
+    return false;
+  }
+
+  if (file.write(reinterpret_cast<const std::uint8_t*>(&header), sizeof(header)) != sizeof(header) || file.write(builder.GetBufferPointer(), builder.GetSize()) != builder.GetSize()) {
+    ESP_LOGE(TAG, "Failed to write %s", tempPath.c_str());
+    file.close();
+    fs.remove(tempPath.c_str());
+    return false;
+  }
+
+  file.close();
+
+  return true;
+}
+bool _tryWriteCommit(fs::FS& fs, std::uint8_t sections) {
+  SectionStore::CommitRecord record {
+    .magic    = SectionStore::kCommitMagic,
+    .sections = sections,
+    .checksum = OpenShock::Checksum::ComputeBuffer<OpenShock::Checksum::CRC8Autosar>(&sections, sizeof(sections)),
+    .reserved = 0,
+  };
+
+  File file = fs.open(COMMIT_TEMP_PATH, "wb");
+  if (!file) {
+    ESP_LOGE(TAG, "Failed to open %s for writing", COMMIT_TEMP_PATH);
+    return false;
+  }
+
+  bool written = file.write(reinterpret_cast<const std::uint8_t*>(&record), sizeof(record)) == sizeof(record);
+  file.close();
+
+  if (!written || !fs.rename(COMMIT_TEMP_PATH, COMMIT_PATH)) {
+    ESP_LOGE(TAG, "Failed to write %s", COMMIT_PATH);
+    fs.remove(COMMIT_TEMP_PATH);
+    return false;
+  }
+
+  return true;
+}
+bool _tryReadCommit(fs::FS& fs, std::uint8_t& sections) {
+  File file = fs.open(COMMIT_PATH, "rb");
+  if (!file) {
+    return false;
+  }
+
+  SectionStore::CommitRecord record;
+  bool read = file.read(reinterpret_cast<std::uint8_t*>(&record), sizeof(record)) == sizeof(record);
+  file.close();
+
+  if (!read || record.magic != SectionStore::kCommitMagic || (record.sections & ~SectionStore::kAllSections) != 0 || OpenShock::Checksum::ComputeBuffer<OpenShock::Checksum::CRC8Autosar>(&record.sections, sizeof(record.sections)) != record.checksum) {
+    ESP_LOGE(TAG, "Invalid commit record");
+    return false;
+  }
+
+  sections = record.sections;
+  return true;
+}
+/// @return Bits of the given sections whose temp files could not be renamed into place
+std::uint8_t _renameTemps(fs::FS& fs, std::uint8_t sections) {
+  std::uint8_t failed = 0;
+
+  for (std::uint8_t i = 0; i < SectionStore::kSectionCount; ++i) {
+    Section section = static_cast<Section>(i);
+    if ((sections & SectionStore::SectionBit(section)) == 0) {
+      continue;
+    }
+
+    std::string tempPath = _tempPath(section);
+    if (!fs.exists(tempPath.c_str())) {
+      continue;  // Renamed before the interruption
+    }
+
+    if (!fs.rename(tempPath.c_str(), s_sectionPaths[i])) {
+      ESP_LOGE(TAG, "Failed to replace %s", s_sectionPaths[i]);
+      failed |= SectionStore::SectionBit(section);
+    }
+  }
+
+  return failed;
+}
+/// @brief Rolls a committed save forward and drops the temp files of any save that did not commit, so the sections on disk are all from the same save
+void _recoverInterruptedSave(fs::FS& fs) {
+  std::uint8_t committed = 0;
+  bool hasCommit         = fs.exists(COMMIT_PATH);
+  if (hasCommit && _tryReadCommit(fs, committed)) {
+    ESP_LOGW(TAG, "Completing interrupted save");
+  }
+
+  std::uint8_t failed = _renameTemps(fs, committed);
+
+  for (std::uint8_t i = 0; i < SectionStore::kSectionCount; ++i) {
+    Section section = static_cast<Section>(i);
+    if ((committed & SectionStore::SectionBit(section)) != 0) {
+      continue;
+    }
+
+    std::string tempPath = _tempPath(section);
+    if (fs.exists(tempPath.c_str())) {
+      ESP_LOGW(TAG, "Discarding uncommitted write of %s", s_sectionPaths[i]);
+      fs.remove(tempPath.c_str());
+    }
+  }
+
+  if (fs.exists(COMMIT_TEMP_PATH)) {
+    fs.remove(COMMIT_TEMP_PATH);
+  }
+
+  // Keep the record while a committed temp file is still waiting, the next attempt finishes it
+  if (hasCommit && failed == 0) {
+    fs.remove(COMMIT_PATH);
+  }
+}
+
+bool SectionStore::Exists(fs::FS& fs) {
+  // A first save that was interrupted after committing has no section files yet, only temp files that Load renames into place
+  if (fs.exists(COMMIT_PATH)) {
+    return true;
+  }
+
+  for (const char* path : s_sectionPaths) {
+    if (fs.exists(path)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+void SectionStore::Load(fs::FS& fs, RootConfig& config, std::uint8_t& invalid) {
+  invalid = 0;
+
+  _recoverInterruptedSave(fs);
+
+  for (std::uint8_t i = 0; i < kSectionCount; ++i) {
+    Section section = static_cast<Section>(i);
+    if (_tryLoadSectionFile(fs, s_sectionPaths[i], section, config)) {
+      continue;
+    }
+
+    ESP_LOGW(TAG, "Resetting %s to defaults", s_sectionPaths[i]);
+    _resetSection(section, config);
+    invalid |= SectionBit(section);
+  }
+}
+
+bool SectionStore::Save(fs::FS& fs, const RootConfig& config, std::uint8_t sections, std::uint8_t& failed) {
+  failed = 0;
+
+  sections &= kAllSections;
+  if (sections == 0) {
+    return true;
+  }
+
+  // A save that committed but could not rename every temp file left its record behind, finish it before its temp files are overwritten
+  if (fs.exists(COMMIT_PATH)) {
+    _recoverInterruptedSave(fs);
+  }
+
+  flatbuffers::FlatBufferBuilder builder;
+  for (std::uint8_t i = 0; i < kSectionCount; ++i) {
+    Section section = static_cast<Section>(i);
+    if ((sections & SectionBit(section)) == 0) {
+      continue;
+    }
+
+    if (_tryWriteSectionTemp(fs, section, config, builder)) {
+      continue;
+    }
+
+    // All or nothing, the sections written so far are dropped with the one that failed
+    for (std::uint8_t j = 0; j < i; ++j) {
+      if ((sections & SectionBit(static_cast<Section>(j))) != 0) {
+        fs.remove(_tempPath(static_cast<Section>(j)).c_str());
+      }
+    }
+
+    failed = sections;
+    return false;
+  }
+
+  // Renaming a single file is atomic on its own, several need the commit record so an interruption between the renames can be finished on load
+  bool multiple = (sections & (sections - 1)) != 0;
+  if (multiple && !_tryWriteCommit(fs, sections)) {
+    for (std::uint8_t i = 0; i < kSectionCount; ++i) {
+      if ((sections & SectionBit(static_cast<Section>(i))) != 0) {
+        fs.remove(_tempPath(static_cast<Section>(i)).c_str());
+      }
+    }
+
+    failed = sections;
+    return false;
+  }
+
+  failed = _renameTemps(fs, sections);
+
+  if (failed != 0) {
+    // Committed already, the record stays so the next save or boot renames what is left
+    return false;
+  }
+
+  if (multiple) {
+    fs.remove(COMMIT_PATH);
+  }
+
+  return true;
+}
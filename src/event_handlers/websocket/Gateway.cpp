@@ -1,8 +1,11 @@
 #include "event_handlers/WebSocket.h"
 
+#include "event_handlers/impl/MessageVerifier.h"
 #include "event_handlers/impl/WSGateway.h"
 
+#include "LatencyTrace.h"
 #include "Logging.h"
+#include "Time.h"
 
 #include "serialization/_fbs/GatewayToHubMessage_generated.h"
 
@@ -34,23 +37,26 @@ static std::array<Handlers::HandlerType, HANDLER_COUNT> s_serverHandlers = []()
   return handlers;
 }();
 
-void EventHandlers::WebSocket::HandleGatewayBinary(const std::uint8_t* data, std::size_t len) {
-  // Deserialize
-  auto msg = flatbuffers::GetRoot<Schemas::GatewayToHubMessage>(data);
+static EventHandlers::WebSocket::_Private::MessageVerifier<Schemas::GatewayToHubMessage, PayloadType, Schemas::EnumNameGatewayToHubMessagePayload> s_verifier(EventHandlers::WebSocket::GATEWAY_MAX_MESSAGE_SIZE, []() {
+  std::array<std::uint32_t, HANDLER_COUNT> limits {};
+  limits.fill(256);  // Fixed-size payloads
+
+  // Command lists grow with the number of shockers and may arrive fragmented
+  limits[static_cast<std::size_t>(PayloadType::ShockerCommandList)] = EventHandlers::WebSocket::GATEWAY_MAX_MESSAGE_SIZE;
+  limits[static_cast<std::size_t>(PayloadType::OtaInstall)]         = 1024;  // SemVer carries prerelease and build strings
+
+  return limits;
+}());
+
+void _dispatchGatewayBinary(const std::uint8_t* data, std::size_t len) {
+  // Verify, the whole command list is a single bounds-checked vector of structs, so handlers can act on it right away
+  auto msg = s_verifier.Verify(data, len);
   if (msg == nullptr) {
-    ESP_LOGE(TAG, "Failed to deserialize message");
+    ESP_LOGE(TAG, "Failed to verify message (%zu bytes)", len);
     return;
   }
 
-  // Validate buffer
-  flatbuffers::Verifier::Options verifierOptions {
-    .max_size = 4096,  // TODO: Profile this
-  };
-  flatbuffers::Verifier verifier(data, len, verifierOptions);
-  if (!msg->Verify(verifier)) {
-    ESP_LOGE(TAG, "Failed to verify message");
-    return;
-  }
+  LatencyTrace::MarkMessageVerified(OpenShock::micros());
 
   if (msg->payload_type() < PayloadType::MIN || msg->payload_type() > PayloadType::MAX) {
     Handlers::HandleInvalidMessage(msg);
@@ -59,3 +65,16 @@ void EventHandlers::WebSocket::HandleGatewayBinary(const std::uint8_t* data, std
 
   s_serverHandlers[static_cast<std::size_t>(msg->payload_type())](msg);
 }
+
+void EventHandlers::WebSocket::HandleGatewayBinary(const std::uint8_t* data, std::size_t len) {
+  // Commands handled while the message is dispatched are traced from here
+  LatencyTrace::BeginMessage(OpenShock::micros());
+
+  _dispatchGatewayBinary(data, len);
+
+  LatencyTrace::EndMessage();
+}
+
+void EventHandlers::WebSocket::GetGatewayVerifyStats(std::vector<VerifyStats>& out) {
+  s_verifier.GetStats(out);
+}
@@ -1,5 +1,6 @@
 #include "event_handlers/WebSocket.h"
 
+#include "event_handlers/impl/MessageVerifier.h"
 #include "event_handlers/impl/WSLocal.h"
 #include "Logging.h"
 
@@ -34,25 +35,30 @@ static std::array<Handlers::HandlerType, HANDLER_COUNT> s_localHandlers = []() {
   SET_HANDLER(PayloadType::AccountLinkCommand, Handlers::HandleAccountLinkCommand);
   SET_HANDLER(PayloadType::AccountUnlinkCommand, Handlers::HandleAccountUnlinkCommand);
   SET_HANDLER(PayloadType::SetRfTxPinCommand, Handlers::HandleSetRfTxPinCommand);
+  SET_HANDLER(PayloadType::LatencyReportCommand, Handlers::HandleLatencyReportCommand);
+  SET_HANDLER(PayloadType::ShockerCommandList, Handlers::HandleShockerCommandList);
 
   return handlers;
 }();
 
+static EventHandlers::WebSocket::_Private::MessageVerifier<Schemas::LocalToHubMessage, PayloadType, Schemas::EnumNameLocalToHubMessagePayload> s_verifier(EventHandlers::WebSocket::LOCAL_MAX_MESSAGE_SIZE, []() {
+  std::array<std::uint32_t, HANDLER_COUNT> limits {};
+  limits.fill(256);  // Commands carry an SSID of at most 32 bytes and a passphrase of at most 64, or less
+
+  // Domains and SemVer strings can run past that
+  limits[static_cast<std::size_t>(PayloadType::OtaUpdateSetDomainCommand)]   = 512;
+  limits[static_cast<std::size_t>(PayloadType::OtaUpdateStartUpdateCommand)] = 512;
+
+  // Command lists grow with the number of shockers and may arrive fragmented
+  limits[static_cast<std::size_t>(PayloadType::ShockerCommandList)] = EventHandlers::WebSocket::LOCAL_MAX_MESSAGE_SIZE;
+
+  return limits;
+}());
+
 void EventHandlers::WebSocket::HandleLocalBinary(std::uint8_t socketId, const std::uint8_t* data, std::size_t len) {
-  // Deserialize
-  auto msg = flatbuffers::GetRoot<Schemas::LocalToHubMessage>(data);
+  auto msg = s_verifier.Verify(data, len);
   if (msg == nullptr) {
-    ESP_LOGE(TAG, "Failed to deserialize message");
-    return;
-  }
-
-  // Validate buffer
-  flatbuffers::Verifier::Options verifierOptions {
-    .max_size = 4096,  // TODO: Profile this
-  };
-  flatbuffers::Verifier verifier(data, len, verifierOptions);
-  if (!msg->Verify(verifier)) {
-    ESP_LOGE(TAG, "Failed to verify message");
+    ESP_LOGE(TAG, "Failed to verify message (%zu bytes)", len);
     return;
   }
 
@@ -63,3 +69,7 @@ void EventHandlers::WebSocket::HandleLocalBinary(std::uint8_t socketId, const st
 
   s_localHandlers[static_cast<std::size_t>(msg->payload_type())](socketId, msg);
 }
+
+void EventHandlers::WebSocket::GetLocalVerifyStats(std::vector<VerifyStats>& out) {
+  s_verifier.GetStats(out);
+}
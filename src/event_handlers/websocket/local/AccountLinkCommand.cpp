@@ -3,13 +3,15 @@
 #include "CaptivePortal.h"
 #include "GatewayConnectionManager.h"
 #include "Logging.h"
+#include "serialization/BuilderPool.h"
 
 #include <cstdint>
 
 const char* const TAG = "LocalMessageHandlers";
 
 void serializeSetRfTxPinResult(std::uint8_t socketId, OpenShock::Serialization::Local::AccountLinkResultCode result) {
-  flatbuffers::FlatBufferBuilder builder(1024);
+  OpenShock::Serialization::BuilderPool::Lease lease("AccountLinkCommandResult");
+  flatbuffers::FlatBufferBuilder& builder = *lease;
 
   auto responseOffset = builder.CreateStruct(OpenShock::Serialization::Local::AccountLinkCommandResult(result));
 
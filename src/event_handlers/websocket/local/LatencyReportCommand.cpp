@@ -0,0 +1,52 @@
+#include "event_handlers/impl/WSLocal.h"
+
+#include "CaptivePortal.h"
+#include "LatencyTrace.h"
+#include "Logging.h"
+#include "serialization/BuilderPool.h"
+
+#include <cstdint>
+#include <vector>
+
+const char* const TAG = "LocalMessageHandlers";
+
+void serializeLatencyReport(std::uint8_t socketId) {
+  std::vector<OpenShock::LatencyTrace::StageStats> stats;
+  OpenShock::LatencyTrace::GetStageStats(stats);
+
+  // GetStageStats lists the intervals ending at Verified through Transmitted, followed by the total
+  std::vector<OpenShock::Serialization::Local::LatencyStageStats> stages;
+  stages.reserve(stats.size());
+  for (std::size_t i = 0; i < stats.size(); ++i) {
+    std::uint8_t stage = static_cast<std::uint8_t>(i + 1 < stats.size() ? i + 1 : static_cast<std::size_t>(OpenShock::LatencyTrace::Stage::Count));
+    stages.emplace_back(stage, stats[i].count, stats[i].p50Us, stats[i].p95Us, stats[i].p99Us);
+  }
+
+  OpenShock::Serialization::BuilderPool::Lease lease("LatencyReport");
+  flatbuffers::FlatBufferBuilder& builder = *lease;
+
+  auto responseOffset = OpenShock::Serialization::Local::CreateLatencyReportDirect(builder, &stages);
+
+  auto msgOffset = OpenShock::Serialization::Local::CreateHubToLocalMessage(builder, OpenShock::Serialization::Local::HubToLocalMessagePayload::LatencyReport, responseOffset.Union());
+
+  builder.Finish(msgOffset);
+
+  OpenShock::CaptivePortal::SendMessageBIN(socketId, builder.GetBufferPointer(), builder.GetSize());
+}
+
+using namespace OpenShock::MessageHandlers::Local;
+
+void _Private::HandleLatencyReportCommand(std::uint8_t socketId, const OpenShock::Serialization::Local::LocalToHubMessage* root) {
+  auto msg = root->payload_as_LatencyReportCommand();
+  if (msg == nullptr) {
+    ESP_LOGE(TAG, "Payload cannot be parsed as LatencyReportCommand");
+    return;
+  }
+
+  serializeLatencyReport(socketId);
+
+  // Reset after reporting, so the client gets the samples it is discarding
+  if (msg->reset()) {
+    OpenShock::LatencyTrace::Reset();
+  }
+}
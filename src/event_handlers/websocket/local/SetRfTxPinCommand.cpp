@@ -4,13 +4,15 @@
 #include "CommandHandler.h"
 #include "Common.h"
 #include "Logging.h"
+#include "serialization/BuilderPool.h"
 
 #include <cstdint>
 
 const char* const TAG = "LocalMessageHandlers";
 
 void serializeSetRfTxPinResult(std::uint8_t socketId, std::uint8_t pin, OpenShock::Serialization::Local::SetRfPinResultCode result) {
-  flatbuffers::FlatBufferBuilder builder(1024);
+  OpenShock::Serialization::BuilderPool::Lease lease("SetRfTxPinCommandResult");
+  flatbuffers::FlatBufferBuilder& builder = *lease;
 
   auto responseOffset = builder.CreateStruct(OpenShock::Serialization::Local::SetRfTxPinCommandResult(pin, result));
 
@@ -0,0 +1,78 @@
+#include "event_handlers/impl/WSLocal.h"
+
+#include "CaptivePortal.h"
+#include "CommandHandler.h"
+#include "Logging.h"
+#include "serialization/BuilderPool.h"
+#include "ShockerModelType.h"
+
+#include <cstdint>
+#include <vector>
+
+const char* const TAG = "LocalMessageHandlers";
+
+typedef OpenShock::Serialization::Local::ShockerCommandResultCode ResultCode;
+
+void serializeShockerCommandListResult(std::uint8_t socketId, const std::vector<ResultCode>& results) {
+  OpenShock::Serialization::BuilderPool::Lease lease("ShockerCommandListResult");
+  flatbuffers::FlatBufferBuilder& builder = *lease;
+
+  auto responseOffset = OpenShock::Serialization::Local::CreateShockerCommandListResultDirect(builder, &results);
+
+  auto msgOffset = OpenShock::Serialization::Local::CreateHubToLocalMessage(builder, OpenShock::Serialization::Local::HubToLocalMessagePayload::ShockerCommandListResult, responseOffset.Union());
+
+  builder.Finish(msgOffset);
+
+  OpenShock::CaptivePortal::SendMessageBIN(socketId, builder.GetBufferPointer(), builder.GetSize());
+}
+
+ResultCode _handleCommand(const OpenShock::Serialization::Local::ShockerCommand* command) {
+  std::uint16_t id                   = command->id();
+  std::uint8_t intensity             = command->intensity();
+  std::uint16_t durationMs           = command->duration();
+  OpenShock::ShockerModelType model  = command->model();
+  OpenShock::ShockerCommandType type = command->type();
+
+  // Structs are not range checked by the verifier, an unknown value would otherwise reach the encoders
+  const char* modelStr = OpenShock::Serialization::Types::EnumNameShockerModelType(model);
+  const char* typeStr  = OpenShock::Serialization::Types::EnumNameShockerCommandType(type);
+  if (*modelStr == '\0' || *typeStr == '\0') {
+    return ResultCode::InvalidCommand;
+  }
+
+  ESP_LOGV(TAG, "   ID %u, Intensity %u, Duration %u, Model %s, Type %s", id, intensity, durationMs, modelStr, typeStr);
+
+  if (!OpenShock::CommandHandler::HandleCommand(model, id, type, intensity, durationMs)) {
+    return ResultCode::Rejected;
+  }
+
+  return ResultCode::Success;
+}
+
+using namespace OpenShock::MessageHandlers::Local;
+
+void _Private::HandleShockerCommandList(std::uint8_t socketId, const OpenShock::Serialization::Local::LocalToHubMessage* root) {
+  auto msg = root->payload_as_ShockerCommandList();
+  if (msg == nullptr) {
+    ESP_LOGE(TAG, "Payload cannot be parsed as ShockerCommandList");
+    return;
+  }
+
+  auto commands = msg->commands();
+  if (commands == nullptr) {
+    ESP_LOGE(TAG, "Received invalid command list from local client");
+    return;
+  }
+
+  ESP_LOGV(TAG, "Received command list from local client (%u commands)", commands->size());
+
+  // One result per command, in the order the commands were sent
+  std::vector<ResultCode> results;
+  results.reserve(commands->size());
+
+  for (auto command : *commands) {
+    results.push_back(_handleCommand(command));
+  }
+
+  serializeShockerCommandListResult(socketId, results);
+}
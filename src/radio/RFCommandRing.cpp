@@ -0,0 +1,93 @@
+#include "radio/RFCommandRing.h"
+
+using namespace OpenShock;
+
+RFCommandRing::RFCommandRing() : m_records(), m_head(0), m_tail(0), m_pushed(0), m_coalesced(0), m_dropped(0) {
+  for (auto& record : m_records) {
+    record.state.store(RecordState::Free, std::memory_order_relaxed);
+  }
+}
+
+bool RFCommandRing::Push(const Command& command) {
+  std::size_t tail = m_tail.load(std::memory_order_relaxed);
+  std::size_t head = m_head.load(std::memory_order_acquire);
+
+  // Look for the newest pending command for this shocker, command fields are only ever written by the producer so they can be read here
+  for (std::size_t i = tail; i != head;) {
+    Record& record = m_records[--i & (kCapacity - 1)];
+    if (record.command.shockerId != command.shockerId || record.command.model != command.model) {
+      continue;
+    }
+
+    // Claim it before the consumer does, if it was already taken the new command is queued behind it
+    RecordState expected = RecordState::Ready;
+    if (record.command.overwrite && record.state.compare_exchange_strong(expected, RecordState::Writing, std::memory_order_acquire)) {
+      record.command = command;
+      record.state.store(RecordState::Ready, std::memory_order_release);
+
+      m_coalesced.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+
+    break;
+  }
+
+  if (tail - head == kCapacity) {
+    m_dropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  Record& record = m_records[tail & (kCapacity - 1)];
+
+  record.command = command;
+  record.state.store(RecordState::Ready, std::memory_order_relaxed);
+
+  // Publishes the record to the consumer
+  m_tail.store(tail + 1, std::memory_order_release);
+
+  m_pushed.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+void RFCommandRing::Cancel() {
+  std::size_t tail = m_tail.load(std::memory_order_relaxed);
+  std::size_t head = m_head.load(std::memory_order_acquire);
+
+  for (std::size_t i = head; i != tail; ++i) {
+    RecordState expected = RecordState::Ready;
+    m_records[i & (kCapacity - 1)].state.compare_exchange_strong(expected, RecordState::Cancelled, std::memory_order_relaxed);
+  }
+}
+
+bool RFCommandRing::Pop(Command& out) {
+  std::size_t head = m_head.load(std::memory_order_relaxed);
+
+  while (head != m_tail.load(std::memory_order_acquire)) {
+    Record& record = m_records[head & (kCapacity - 1)];
+
+    RecordState expected = RecordState::Ready;
+    if (record.state.compare_exchange_strong(expected, RecordState::Reading, std::memory_order_acquire)) {
+      out = record.command;
+    } else if (expected != RecordState::Cancelled) {
+      return false;  // The producer is replacing it, and will signal again once done
+    }
+
+    // Hands the record back to the producer
+    record.state.store(RecordState::Free, std::memory_order_release);
+    m_head.store(++head, std::memory_order_release);
+
+    if (expected == RecordState::Ready) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+RFCommandRing::Stats RFCommandRing::GetStats() const {
+  return {
+    .pushed    = m_pushed.load(std::memory_order_relaxed),
+    .coalesced = m_coalesced.load(std::memory_order_relaxed),
+    .dropped   = m_dropped.load(std::memory_order_relaxed),
+  };
+}
@@ -0,0 +1,241 @@
+#include "radio/RFScheduler.h"
+
+#include <algorithm>
+
+using namespace OpenShock;
+
+RFScheduler::RFScheduler(const Config& config) : m_config(config), m_slots(), m_heap(), m_heapSize(0), m_usedCount(0) {
+  Clear();
+}
+
+void RFScheduler::SetConfig(const Config& config) {
+  m_config = config;
+}
+
+bool RFScheduler::Submit(ShockerModelType model, std::uint16_t shockerId, std::int64_t untilUs, const Rmt::Sequence& sequence, const Rmt::Sequence& zeroSequence, bool overwrite, std::int64_t submittedUs, std::uint32_t traceId) {
+  int index = findSlot(shockerId);
+  if (index >= 0) {
+    Slot& slot = m_slots[index];
+
+    // Only replace the command if it should be overwritten
+    if (!slot.overwrite) {
+      return false;
+    }
+
+    // Keep the deadline, replacing a command should not let it skip ahead of other shockers
+    slot.overwrite    = overwrite;
+    slot.model        = model;
+    slot.untilUs      = untilUs;
+    slot.submittedUs  = submittedUs;
+    slot.traceId      = traceId;
+    slot.sequence     = sequence;
+    slot.zeroSequence = zeroSequence;
+
+    return true;
+  }
+
+  index = allocateSlot(shockerId);
+  if (index < 0) {
+    return false;
+  }
+
+  Slot& slot = m_slots[index];
+
+  slot.overwrite    = overwrite;
+  slot.model        = model;
+  slot.untilUs      = untilUs;
+  slot.deadlineUs   = submittedUs;
+  slot.submittedUs  = submittedUs;
+  slot.traceId      = traceId;
+  slot.sequence     = sequence;
+  slot.zeroSequence = zeroSequence;
+  slot.framesSent.store(0, std::memory_order_relaxed);
+  slot.missedDeadlines.store(0, std::memory_order_relaxed);
+
+  heapPush(static_cast<std::uint8_t>(index));
+
+  return true;
+}
+
+void RFScheduler::ExpireAll(std::int64_t untilUs) {
+  for (auto& slot : m_slots) {
+    if (slot.state.load(std::memory_order_relaxed) == SlotState::Used) {
+      slot.untilUs = std::min(slot.untilUs, untilUs);
+    }
+  }
+}
+
+void RFScheduler::Clear() {
+  for (auto& slot : m_slots) {
+    slot.state.store(SlotState::Empty, std::memory_order_relaxed);
+    slot.scheduled = false;
+  }
+
+  m_heapSize  = 0;
+  m_usedCount = 0;
+}
+
+std::int64_t RFScheduler::NextDeadline() const {
+  return m_slots[m_heap[0]].deadlineUs;
+}
+
+bool RFScheduler::Pop(std::int64_t nowUs, Transmission& out) {
+  return pop(nowUs, nullptr, out);
+}
+
+bool RFScheduler::Pop(std::int64_t nowUs, ShockerModelType model, Transmission& out) {
+  return pop(nowUs, &model, out);
+}
+
+bool RFScheduler::pop(std::int64_t nowUs, const ShockerModelType* model, Transmission& out) {
+  while (m_heapSize > 0) {
+    Slot& next = m_slots[m_heap[0]];
+    if (next.deadlineUs > nowUs || (model != nullptr && next.model != *model)) {
+      return false;
+    }
+
+    std::uint8_t index = heapPop();
+    Slot& slot         = m_slots[index];
+
+    // Once a command has run out, only its zero sequence is sent until it is released
+    const Rmt::Sequence* sequence = slot.untilUs < nowUs || slot.sequence.empty() ? &slot.zeroSequence : &slot.sequence;
+    if (sequence->empty()) {
+      releaseSlot(index);
+      continue;
+    }
+
+    if (nowUs - slot.deadlineUs > m_config.frameIntervalUs) {
+      slot.missedDeadlines.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    slot.scheduled = false;
+
+    out.slotIndex   = index;
+    out.model       = slot.model;
+    out.sequence    = sequence;
+    out.deadlineUs  = slot.deadlineUs;
+    out.submittedUs = slot.submittedUs;
+    out.traceId     = slot.traceId;
+
+    slot.submittedUs = 0;
+    slot.traceId     = 0;
+
+    return true;
+  }
+
+  return false;
+}
+
+void RFScheduler::Complete(const Transmission& transmission, std::int64_t nowUs) {
+  Slot& slot = m_slots[transmission.slotIndex];
+
+  // The slot was cleared or reused while the frame was on air
+  if (slot.state.load(std::memory_order_relaxed) != SlotState::Used || slot.scheduled) {
+    return;
+  }
+
+  slot.framesSent.fetch_add(1, std::memory_order_relaxed);
+
+  if (slot.untilUs + m_config.transmitEndDurationUs < nowUs) {
+    releaseSlot(transmission.slotIndex);
+    return;
+  }
+
+  switch (m_config.policy) {
+    case FairnessPolicy::FixedFrameRate:
+      slot.deadlineUs += m_config.frameIntervalUs;
+
+      // Don't let a slot that fell behind burst to catch up, that would starve the others
+      if (slot.deadlineUs + m_config.frameIntervalUs < nowUs) {
+        slot.deadlineUs = nowUs;
+      }
+      break;
+    case FairnessPolicy::RoundRobin:
+    default:
+      // Go to the back of the line
+      slot.deadlineUs = nowUs;
+      break;
+  }
+
+  heapPush(transmission.slotIndex);
+}
+
+void RFScheduler::GetSlotStats(std::vector<SlotStats>& out) const {
+  out.clear();
+
+  for (const auto& slot : m_slots) {
+    if (slot.state.load(std::memory_order_relaxed) != SlotState::Used) {
+      continue;
+    }
+
+    out.push_back({
+      .shockerId       = slot.shockerId.load(std::memory_order_relaxed),
+      .framesSent      = slot.framesSent.load(std::memory_order_relaxed),
+      .missedDeadlines = slot.missedDeadlines.load(std::memory_order_relaxed),
+    });
+  }
+}
+
+int RFScheduler::findSlot(std::uint16_t shockerId) const {
+  std::size_t index = slotIndexFor(shockerId);
+
+  for (std::size_t i = 0; i < kSlotCount; ++i) {
+    const Slot& slot = m_slots[index];
+
+    SlotState state = slot.state.load(std::memory_order_relaxed);
+    if (state == SlotState::Empty) {
+      return -1;
+    }
+
+    if (state == SlotState::Used && slot.shockerId.load(std::memory_order_relaxed) == shockerId) {
+      return static_cast<int>(index);
+    }
+
+    index = (index + 1) & (kSlotCount - 1);
+  }
+
+  return -1;
+}
+
+int RFScheduler::allocateSlot(std::uint16_t shockerId) {
+  std::size_t index = slotIndexFor(shockerId);
+
+  for (std::size_t i = 0; i < kSlotCount; ++i) {
+    Slot& slot = m_slots[index];
+
+    if (slot.state.load(std::memory_order_relaxed) != SlotState::Used) {
+      slot.shockerId.store(shockerId, std::memory_order_relaxed);
+      slot.state.store(SlotState::Used, std::memory_order_relaxed);
+      ++m_usedCount;
+      return static_cast<int>(index);
+    }
+
+    index = (index + 1) & (kSlotCount - 1);
+  }
+
+  return -1;
+}
+
+void RFScheduler::releaseSlot(std::uint8_t slotIndex) {
+  m_slots[slotIndex].state.store(SlotState::Deleted, std::memory_order_relaxed);
+  m_slots[slotIndex].scheduled = false;
+
+  // Once the table drains, drop the tombstones so probe chains stay short
+  if (--m_usedCount == 0) {
+    for (auto& slot : m_slots) {
+      slot.state.store(SlotState::Empty, std::memory_order_relaxed);
+    }
+  }
+}
+
+void RFScheduler::heapPush(std::uint8_t slotIndex) {
+  m_slots[slotIndex].scheduled = true;
+
+  m_heap[m_heapSize++] = slotIndex;
+  std::push_heap(m_heap.begin(), m_heap.begin() + m_heapSize, [this](std::uint8_t a, std::uint8_t b) { return m_slots[a].deadlineUs > m_slots[b].deadlineUs; });
+}
+
+std::uint8_t RFScheduler::heapPop() {
+  std::pop_heap(m_heap.begin(), m_heap.begin() + m_heapSize, [this](std::uint8_t a, std::uint8_t b) { return m_slots[a].deadlineUs > m_slots[b].deadlineUs; });
+  return m_heap[--m_heapSize];
+}
@@ -1,33 +1,45 @@
 #include "radio/RFTransmitter.h"
 #include "EStopManager.h"
 
+#include "LatencyTrace.h"
 #include "Logging.h"
 #include "radio/rmt/MainEncoder.h"
 #include "Time.h"
 #include "util/TaskUtils.h"
 
 #include <freertos/FreeRTOS.h>
-#include <freertos/queue.h>
+#include <freertos/task.h>
+
+#include <algorithm>
 
 const char* const TAG = "RFTransmitter";
 
-const UBaseType_t RFTRANSMITTER_QUEUE_SIZE        = 64;
 const BaseType_t RFTRANSMITTER_TASK_PRIORITY      = 1;
 const std::uint32_t RFTRANSMITTER_TASK_STACK_SIZE = 4096;  // PROFILED: 1.4KB stack usage
 const float RFTRANSMITTER_TICKRATE_NS             = 1000;
-const std::int64_t TRANSMIT_END_DURATION          = 300;
+const std::int64_t TRANSMIT_END_DURATION          = 300'000;  // Microseconds
+const std::int64_t RFTRANSMITTER_PREPARE_LEAD_US  = 2000;     // How long before the radio frees up the next frame is prepared
 
 using namespace OpenShock;
 
-struct command_t {
-  std::int64_t until;
-  std::vector<rmt_data_t> sequence;
-  std::vector<rmt_data_t> zeroSequence;
-  std::uint16_t shockerId;
-  bool overwrite;
+// Guarantees each of 8 simultaneous shockers a frame at least every 500ms, anything slower is counted as a missed deadline
+const RFScheduler::Config RFTRANSMITTER_SCHEDULER_CONFIG = {
+  .policy                = RFScheduler::FairnessPolicy::RoundRobin,
+  .frameIntervalUs       = 500'000,
+  .transmitEndDurationUs = TRANSMIT_END_DURATION,
 };
 
-RFTransmitter::RFTransmitter(std::uint8_t gpioPin) : m_txPin(gpioPin), m_rmtHandle(nullptr), m_queueHandle(nullptr), m_taskHandle(nullptr) {
+RFTransmitter::RFTransmitter(std::uint8_t gpioPin, std::int8_t coreId) : m_txPin(gpioPin), m_rmtHandle(nullptr), m_taskHandle(nullptr)
+  , m_commands(std::make_unique<RFCommandRing>())
+  , m_stopRequested(false)
+  , m_scheduler(std::make_unique<RFScheduler>(RFTRANSMITTER_SCHEDULER_CONFIG))
+  , m_txBuffers()
+  , m_framesSent(0)
+  , m_burstsSent(0)
+  , m_lastInterFrameGapUs(0)
+  , m_maxInterFrameGapUs(0)
+  , m_lastLatencyUs(0)
+  , m_maxLatencyUs(0) {
   ESP_LOGD(TAG, "[pin-%u] Creating RFTransmitter", m_txPin);
 
   m_rmtHandle = rmtInit(gpioPin, RMT_TX_MODE, RMT_MEM_64);
@@ -40,17 +52,10 @@ RFTransmitter::RFTransmitter(std::uint8_t gpioPin) : m_txPin(gpioPin), m_rmtHand
   float realTick = rmtSetTick(m_rmtHandle, RFTRANSMITTER_TICKRATE_NS);
   ESP_LOGD(TAG, "[pin-%u] real tick set to: %fns", m_txPin, realTick);
 
-  m_queueHandle = xQueueCreate(RFTRANSMITTER_QUEUE_SIZE, sizeof(command_t*));
-  if (m_queueHandle == nullptr) {
-    ESP_LOGE(TAG, "[pin-%u] Failed to create queue", m_txPin);
-    destroy();
-    return;
-  }
-
   char name[32];
   snprintf(name, sizeof(name), "RFTransmitter-%u", m_txPin);
 
-  if (TaskUtils::TaskCreateExpensive(TransmitTask, name, RFTRANSMITTER_TASK_STACK_SIZE, this, RFTRANSMITTER_TASK_PRIORITY, &m_taskHandle) != pdPASS) {
+  if (TaskUtils::TaskCreateUniversal(TransmitTask, name, RFTRANSMITTER_TASK_STACK_SIZE, this, RFTRANSMITTER_TASK_PRIORITY, &m_taskHandle, coreId) != pdPASS) {
     ESP_LOGE(TAG, "[pin-%u] Failed to create task", m_txPin);
     destroy();
     return;
@@ -61,165 +66,243 @@ RFTransmitter::~RFTransmitter() {
   destroy();
 }
 
-bool RFTransmitter::SendCommand(ShockerModelType model, std::uint16_t shockerId, ShockerCommandType type, std::uint8_t intensity, std::uint16_t durationMs, bool overwriteExisting) {
-  if (m_queueHandle == nullptr) {
-    ESP_LOGE(TAG, "[pin-%u] Queue is null", m_txPin);
+bool RFTransmitter::SendCommand(ShockerModelType model, std::uint16_t shockerId, ShockerCommandType type, std::uint8_t intensity, std::uint16_t durationMs, bool overwriteExisting, std::uint32_t traceId) {
+  if (m_taskHandle == nullptr) {
+    ESP_LOGE(TAG, "[pin-%u] Task is not running", m_txPin);
     return false;
   }
 
-  command_t* cmd = new command_t {.until = OpenShock::millis() + durationMs, .sequence = Rmt::GetSequence(model, shockerId, type, intensity), .zeroSequence = Rmt::GetZeroSequence(model, shockerId), .shockerId = shockerId, .overwrite = overwriteExisting};
+  std::int64_t now = OpenShock::micros();
+
+  RFCommandRing::Command cmd {.model = model, .shockerId = shockerId, .overwrite = overwriteExisting, .untilUs = now + durationMs * 1000LL, .queuedUs = now, .traceId = traceId, .sequence = Rmt::GetSequence(model, shockerId, type, intensity), .zeroSequence = Rmt::GetZeroSequence(model, shockerId)};
 
-  // We will use nullptr commands to end the task, if we got a nullptr here, we are out of memory... :(
-  if (cmd == nullptr) {
-    ESP_LOGE(TAG, "[pin-%u] Failed to allocate command", m_txPin);
+  if (cmd.sequence.empty() || cmd.zeroSequence.empty()) {
+    ESP_LOGE(TAG, "[pin-%u] Unsupported shocker model or command type: %u %u", m_txPin, model, type);
     return false;
   }
 
-  // Add the command to the queue, wait max 10 ms (Adjust this)
-  if (xQueueSend(m_queueHandle, &cmd, pdMS_TO_TICKS(10)) != pdTRUE) {
-    ESP_LOGE(TAG, "[pin-%u] Failed to send command to queue", m_txPin);
-    delete cmd;
+  if (!m_commands->Push(cmd)) {
+    ESP_LOGE(TAG, "[pin-%u] Command ring is full", m_txPin);
     return false;
   }
 
+  LatencyTrace::Mark(traceId, LatencyTrace::Stage::Queued, OpenShock::micros());
+
+  xTaskNotifyGive(m_taskHandle);
+
   return true;
 }
 
-void RFTransmitter::ClearPendingCommands() {
-  if (m_queueHandle == nullptr) {
-    return;
-  }
+void RFTransmitter::GetSlotStats(std::vector<RFScheduler::SlotStats>& out) const {
+  m_scheduler->GetSlotStats(out);
+}
 
+RFTransmitter::TransmitStats RFTransmitter::GetTransmitStats() const {
+  return {
+    .txPin               = m_txPin,
+    .framesSent          = m_framesSent.load(std::memory_order_relaxed),
+    .burstsSent          = m_burstsSent.load(std::memory_order_relaxed),
+    .lastInterFrameGapUs = m_lastInterFrameGapUs.load(std::memory_order_relaxed),
+    .maxInterFrameGapUs  = m_maxInterFrameGapUs.load(std::memory_order_relaxed),
+    .lastLatencyUs       = m_lastLatencyUs.load(std::memory_order_relaxed),
+    .maxLatencyUs        = m_maxLatencyUs.load(std::memory_order_relaxed),
+    .commands            = m_commands->GetStats(),
+  };
+}
+
+void RFTransmitter::ClearPendingCommands() {
   ESP_LOGI(TAG, "[pin-%u] Clearing pending commands", m_txPin);
 
-  command_t* command;
-  while (xQueueReceive(m_queueHandle, &command, 0) == pdPASS) {
-    delete command;
-  }
+  m_commands->Cancel();
 }
 
 void RFTransmitter::destroy() {
   if (m_taskHandle != nullptr) {
     ESP_LOGD(TAG, "[pin-%u] Stopping task", m_txPin);
 
+    m_stopRequested.store(true, std::memory_order_release);
+    xTaskNotifyGive(m_taskHandle);
+
     // Wait for the task to stop
-    command_t* cmd = nullptr;
     while (eTaskGetState(m_taskHandle) != eDeleted) {
       vTaskDelay(pdMS_TO_TICKS(10));
-
-      // Send nullptr to stop the task gracefully
-      xQueueSend(m_queueHandle, &cmd, pdMS_TO_TICKS(10));
     }
 
     ESP_LOGD(TAG, "[pin-%u] Task stopped", m_txPin);
 
-    // Clear the queue
-    ClearPendingCommands();
-
     m_taskHandle = nullptr;
   }
-  if (m_queueHandle != nullptr) {
-    vQueueDelete(m_queueHandle);
-    m_queueHandle = nullptr;
-  }
   if (m_rmtHandle != nullptr) {
     rmtDeinit(m_rmtHandle);
     m_rmtHandle = nullptr;
   }
 }
 
+TickType_t _ticksUntil(std::int64_t deadlineUs) {
+  std::int64_t remainingUs = deadlineUs - OpenShock::micros();
+  if (remainingUs <= 0) {
+    return 0;
+  }
+
+  // Round up, waking up early would just spin
+  return pdMS_TO_TICKS((remainingUs + 999) / 1000);
+}
+
+struct PendingFrame {
+  std::int64_t submittedUs;
+  std::uint32_t traceId;
+  std::uint32_t offsetUs;     // Start of the frame within its burst
+  std::uint32_t endOffsetUs;  // End of the frame within its burst
+};
+
+void _recordSample(std::atomic<std::uint32_t>& last, std::atomic<std::uint32_t>& max, std::int64_t valueUs) {
+  std::uint32_t value = static_cast<std::uint32_t>(std::clamp<std::int64_t>(valueUs, 0, UINT32_MAX));
+
+  // Only the transmit task writes these, so no compare-exchange is needed
+  last.store(value, std::memory_order_relaxed);
+  if (value > max.load(std::memory_order_relaxed)) {
+    max.store(value, std::memory_order_relaxed);
+  }
+}
+
 void RFTransmitter::TransmitTask(void* arg) {
   RFTransmitter* transmitter = reinterpret_cast<RFTransmitter*>(arg);
   std::uint8_t m_txPin       = transmitter->m_txPin;  // This must be defined here, because the THIS_LOG macro uses it
   rmt_obj_t* rmtHandle       = transmitter->m_rmtHandle;
-  QueueHandle_t queueHandle  = transmitter->m_queueHandle;
+  RFCommandRing& commands    = *transmitter->m_commands;
+  RFScheduler& scheduler     = *transmitter->m_scheduler;
 
   ESP_LOGD(TAG, "[pin-%u] RMT loop running on core %d", m_txPin, xPortGetCoreID());
 
-  std::vector<command_t*> commands;
+  // The RMT peripheral clocks out a burst on its own, the task only has to hand it the next one once it is done.
+  // Burst end is estimated from the pulse durations, so the queue keeps being drained while a burst is on air.
+  std::size_t bufferIndex        = 0;      // Buffer that is on air, or was last
+  std::int64_t txEndUs           = 0;      // Estimated time the radio frees up
+  bool hasPending                = false;  // The other buffer holds a burst waiting for the radio
+  bool pendingWaited             = false;  // The pending burst was ready before the radio freed up
+  std::int64_t pendingPreparedUs = 0;
+  std::size_t pendingFrameCount  = 0;
+  std::array<PendingFrame, kMaxBurstFrames> pendingFrames;
+
+  RFCommandRing::Command cmd;
+
   while (true) {
-    // Receive commands
-    command_t* cmd = nullptr;
-    while (xQueueReceive(queueHandle, &cmd, commands.empty() ? portMAX_DELAY : 0) == pdTRUE) {
-      if (cmd == nullptr) {
-        ESP_LOGD(TAG, "[pin-%u] Received nullptr (stop command), cleaning up...", m_txPin);
+    // Sleep until a command arrives, the radio frees up, or the next frame is due
+    TickType_t waitTicks;
+    if (hasPending) {
+      waitTicks = _ticksUntil(txEndUs);
+    } else if (!scheduler.empty()) {
+      waitTicks = _ticksUntil(std::max(scheduler.NextDeadline(), txEndUs - RFTRANSMITTER_PREPARE_LEAD_US));
+    } else {
+      waitTicks = portMAX_DELAY;
+    }
 
-        for (auto it = commands.begin(); it != commands.end(); ++it) {
-          delete *it;
-        }
+    // Producers notify after every push
+    ulTaskNotifyTake(pdTRUE, waitTicks);
 
-        ESP_LOGD(TAG, "[pin-%u] Cleanup done, stopping task", m_txPin);
+    if (transmitter->m_stopRequested.load(std::memory_order_acquire)) {
+      ESP_LOGD(TAG, "[pin-%u] Received stop request, cleaning up...", m_txPin);
 
-        vTaskDelete(nullptr);
-        return;
-      }
+      scheduler.Clear();
+
+      // Let the frame on air finish, the peripheral reads from our buffer and is deinitialized right after this
+      vTaskDelay(_ticksUntil(txEndUs));
 
-      // Replace the command if it already exists
-      for (auto it = commands.begin(); it != commands.end(); ++it) {
-        const command_t* existingCmd = *it;
+      ESP_LOGD(TAG, "[pin-%u] Cleanup done, stopping task", m_txPin);
 
-        if (existingCmd->shockerId == cmd->shockerId) {
-          // Only replace the command if it should be overwritten
-          if (existingCmd->overwrite) {
-            delete *it;
-            *it = cmd;
-          } else {
-            delete cmd;
-          }
+      vTaskDelete(nullptr);
+      return;
+    }
 
-          cmd = nullptr;
+    // Receive commands
+    while (commands.Pop(cmd)) {
+      LatencyTrace::Mark(cmd.traceId, LatencyTrace::Stage::Dequeued, OpenShock::micros());
 
-          break;
-        }
+      if (!scheduler.Submit(cmd.model, cmd.shockerId, cmd.untilUs, cmd.sequence, cmd.zeroSequence, cmd.overwrite, cmd.queuedUs, cmd.traceId)) {
+        ESP_LOGV(TAG, "[pin-%u] Command for shocker %u was dropped", m_txPin, cmd.shockerId);
       }
+    }
+
+    if (OpenShock::EStopManager::IsEStopped()) {
+      std::int64_t eStoppedUs = EStopManager::WhenEStopped() * 1000LL;
 
-      // If the command was not replaced, add it to the queue
-      if (cmd != nullptr) {
-        commands.push_back(cmd);
+      scheduler.ExpireAll(eStoppedUs);
+
+      // A frame prepared before the E-Stop may still carry a command, drop it
+      if (hasPending && pendingPreparedUs < eStoppedUs) {
+        hasPending = false;
       }
     }
 
-    if(OpenShock::EStopManager::IsEStopped()) {
+    std::int64_t now = OpenShock::micros();
+
+    // Prepare the next burst in the idle buffer shortly before the radio frees up
+    std::array<RFScheduler::Transmission, kMaxBurstFrames> batch;
+    if (!hasPending && now >= txEndUs - RFTRANSMITTER_PREPARE_LEAD_US && scheduler.Pop(now, batch[0])) {
+      Burst& buffer = transmitter->m_txBuffers[bufferIndex ^ 1];
+      buffer.clear();
+
+      // Join every other due frame of the same protocol, the receivers of one model all understand its inter-frame gap
+      ShockerModelType model = batch[0].model;
+      std::uint16_t gap      = Rmt::GetInterFrameGap(model);
 
-      std::int64_t whenEStoppedTime = EStopManager::WhenEStopped();
+      std::size_t batchSize = 1;
+      while (batchSize < kMaxBurstFrames && scheduler.Pop(now, model, batch[batchSize])) {
+        ++batchSize;
+      }
+
+      pendingFrameCount = 0;
+      for (std::size_t i = 0; i < batchSize; ++i) {
+        PendingFrame& frame = pendingFrames[pendingFrameCount++];
 
-      for (auto it = commands.begin(); it != commands.end(); ++it) {
-        cmd = *it;
+        frame.submittedUs = batch[i].submittedUs;
+        frame.traceId     = batch[i].traceId;
+        frame.offsetUs    = buffer.duration();
+        frame.endOffsetUs = frame.offsetUs + batch[i].sequence->duration();
 
-        cmd->until = whenEStoppedTime;
+        buffer.append(*batch[i].sequence, gap);  // The burst buffer is sized for kMaxBurstFrames of the longest protocol
       }
+
+      pendingWaited     = batch[0].deadlineUs < txEndUs;
+      pendingPreparedUs = now;
+      hasPending        = true;
+
+      // Reschedule from when the burst is expected to leave the air, so a slot is never due while its own frame is still being sent
+      std::int64_t burstEndUs = std::max(now, txEndUs) + buffer.duration();
+      for (std::size_t i = 0; i < batchSize; ++i) {
+        scheduler.Complete(batch[i], burstEndUs);
+      }
+    }
+
+    if (!hasPending || now < txEndUs) {
+      continue;
     }
 
-    // Send queued commands
-    for (auto it = commands.begin(); it != commands.end();) {
-      cmd = *it;
-
-      bool expired = cmd->until < OpenShock::millis();
-      bool empty   = cmd->sequence.empty();
-
-      // Remove expired or empty commands, else send the command.
-      // After sending/receiving a command, move to the next one.
-      if (expired || empty) {
-        // If the command is not empty, send the zero sequence to stop the shocker
-        if (!empty) {
-          rmtWriteBlocking(rmtHandle, cmd->zeroSequence.data(), cmd->zeroSequence.size());
-        }
-
-        if(cmd->until + TRANSMIT_END_DURATION < OpenShock::millis()) {
-          // Remove the command and move to the next one
-          it = commands.erase(it);
-          delete cmd;
-        } else {
-          // Move to the next command
-          ++it;
-        }
-      } else {
-        // Send the command
-        rmtWriteBlocking(rmtHandle, cmd->sequence.data(), cmd->sequence.size());
-
-        // Move to the next command
-        ++it;
+    bufferIndex ^= 1;
+    hasPending = false;
+
+    Burst& buffer = transmitter->m_txBuffers[bufferIndex];
+    if (!rmtWrite(rmtHandle, buffer.data(), buffer.size())) {
+      ESP_LOGE(TAG, "[pin-%u] Failed to write burst", m_txPin);
+      continue;
+    }
+
+    std::int64_t startUs = OpenShock::micros();
+
+    transmitter->m_burstsSent.fetch_add(1, std::memory_order_relaxed);
+    transmitter->m_framesSent.fetch_add(pendingFrameCount, std::memory_order_relaxed);
+    if (pendingWaited) {
+      _recordSample(transmitter->m_lastInterFrameGapUs, transmitter->m_maxInterFrameGapUs, startUs - txEndUs);
+    }
+    for (std::size_t i = 0; i < pendingFrameCount; ++i) {
+      if (pendingFrames[i].submittedUs != 0) {
+        _recordSample(transmitter->m_lastLatencyUs, transmitter->m_maxLatencyUs, startUs + pendingFrames[i].offsetUs - pendingFrames[i].submittedUs);
       }
+
+      // There is no completion callback, so the frame end is estimated like txEndUs
+      LatencyTrace::Mark(pendingFrames[i].traceId, LatencyTrace::Stage::Transmitted, startUs + pendingFrames[i].endOffsetUs);
     }
+
+    txEndUs = startUs + buffer.duration();
   }
 }
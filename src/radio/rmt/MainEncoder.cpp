@@ -1,55 +1,88 @@
 #include "radio/rmt/MainEncoder.h"
 
-#include "Logging.h"
-#include "radio/rmt/CaiXianlinEncoder.h"
-#include "radio/rmt/PetrainerEncoder.h"
-#include "radio/rmt/Petrainer998DREncoder.h"
+using namespace OpenShock;
 
-#include <unordered_map>
+// Golden frames, decoded back into bits at compile time so an encoder change can not silently alter what goes on air.
+// Field layouts follow https://wiki.openshock.org/hardware/shockers/
 
-const char* const TAG = "RmtMainEncoder";
+constexpr bool _checkPetrainerFrame(std::uint16_t shockerId, ShockerCommandType type, std::uint8_t intensity, std::uint64_t expected) {
+  using namespace Rmt::PetrainerEncoder;
 
-using namespace OpenShock;
+  Frame frame = GetSequence(shockerId, type, intensity);
+  if (frame.size() != kPulseCount || !Rmt::Internal::PulseEquals(frame.pulses[0], kRmtPreamble) || !Rmt::Internal::PulseEquals(frame.pulses[kPulseCount - 1], kRmtPostamble)) {
+    return false;
+  }
 
-std::vector<rmt_data_t> Rmt::GetSequence(ShockerModelType model, std::uint16_t shockerId, ShockerCommandType type, std::uint8_t intensity) {
-  switch (model) {
-    case ShockerModelType::Petrainer:
-      return Rmt::PetrainerEncoder::GetSequence(shockerId, type, intensity);
-    case ShockerModelType::Petrainer998DR:
-      return Rmt::Petrainer998DREncoder::GetSequence(shockerId, type, intensity);
-    case ShockerModelType::CaiXianlin:
-      return Rmt::CaiXianlinEncoder::GetSequence(shockerId, 0, type, intensity);
-    default:
-      ESP_LOGE(TAG, "Unknown shocker model: %u", model);
-      return {};
+  std::uint64_t data = 0;
+  if (!Rmt::Internal::DecodeBits<40>(frame, 1, data, kRmtOne, kRmtZero) || data != expected) {
+    return false;
   }
+
+  // [type:8][shockerId:16][intensity:8][typeSum:8], typeSum mirrors and inverts the type bits
+  std::uint8_t typeVal = static_cast<std::uint8_t>(data >> 32);
+  std::uint8_t typeSum = static_cast<std::uint8_t>(data);
+  std::uint8_t mirror  = 0;
+  for (int i = 0; i < 8; ++i) {
+    mirror |= ((typeVal >> i) & 1) << (7 - i);
+  }
+
+  return static_cast<std::uint8_t>(~mirror) == typeSum && static_cast<std::uint16_t>(data >> 16) == shockerId && static_cast<std::uint8_t>(data >> 8) == intensity;
 }
-/*
-std::shared_ptr<std::vector<rmt_data_t>> Rmt::GetZeroSequence(ShockerModelType model, std::uint16_t shockerId) {
-  static std::unordered_map<std::uint16_t, std::shared_ptr<std::vector<rmt_data_t>>> _sequences;
-
-  auto it = _sequences.find(shockerId);
-  if (it != _sequences.end()) return it->second; // FIXME: This is not thread-safe, and does not check if model is the same, causing a protocol mismatch
-
-  std::shared_ptr<std::vector<rmt_data_t>> sequence;
-  switch (model) {
-    case ShockerModelType::Petrainer:
-      sequence = std::make_shared<std::vector<rmt_data_t>>(Rmt::PetrainerEncoder::GetSequence(shockerId, ShockerCommandType::Vibrate, 0));
-      break;
-    case ShockerModelType::Petrainer998DR:
-      sequence = std::make_shared<std::vector<rmt_data_t>>(Rmt::Petrainer998DREncoder::GetSequence(shockerId, ShockerCommandType::Vibrate, 0));
-      break;
-    case ShockerModelType::CaiXianlin:
-      sequence = std::make_shared<std::vector<rmt_data_t>>(Rmt::CaiXianlinEncoder::GetSequence(shockerId, 0, ShockerCommandType::Vibrate, 0));
-      break;
-    default:
-      ESP_LOGE(TAG, "Unknown shocker model: %u", model);
-      sequence = nullptr;
-      break;
-  }
-
-  _sequences[shockerId] = sequence;
-
-  return sequence;
+
+constexpr bool _checkPetrainer998DRFrame(std::uint16_t shockerId, ShockerCommandType type, std::uint8_t intensity, std::uint64_t expected) {
+  using namespace Rmt::Petrainer998DREncoder;
+
+  Frame frame = GetSequence(shockerId, type, intensity);
+  if (frame.size() != kPulseCount || !Rmt::Internal::PulseEquals(frame.pulses[0], kRmtPreamble) || !Rmt::Internal::PulseEquals(frame.pulses[1], kRmtOne) || !Rmt::Internal::PulseEquals(frame.pulses[kPulseCount - 1], kRmtPostamble)) {
+    return false;
+  }
+
+  std::uint64_t data = 0;
+  if (!Rmt::Internal::DecodeBits<38>(frame, 2, data, kRmtOne, kRmtZero) || data != expected) {
+    return false;
+  }
+
+  // [channel:3][type:4][shockerId:17][intensity:7][typeInvert:4][channelInvert:3], the trailing fields are the leading ones bit-reversed and inverted
+  std::uint8_t channel       = (data >> 35) & 0b111;
+  std::uint8_t typeVal       = (data >> 31) & 0b1111;
+  std::uint8_t typeInvert    = (data >> 3) & 0b1111;
+  std::uint8_t channelInvert = data & 0b111;
+
+  std::uint8_t typeMirror    = 0;
+  std::uint8_t channelMirror = 0;
+  for (int i = 0; i < 4; ++i) {
+    typeMirror |= ((typeVal >> i) & 1) << (3 - i);
+  }
+  for (int i = 0; i < 3; ++i) {
+    channelMirror |= ((channel >> i) & 1) << (2 - i);
+  }
+
+  return (~typeMirror & 0b1111) == typeInvert && (~channelMirror & 0b111) == channelInvert && ((data >> 14) & 0x1FFFF) == shockerId && ((data >> 7) & 0x7F) == intensity;
+}
+
+constexpr bool _checkCaiXianlinFrame(std::uint16_t transmitterId, std::uint8_t channelId, ShockerCommandType type, std::uint8_t intensity, std::uint64_t expected) {
+  using namespace Rmt::CaiXianlinEncoder;
+
+  Frame frame = GetSequence(transmitterId, channelId, type, intensity);
+  if (frame.size() != kPulseCount || !Rmt::Internal::PulseEquals(frame.pulses[0], kRmtPreamble)) {
+    return false;
+  }
+
+  std::uint64_t data = 0;
+  if (!Rmt::Internal::DecodeBits<43>(frame, 1, data, kRmtOne, kRmtZero) || data != expected) {
+    return false;
+  }
+
+  // [transmitterId:16][channelId:4][type:4][intensity:8][checksum:8][postamble:3], checksum is the byte sum of the payload
+  std::uint32_t payload = static_cast<std::uint32_t>(data >> 11);
+  std::uint8_t checksum = static_cast<std::uint8_t>(data >> 3);
+  std::uint8_t byteSum  = static_cast<std::uint8_t>((payload >> 24) + (payload >> 16) + (payload >> 8) + payload);
+
+  return (data & 0b111) == 0 && checksum == byteSum && static_cast<std::uint16_t>(payload >> 16) == transmitterId && ((payload >> 12) & 0xF) == channelId && static_cast<std::uint8_t>(payload) == intensity;
 }
-*/
+
+static_assert(_checkPetrainerFrame(0x1234, ShockerCommandType::Shock, 50, 0x81'1234'32'7E), "Petrainer shock frame changed");
+static_assert(_checkPetrainerFrame(0xBEEF, ShockerCommandType::Vibrate, 100, 0x82'BEEF'64'BE), "Petrainer vibrate frame changed");
+static_assert(_checkPetrainerFrame(0x0001, ShockerCommandType::Sound, 0, 0x84'0001'00'DE), "Petrainer sound frame changed");
+static_assert(_checkPetrainer998DRFrame(0x1234, ShockerCommandType::Vibrate, 50, 0x1'048D'195F), "Petrainer998DR vibrate frame changed");
+static_assert(_checkCaiXianlinFrame(0x1234, 0, ShockerCommandType::Shock, 50, 0x91'A009'93C8), "CaiXianlin shock frame changed");
@@ -1,12 +1,18 @@
 #include "serial/SerialInputHandler.h"
 
+#include "CaptivePortal.h"
 #include "Chipset.h"
 #include "CommandHandler.h"
 #include "config/Config.h"
 #include "config/SerialInputConfig.h"
+#include "event_handlers/WebSocket.h"
 #include "FormatHelpers.h"
+#include "GatewayConnectionManager.h"
 #include "http/HTTPRequestManager.h"
+#include "LatencyTrace.h"
 #include "Logging.h"
+#include "ReadWriteMutex.h"
+#include "serialization/BuilderPool.h"
 #include "serialization/JsonAPI.h"
 #include "serialization/JsonSerial.h"
 #include "StringView.h"
@@ -521,6 +527,74 @@ void _handleDebugInfoCommand(StringView arg) {
   const std::int64_t days    = hours / 24;
   SERPR_RESPONSE("RTOSInfo|Uptime|%llid %llih %llim %llis", days, hours % 24, minutes % 60, seconds % 60);
 
+  std::vector<OpenShock::RFScheduler::SlotStats> slotStats;
+  if (OpenShock::CommandHandler::GetRfSlotStats(slotStats)) {
+    for (const auto& slot : slotStats) {
+      SERPR_RESPONSE("RFInfo|Slot %u|Frames Sent %u, Missed Deadlines %u", slot.shockerId, slot.framesSent, slot.missedDeadlines);
+    }
+  }
+
+  std::vector<OpenShock::RFTransmitter::TransmitStats> transmitStats;
+  if (OpenShock::CommandHandler::GetRfTransmitStats(transmitStats)) {
+    for (const auto& stats : transmitStats) {
+      SERPR_RESPONSE("RFInfo|Pin %u Frames Sent|%u", stats.txPin, stats.framesSent);
+      SERPR_RESPONSE("RFInfo|Pin %u Bursts Sent|%u", stats.txPin, stats.burstsSent);
+      SERPR_RESPONSE("RFInfo|Pin %u Inter-Frame Gap|%uus (max %uus)", stats.txPin, stats.lastInterFrameGapUs, stats.maxInterFrameGapUs);
+      SERPR_RESPONSE("RFInfo|Pin %u Command Latency|%uus (max %uus)", stats.txPin, stats.lastLatencyUs, stats.maxLatencyUs);
+      SERPR_RESPONSE("RFInfo|Pin %u Commands|Queued %u, Coalesced %u, Dropped %u", stats.txPin, stats.commands.pushed, stats.commands.coalesced, stats.commands.dropped);
+    }
+  }
+
+  std::vector<OpenShock::EventHandlers::WebSocket::VerifyStats> verifyStats;
+  OpenShock::EventHandlers::WebSocket::GetGatewayVerifyStats(verifyStats);
+  for (const auto& stats : verifyStats) {
+    SERPR_RESPONSE("WSInfo|Gateway %s|Messages %u, Rejected %u, Largest %u bytes, Verify %uus total (max %uus)", stats.payloadType, stats.messages, stats.rejected, stats.largestSize, stats.totalVerifyUs, stats.maxVerifyUs);
+  }
+
+  verifyStats.clear();
+  OpenShock::EventHandlers::WebSocket::GetLocalVerifyStats(verifyStats);
+  for (const auto& stats : verifyStats) {
+    SERPR_RESPONSE("WSInfo|Local %s|Messages %u, Rejected %u, Largest %u bytes, Verify %uus total (max %uus)", stats.payloadType, stats.messages, stats.rejected, stats.largestSize, stats.totalVerifyUs, stats.maxVerifyUs);
+  }
+
+  OpenShock::Serialization::BuilderPool::PoolStats poolStats;
+  std::vector<OpenShock::Serialization::BuilderPool::MessageStats> messageStats;
+  OpenShock::Serialization::BuilderPool::GetStats(poolStats, messageStats);
+  SERPR_RESPONSE("WSInfo|Builder Pool|Leases %u, Fallbacks %u", poolStats.leases, poolStats.fallbacks);
+  for (const auto& stats : messageStats) {
+    SERPR_RESPONSE("WSInfo|Builder %s|Uses %u, High Water %u bytes", stats.name, stats.uses, stats.highWaterMark);
+  }
+
+  OpenShock::GatewayOutboundQueue::Stats outboundStats;
+  if (OpenShock::GatewayConnectionManager::GetOutboundStats(outboundStats)) {
+    SERPR_RESPONSE("WSInfo|Gateway Outbound Queue|Depth %u (max %u), Queued %u, Coalesced %u, Dropped %u", outboundStats.depth, outboundStats.maxDepth, outboundStats.queued, outboundStats.coalesced, outboundStats.dropped);
+    SERPR_RESPONSE("WSInfo|Gateway Outbound Sends|Sent %u, Failed %u, Requeued %u, Latency %uus (max %uus), Longest Write %uus", outboundStats.sent, outboundStats.sendFailures, outboundStats.requeued, outboundStats.lastLatencyUs, outboundStats.maxLatencyUs, outboundStats.maxSendUs);
+  }
+
+  OpenShock::LocalOutboundQueue::Stats localOutboundStats;
+  if (OpenShock::CaptivePortal::GetOutboundStats(localOutboundStats)) {
+    SERPR_RESPONSE("WSInfo|Local Outbound Queue|Clients %u, Max Depth %u, Broadcasts %u, Unicasts %u, Dropped %u", localOutboundStats.clients, localOutboundStats.maxDepth, localOutboundStats.broadcasts, localOutboundStats.unicasts, localOutboundStats.dropped);
+    SERPR_RESPONSE("WSInfo|Local Outbound Sends|Sent %u, Failed %u, Latency %uus (max %uus), Longest Write %uus", localOutboundStats.sent, localOutboundStats.sendFailures, localOutboundStats.lastLatencyUs, localOutboundStats.maxLatencyUs, localOutboundStats.maxSendUs);
+  }
+
+  std::uint32_t localTaskWakeups;
+  if (OpenShock::CaptivePortal::GetTaskWakeups(localTaskWakeups)) {
+    SERPR_RESPONSE("WSInfo|Local Task|Wakeups %u", localTaskWakeups);
+  }
+
+  OpenShock::Config::PersistStats persistStats;
+  OpenShock::Config::GetPersistStats(persistStats);
+  SERPR_RESPONSE("ConfigInfo|Flash Writes|%u for %u changes, Sections %u, Failed %u", persistStats.flashWrites, persistStats.changes, persistStats.sectionsWritten, persistStats.writeFailures);
+  SERPR_RESPONSE("ConfigInfo|Flash Write Time|%uus (max %uus)", persistStats.lastWriteUs, persistStats.maxWriteUs);
+  SERPR_RESPONSE("ConfigInfo|Setter Latency|%uus (max %uus)", persistStats.lastSetterUs, persistStats.maxSetterUs);
+
+  std::vector<OpenShock::ReadWriteMutex::Stats> lockStats;
+  OpenShock::ReadWriteMutex::GetAllStats(lockStats);
+  for (const auto& stats : lockStats) {
+    SERPR_RESPONSE("LockInfo|%s|Reads %u, Writes %u, Contended %u, Timeouts %u", stats.name, stats.readLocks, stats.writeLocks, stats.contended, stats.timeouts);
+    SERPR_RESPONSE("LockInfo|%s Timing|Wait %uus total (max %uus), Max Hold %uus read, %uus write", stats.name, stats.totalWaitUs, stats.maxWaitUs, stats.maxReadHoldUs, stats.maxWriteHoldUs);
+  }
+
   OpenShock::WiFiNetwork network;
   bool connected = OpenShock::WiFiManager::GetConnectedNetwork(network);
   SERPR_RESPONSE("WiFiInfo|Connected|%s", connected ? "true" : "false");
@@ -565,6 +639,27 @@ void _handleRFTransmitCommand(StringView arg) {
   SERPR_SUCCESS("Command sent");
 }
 
+void _handleLatencyCommand(StringView arg) {
+  arg = arg.trim();
+  if (arg == "reset") {
+    OpenShock::LatencyTrace::Reset();
+    SERPR_SUCCESS("Latency traces cleared");
+    return;
+  }
+
+  if (!arg.isNullOrEmpty()) {
+    SERPR_ERROR("Invalid argument");
+    return;
+  }
+
+  std::vector<OpenShock::LatencyTrace::StageStats> stageStats;
+  OpenShock::LatencyTrace::GetStageStats(stageStats);
+
+  for (const auto& stats : stageStats) {
+    SERPR_RESPONSE("Latency|%s|Count %u, p50 %uus, p95 %uus, p99 %uus", stats.name, stats.count, stats.p50Us, stats.p95Us, stats.p99Us);
+  }
+}
+
 void _handleHelpCommand(StringView arg) {
   arg = arg.trim();
   if (arg.isNullOrEmpty()) {
@@ -595,6 +690,8 @@ jsonconfig   <json>    set configuration from JSON
 rawconfig              get raw configuration as base64
 rawconfig    <base64>  set raw configuration from base64
 rftransmit   <json>    transmit a RF command
+latency                print command latency percentiles per stage
+latency      reset     clear recorded latency traces
 factoryreset           reset device to factory defaults and restart
 )");
     return;
@@ -801,6 +898,19 @@ static const SerialCmdHandler kRfTransmitCmdHandler = {
 )",
   _handleRFTransmitCommand,
 };
+static const SerialCmdHandler kLatencyCmdHandler = {
+  "latency"_sv,
+  R"(latency
+  Print p50/p95/p99 of the time gateway commands spend between each stage on their way to the radio.
+  Stages are Received, Verified, Handled, Queued, Dequeued and Transmitted, each line covers the time since the previous stage.
+
+latency reset
+  Clear recorded latency traces.
+  Example:
+    latency reset
+)",
+  _handleLatencyCommand,
+};
 static const SerialCmdHandler kFactoryResetCmdHandler = {
   "factoryreset"_sv,
   R"(factoryreset
@@ -903,6 +1013,7 @@ bool SerialInputHandler::Init() {
   RegisterCommandHandler(kJsonConfigCmdHandler);
   RegisterCommandHandler(kRawConfigCmdHandler);
   RegisterCommandHandler(kRfTransmitCmdHandler);
+  RegisterCommandHandler(kLatencyCmdHandler);
   RegisterCommandHandler(kFactoryResetCmdHandler);
   RegisterCommandHandler(khelpCmdHandler);
 
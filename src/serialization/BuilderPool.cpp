@@ -0,0 +1,111 @@
+#include "serialization/BuilderPool.h"
+
+#include "Logging.h"
+
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
+#include <array>
+
+const char* const TAG = "BuilderPool";
+
+const std::size_t MESSAGE_STATS_SIZE = 16;  // Distinct message names tracked, later names are not tracked
+
+using namespace OpenShock::Serialization;
+
+static SemaphoreHandle_t s_poolMutex = xSemaphoreCreateMutex();
+static std::array<flatbuffers::FlatBufferBuilder*, BuilderPool::POOL_SIZE> s_builders {};  // Created on first use, never freed
+static std::array<bool, BuilderPool::POOL_SIZE> s_buildersInUse {};
+static std::array<BuilderPool::MessageStats, MESSAGE_STATS_SIZE> s_messageStats {};
+static BuilderPool::PoolStats s_poolStats {};
+
+int _acquireIndex() {
+  for (std::size_t i = 0; i < BuilderPool::POOL_SIZE; ++i) {
+    if (s_buildersInUse[i]) {
+      continue;
+    }
+
+    if (s_builders[i] == nullptr) {
+      s_builders[i] = new flatbuffers::FlatBufferBuilder(BuilderPool::BUILDER_INITIAL_SIZE);
+    }
+
+    s_buildersInUse[i] = true;
+    return static_cast<int>(i);
+  }
+
+  return -1;
+}
+
+void _recordMessage(const char* messageName, std::uint32_t size) {
+  for (auto& stats : s_messageStats) {
+    // Names are static strings, so comparing pointers is enough
+    if (stats.name == nullptr) {
+      stats.name = messageName;
+    } else if (stats.name != messageName) {
+      continue;
+    }
+
+    ++stats.uses;
+    if (size > stats.highWaterMark) {
+      stats.highWaterMark = size;
+    }
+
+    return;
+  }
+}
+
+BuilderPool::Lease::Lease(const char* messageName) : m_messageName(messageName), m_poolIndex(-1), m_builder(nullptr) {
+  xSemaphoreTake(s_poolMutex, portMAX_DELAY);
+
+  ++s_poolStats.leases;
+
+  m_poolIndex = _acquireIndex();
+  if (m_poolIndex >= 0) {
+    m_builder = s_builders[m_poolIndex];
+  } else {
+    ++s_poolStats.fallbacks;
+  }
+
+  xSemaphoreGive(s_poolMutex);
+
+  if (m_builder == nullptr) {
+    ESP_LOGW(TAG, "Pool exhausted, allocating a temporary builder for %s", messageName);
+    m_builder = new flatbuffers::FlatBufferBuilder(BUILDER_INITIAL_SIZE);
+  }
+}
+
+BuilderPool::Lease::~Lease() {
+  std::uint32_t size = m_builder->GetSize();
+
+  if (m_poolIndex < 0) {
+    delete m_builder;
+  } else if (size > BUILDER_MAX_RETAINED_SIZE) {
+    m_builder->Reset();  // Frees the buffer, the next use allocates BUILDER_INITIAL_SIZE again
+  } else {
+    m_builder->Clear();  // Keeps the buffer
+  }
+
+  xSemaphoreTake(s_poolMutex, portMAX_DELAY);
+
+  _recordMessage(m_messageName, size);
+
+  if (m_poolIndex >= 0) {
+    s_buildersInUse[m_poolIndex] = false;
+  }
+
+  xSemaphoreGive(s_poolMutex);
+}
+
+void BuilderPool::GetStats(PoolStats& poolStats, std::vector<MessageStats>& messageStats) {
+  xSemaphoreTake(s_poolMutex, portMAX_DELAY);
+
+  poolStats = s_poolStats;
+
+  for (const auto& stats : s_messageStats) {
+    if (stats.name != nullptr) {
+      messageStats.push_back(stats);
+    }
+  }
+
+  xSemaphoreGive(s_poolMutex);
+}
@@ -2,6 +2,7 @@
 
 #include "config/Config.h"
 #include "Logging.h"
+#include "serialization/BuilderPool.h"
 #include "Time.h"
 
 const char* const TAG = "WSGateway";
@@ -9,7 +10,8 @@ const char* const TAG = "WSGateway";
 using namespace OpenShock::Serialization;
 
 bool Gateway::SerializeKeepAliveMessage(Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease("KeepAlive");
+  flatbuffers::FlatBufferBuilder& builder = *lease;
 
   std::int64_t uptime = OpenShock::millis();
   if (uptime < 0) {
@@ -30,7 +32,8 @@ bool Gateway::SerializeKeepAliveMessage(Common::SerializationCallbackFn callback
 }
 
 bool Gateway::SerializeBootStatusMessage(std::int32_t updateId, OpenShock::FirmwareBootType bootType, const OpenShock::SemVer& version, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease("BootStatus");
+  flatbuffers::FlatBufferBuilder& builder = *lease;
 
   auto fbsVersion = Types::CreateSemVerDirect(builder, version.major, version.minor, version.patch, version.prerelease.data(), version.build.data());
 
@@ -46,7 +49,8 @@ bool Gateway::SerializeBootStatusMessage(std::int32_t updateId, OpenShock::Firmw
 }
 
 bool Gateway::SerializeOtaInstallStartedMessage(std::int32_t updateId, const OpenShock::SemVer& version, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease("OtaInstallStarted");
+  flatbuffers::FlatBufferBuilder& builder = *lease;
 
   auto versionOffset = Types::CreateSemVerDirect(builder, version.major, version.minor, version.patch, version.prerelease.data(), version.build.data());
 
@@ -62,7 +66,8 @@ bool Gateway::SerializeOtaInstallStartedMessage(std::int32_t updateId, const Ope
 }
 
 bool Gateway::SerializeOtaInstallProgressMessage(std::int32_t updateId, Gateway::OtaInstallProgressTask task, float progress, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(64);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease("OtaInstallProgress");
+  flatbuffers::FlatBufferBuilder& builder = *lease;
 
   auto otaInstallProgressOffset = Gateway::CreateOtaInstallProgress(builder, updateId, task, progress);
 
@@ -76,7 +81,8 @@ bool Gateway::SerializeOtaInstallProgressMessage(std::int32_t updateId, Gateway:
 }
 
 bool Gateway::SerializeOtaInstallFailedMessage(std::int32_t updateId, StringView message, bool fatal, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease("OtaInstallFailed");
+  flatbuffers::FlatBufferBuilder& builder = *lease;
 
   auto messageOffset = builder.CreateString(message.data(), message.size());
 
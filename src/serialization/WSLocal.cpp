@@ -2,6 +2,7 @@
 
 #include "config/Config.h"
 #include "Logging.h"
+#include "serialization/BuilderPool.h"
 #include "util/HexUtils.h"
 #include "wifi/WiFiNetwork.h"
 
@@ -45,8 +46,20 @@ flatbuffers::Offset<OpenShock::Serialization::Types::WifiNetwork> _createWiFiNet
   return Types::CreateWifiNetworkDirect(builder, network.ssid, bssid.data(), network.channel, network.rssi, authMode, network.IsSaved());
 }
 
+std::vector<Local::WifiNetworkDelta> _createWiFiNetworkDeltas(const std::vector<const OpenShock::WiFiNetwork*>& networks) {
+  std::vector<Local::WifiNetworkDelta> deltas;
+  deltas.reserve(networks.size());
+
+  for (const OpenShock::WiFiNetwork* network : networks) {
+    deltas.emplace_back(flatbuffers::make_span(network->bssid), network->channel, network->rssi);
+  }
+
+  return deltas;
+}
+
 bool Local::SerializeErrorMessage(const char* message, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease("ErrorMessage");
+  flatbuffers::FlatBufferBuilder& builder = *lease;
 
   auto wrapperOffset = Local::CreateErrorMessage(builder, builder.CreateString(message));
 
@@ -62,7 +75,8 @@ bool Local::SerializeErrorMessage(const char* message, Common::SerializationCall
 }
 
 bool Local::SerializeReadyMessage(const WiFiNetwork* connectedNetwork, bool accountLinked, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);
+  BuilderPool::Lease lease("ReadyMessage");
+  flatbuffers::FlatBufferBuilder& builder = *lease;
 
   flatbuffers::Offset<Serialization::Types::WifiNetwork> fbsNetwork = 0;
 
@@ -90,7 +104,8 @@ bool Local::SerializeReadyMessage(const WiFiNetwork* connectedNetwork, bool acco
 }
 
 bool Local::SerializeWiFiScanStatusChangedEvent(OpenShock::WiFiScanStatus status, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(32);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease("WifiScanStatus");
+  flatbuffers::FlatBufferBuilder& builder = *lease;
 
   Serialization::Local::WifiScanStatusMessage scanStatus(status);
   auto scanStatusOffset = builder.CreateStruct(scanStatus);
@@ -105,7 +120,8 @@ bool Local::SerializeWiFiScanStatusChangedEvent(OpenShock::WiFiScanStatus status
 }
 
 bool Local::SerializeWiFiNetworkEvent(Types::WifiNetworkEventType eventType, const WiFiNetwork& network, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease("WifiNetworkEvent");
+  flatbuffers::FlatBufferBuilder& builder = *lease;
 
   auto networkOffset = _createWiFiNetwork(builder, network);
 
@@ -121,7 +137,8 @@ bool Local::SerializeWiFiNetworkEvent(Types::WifiNetworkEventType eventType, con
 }
 
 bool Local::SerializeWiFiNetworksEvent(Types::WifiNetworkEventType eventType, const std::vector<WiFiNetwork>& networks, Common::SerializationCallbackFn callback) {
-  flatbuffers::FlatBufferBuilder builder(256);  // TODO: Profile this and adjust the size accordingly
+  BuilderPool::Lease lease("WifiNetworksEvent");
+  flatbuffers::FlatBufferBuilder& builder = *lease;
 
   std::vector<flatbuffers::Offset<Serialization::Types::WifiNetwork>> fbsNetworks;
   fbsNetworks.reserve(networks.size());
@@ -140,3 +157,22 @@ bool Local::SerializeWiFiNetworksEvent(Types::WifiNetworkEventType eventType, co
 
   return callback(span.data(), span.size());
 }
+
+bool Local::SerializeWiFiNetworkDeltaEvent(std::uint32_t generation, const std::vector<const WiFiNetwork*>& updated, const std::vector<const WiFiNetwork*>& lost, Common::SerializationCallbackFn callback) {
+  BuilderPool::Lease lease("WifiNetworkDeltaEvent");
+  flatbuffers::FlatBufferBuilder& builder = *lease;
+
+  // Networks are keyed by BSSID, clients already have the rest of the record from the event that discovered it
+  auto updatedDeltas = _createWiFiNetworkDeltas(updated);
+  auto lostDeltas    = _createWiFiNetworkDeltas(lost);
+
+  auto wrapperOffset = Local::CreateWifiNetworkDeltaEventDirect(builder, generation, &updatedDeltas, &lostDeltas);
+
+  auto msg = Local::CreateHubToLocalMessage(builder, Local::HubToLocalMessagePayload::WifiNetworkDeltaEvent, wrapperOffset.Union());
+
+  builder.Finish(msg);
+
+  auto span = builder.GetBufferSpan();
+
+  return callback(span.data(), span.size());
+}
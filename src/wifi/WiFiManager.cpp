@@ -12,14 +12,21 @@
 
 #include <WiFi.h>
 
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+
 #include <esp_wifi.h>
 #include <esp_wifi_types.h>
 
+#include <algorithm>
 #include <cstdint>
+#include <cstdlib>
 #include <vector>
 
 const char* const TAG = "WiFiManager";
 
+const std::int8_t RSSI_REPORT_THRESHOLD = 4;  // dBm, RSSI jitters by a few dBm between scans, smaller drifts are not worth a broadcast
+
 using namespace OpenShock;
 
 enum class WiFiState : std::uint8_t {
@@ -33,6 +40,8 @@ static std::uint8_t s_connectedBSSID[6]      = {0};
 static std::uint8_t s_connectedCredentialsID = 0;
 static std::uint8_t s_preferredCredentialsID = 0;
 static std::vector<WiFiNetwork> s_wifiNetworks;
+static std::uint32_t s_wifiNetworksGeneration = 0;  // Bumped every time s_wifiNetworks changes in a way clients can see
+static SemaphoreHandle_t s_wifiNetworksMutex  = xSemaphoreCreateMutex();  // Held across a table change, its generation bump and the broadcast describing it
 
 bool _isZeroBSSID(const std::uint8_t (&bssid)[6]) {
   for (std::size_t i = 0; i < sizeof(bssid); i++) {
@@ -244,28 +253,49 @@ void _evWiFiScanStarted() { }
 void _evWiFiScanStatusChanged(OpenShock::WiFiScanStatus status) {
   // If the scan started, remove any networks that have not been seen in 3 scans
   if (status == OpenShock::WiFiScanStatus::Started) {
-    for (auto it = s_wifiNetworks.begin(); it != s_wifiNetworks.end();) {
-      if (it->scansMissed++ > 3) {
+    xSemaphoreTake(s_wifiNetworksMutex, portMAX_DELAY);
+
+    for (auto& net : s_wifiNetworks) {
+      ++net.scansMissed;
+    }
+
+    // Move the lost networks to the back, keeping the RSSI order, so they can be reported in one event and erased together
+    auto lostBegin = std::stable_partition(s_wifiNetworks.begin(), s_wifiNetworks.end(), [](const WiFiNetwork& net) { return net.scansMissed <= 4; });
+    if (lostBegin != s_wifiNetworks.end()) {
+      std::vector<const WiFiNetwork*> lostNetworks;
+      lostNetworks.reserve(std::distance(lostBegin, s_wifiNetworks.end()));
+
+      for (auto it = lostBegin; it != s_wifiNetworks.end(); ++it) {
         ESP_LOGV(TAG, "Network %s (" BSSID_FMT ") has not been seen in 3 scans, removing from list", it->ssid, BSSID_ARG(it->bssid));
-        Serialization::Local::SerializeWiFiNetworkEvent(Serialization::Types::WifiNetworkEventType::Lost, *it, CaptivePortal::BroadcastMessageBIN);
-        it = s_wifiNetworks.erase(it);
-      } else {
-        ++it;
+        lostNetworks.push_back(&*it);
       }
+
+      Serialization::Local::SerializeWiFiNetworkDeltaEvent(++s_wifiNetworksGeneration, {}, lostNetworks, CaptivePortal::BroadcastMessageBIN);
+
+      s_wifiNetworks.erase(lostBegin, s_wifiNetworks.end());
     }
+
+    xSemaphoreGive(s_wifiNetworksMutex);
   }
 
   // If the scan completed, sort the networks by RSSI
   if (status == OpenShock::WiFiScanStatus::Completed || status == OpenShock::WiFiScanStatus::Aborted || status == OpenShock::WiFiScanStatus::Error) {
     // Sort the networks by RSSI
+    xSemaphoreTake(s_wifiNetworksMutex, portMAX_DELAY);
     std::sort(s_wifiNetworks.begin(), s_wifiNetworks.end(), [](const WiFiNetwork& a, const WiFiNetwork& b) { return a.rssi > b.rssi; });
+    xSemaphoreGive(s_wifiNetworksMutex);
   }
 
   // Send the scan status changed event
   Serialization::Local::SerializeWiFiScanStatusChangedEvent(status, CaptivePortal::BroadcastMessageBIN);
 }
 void _evWiFiNetworksDiscovery(const std::vector<const wifi_ap_record_t*>& records) {
-  std::vector<WiFiNetwork> updatedNetworks;
+  xSemaphoreTake(s_wifiNetworksMutex, portMAX_DELAY);
+
+  std::uint32_t generation = s_wifiNetworksGeneration + 1;
+
+  std::vector<const WiFiNetwork*> deltaNetworks;  // Only RSSI or channel changed, clients get just those fields
+  std::vector<WiFiNetwork> updatedNetworks;       // SSID, auth mode or saved state changed, clients get the whole record
   std::vector<WiFiNetwork> discoveredNetworks;
 
   for (const wifi_ap_record_t* record : records) {
@@ -273,6 +303,9 @@ void _evWiFiNetworksDiscovery(const std::vector<const wifi_ap_record_t*>& record
 
     auto it = _findNetworkByBSSID(record->bssid);
     if (it != s_wifiNetworks.end()) {
+      bool recordChanged = memcmp(it->ssid, record->ssid, sizeof(it->ssid)) != 0 || it->authMode != record->authmode || it->credentialsID != credsId;
+      bool signalChanged = it->channel != record->primary || std::abs(record->rssi - it->reportedRssi) >= RSSI_REPORT_THRESHOLD;
+
       // Update the network
       memcpy(it->ssid, record->ssid, sizeof(it->ssid));
       it->channel       = record->primary;
@@ -281,27 +314,52 @@ void _evWiFiNetworksDiscovery(const std::vector<const wifi_ap_record_t*>& record
       it->credentialsID = credsId;  // TODO: I don't understand why I need to set this here, but it seems to fix a bug where the credentials ID is not set correctly
       it->scansMissed   = 0;
 
-      updatedNetworks.push_back(*it);
+      if (!recordChanged && !signalChanged) {
+        continue;
+      }
+
+      it->reportedRssi = it->rssi;
+
+      if (recordChanged) {
+        updatedNetworks.push_back(*it);
+      } else {
+        deltaNetworks.push_back(&*it);
+      }
+
       ESP_LOGV(TAG, "Updated network %s (" BSSID_FMT ") with new scan info", it->ssid, BSSID_ARG(it->bssid));
 
       continue;
     }
 
-    WiFiNetwork network(record->ssid, record->bssid, record->primary, record->rssi, record->authmode, credsId);
+    WiFiNetwork& network = discoveredNetworks.emplace_back(record->ssid, record->bssid, record->primary, record->rssi, record->authmode, credsId);
 
-    discoveredNetworks.push_back(network);
     ESP_LOGV(TAG, "Discovered new network %s (" BSSID_FMT ")", network.ssid, BSSID_ARG(network.bssid));
+  }
 
-    // Insert the network into the list of networks sorted by RSSI
-    s_wifiNetworks.insert(std::lower_bound(s_wifiNetworks.begin(), s_wifiNetworks.end(), network, [](const WiFiNetwork& a, const WiFiNetwork& b) { return a.rssi > b.rssi; }), std::move(network));
+  if (deltaNetworks.empty() && updatedNetworks.empty() && discoveredNetworks.empty()) {
+    xSemaphoreGive(s_wifiNetworksMutex);
+    return;
   }
 
+  s_wifiNetworksGeneration = generation;
+
+  // Send the deltas before inserting the discovered networks, the insertions invalidate the pointers
+  if (!deltaNetworks.empty()) {
+    Serialization::Local::SerializeWiFiNetworkDeltaEvent(generation, deltaNetworks, {}, CaptivePortal::BroadcastMessageBIN);
+  }
   if (!updatedNetworks.empty()) {
     Serialization::Local::SerializeWiFiNetworksEvent(Serialization::Types::WifiNetworkEventType::Updated, updatedNetworks, CaptivePortal::BroadcastMessageBIN);
   }
   if (!discoveredNetworks.empty()) {
+    // Insert the networks into the list of networks sorted by RSSI
+    for (const WiFiNetwork& network : discoveredNetworks) {
+      s_wifiNetworks.insert(std::lower_bound(s_wifiNetworks.begin(), s_wifiNetworks.end(), network, [](const WiFiNetwork& a, const WiFiNetwork& b) { return a.rssi > b.rssi; }), network);
+    }
+
     Serialization::Local::SerializeWiFiNetworksEvent(Serialization::Types::WifiNetworkEventType::Discovered, discoveredNetworks, CaptivePortal::BroadcastMessageBIN);
   }
+
+  xSemaphoreGive(s_wifiNetworksMutex);
 }
 
 esp_err_t set_esp_interface_dns(esp_interface_t interface, IPAddress main_dns, IPAddress backup_dns, IPAddress fallback_dns);
@@ -386,17 +444,37 @@ bool WiFiManager::Forget(const char* ssid) {
 bool WiFiManager::RefreshNetworkCredentials() {
   ESP_LOGV(TAG, "Refreshing network credentials");
 
+  xSemaphoreTake(s_wifiNetworksMutex, portMAX_DELAY);
+
+  std::vector<WiFiNetwork> updatedNetworks;  // Saved state changed, clients get the whole record
+
   for (auto& net : s_wifiNetworks) {
+    std::uint8_t credsId = 0;
+
     Config::WiFiCredentials creds;
     if (Config::TryGetWiFiCredentialsBySSID(net.ssid, creds)) {
       ESP_LOGV(TAG, "Found credentials for network %s (" BSSID_FMT ")", net.ssid, BSSID_ARG(net.bssid));
-      net.credentialsID = creds.id;
+      credsId = creds.id;
     } else {
       ESP_LOGV(TAG, "Failed to find credentials for network %s (" BSSID_FMT ")", net.ssid, BSSID_ARG(net.bssid));
-      net.credentialsID = 0;
     }
+
+    if (net.credentialsID == credsId) {
+      continue;
+    }
+
+    net.credentialsID = credsId;
+    updatedNetworks.push_back(net);
+  }
+
+  // Saved state is part of what clients see, cached network lists have to be rebuilt
+  if (!updatedNetworks.empty()) {
+    ++s_wifiNetworksGeneration;
+    Serialization::Local::SerializeWiFiNetworksEvent(Serialization::Types::WifiNetworkEventType::Updated, updatedNetworks, CaptivePortal::BroadcastMessageBIN);
   }
 
+  xSemaphoreGive(s_wifiNetworksMutex);
+
   return true;
 }
 
@@ -544,5 +622,15 @@ void WiFiManager::Update() {
 }
 
 std::vector<WiFiNetwork> WiFiManager::GetDiscoveredWiFiNetworks() {
-  return s_wifiNetworks;
+  xSemaphoreTake(s_wifiNetworksMutex, portMAX_DELAY);
+  std::vector<WiFiNetwork> networks = s_wifiNetworks;
+  xSemaphoreGive(s_wifiNetworksMutex);
+
+  return networks;
+}
+
+void WiFiManager::WithDiscoveredWiFiNetworks(const std::function<void(std::uint32_t generation, const std::vector<WiFiNetwork>& networks)>& fn) {
+  xSemaphoreTake(s_wifiNetworksMutex, portMAX_DELAY);
+  fn(s_wifiNetworksGeneration, s_wifiNetworks);
+  xSemaphoreGive(s_wifiNetworksMutex);
 }
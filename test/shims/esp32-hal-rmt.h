@@ -0,0 +1,18 @@
+#pragma once
+
+// Host stand-in for the Arduino RMT HAL, only the pulse layout is needed to encode and decode frames
+
+#include <cstddef>
+#include <cstdint>
+
+typedef struct {
+  union {
+    struct {
+      std::uint32_t duration0 : 15;
+      std::uint32_t level0    : 1;
+      std::uint32_t duration1 : 15;
+      std::uint32_t level1    : 1;
+    };
+    std::uint32_t val;
+  };
+} rmt_data_t;
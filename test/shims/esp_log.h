@@ -0,0 +1,11 @@
+#pragma once
+
+// Host stand-in for the ESP-IDF log macros, errors and warnings go to stderr, the rest is dropped
+
+#include <cstdio>
+
+#define ESP_LOGE(tag, format, ...) std::fprintf(stderr, "E %s: " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, format, ...) std::fprintf(stderr, "W %s: " format "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, format, ...)
+#define ESP_LOGD(tag, format, ...)
+#define ESP_LOGV(tag, format, ...)
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "esp_err.h"
+
+#include <cstdlib>
+
+inline esp_err_t esp_ota_mark_app_invalid_rollback_and_reboot() {
+  std::abort();
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+// Host stand-in for the partition API. A partition is a file: esp_partition_mmap maps it read-only and shared, the way flash is read through
+// the cache, while erases and writes go through the file descriptor, the way the flash driver writes behind the mapping.
+// Writes can only clear bits like NOR flash does, so writing over data that was not erased first shows up in the tests.
+
+#include "esp_err.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+typedef enum {
+  ESP_PARTITION_TYPE_APP  = 0x00,
+  ESP_PARTITION_TYPE_DATA = 0x01,
+} esp_partition_type_t;
+
+typedef enum {
+  ESP_PARTITION_SUBTYPE_DATA_UNDEFINED = 0x06,
+  ESP_PARTITION_SUBTYPE_DATA_SPIFFS    = 0x82,
+  ESP_PARTITION_SUBTYPE_ANY            = 0xff,
+} esp_partition_subtype_t;
+
+typedef enum {
+  SPI_FLASH_MMAP_DATA,
+  SPI_FLASH_MMAP_INST,
+} spi_flash_mmap_memory_t;
+
+typedef std::uint32_t spi_flash_mmap_handle_t;
+
+constexpr std::size_t kHostFlashSectorSize = 4096;
+
+struct esp_partition_t {
+  esp_partition_type_t type;
+  esp_partition_subtype_t subtype;
+  std::uint32_t address;
+  std::uint32_t size;
+  char label[17];
+  bool encrypted;
+
+  int fd;  // Host only, the file backing the partition
+};
+
+/// @brief The one partition the host knows about, tests point it at a file before calling into the code under test
+inline esp_partition_t* g_hostPartition = nullptr;
+
+/// @brief Number of erases and writes that still succeed, the one after fails without touching the file as if power was lost; negative never fails
+inline int g_hostFlashOpsLeft = -1;
+
+inline bool _hostFlashOpFails() {
+  if (g_hostFlashOpsLeft < 0) {
+    return false;
+  }
+
+  return g_hostFlashOpsLeft-- == 0;
+}
+
+inline const esp_partition_t* esp_partition_find_first(esp_partition_type_t type, esp_partition_subtype_t subtype, const char* label) {
+  const esp_partition_t* partition = g_hostPartition;
+  if (partition == nullptr || partition->type != type) {
+    return nullptr;
+  }
+  if (subtype != ESP_PARTITION_SUBTYPE_ANY && partition->subtype != subtype) {
+    return nullptr;
+  }
+  if (label != nullptr && std::strcmp(partition->label, label) != 0) {
+    return nullptr;
+  }
+
+  return partition;
+}
+
+inline esp_err_t esp_partition_mmap(const esp_partition_t* partition, std::size_t offset, std::size_t size, spi_flash_mmap_memory_t, const void** out_ptr, spi_flash_mmap_handle_t* out_handle) {
+  if (offset + size > partition->size) {
+    return ESP_ERR_INVALID_ARG;
+  }
+
+  void* mapped = mmap(nullptr, partition->size, PROT_READ, MAP_SHARED, partition->fd, 0);
+  if (mapped == MAP_FAILED) {
+    return ESP_FAIL;
+  }
+
+  *out_ptr    = static_cast<const std::uint8_t*>(mapped) + offset;
+  *out_handle = 0;
+
+  return ESP_OK;
+}
+
+inline esp_err_t esp_partition_erase_range(const esp_partition_t* partition, std::size_t offset, std::size_t size) {
+  if (offset % kHostFlashSectorSize != 0 || size % kHostFlashSectorSize != 0) {
+    return ESP_ERR_INVALID_ARG;
+  }
+  if (offset + size > partition->size) {
+    return ESP_ERR_INVALID_SIZE;
+  }
+  if (_hostFlashOpFails()) {
+    return ESP_FAIL;
+  }
+
+  std::vector<std::uint8_t> erased(size, 0xFF);
+  return pwrite(partition->fd, erased.data(), size, offset) == static_cast<ssize_t>(size) ? ESP_OK : ESP_FAIL;
+}
+
+inline esp_err_t esp_partition_write(const esp_partition_t* partition, std::size_t dst_offset, const void* src, std::size_t size) {
+  if (dst_offset + size > partition->size) {
+    return ESP_ERR_INVALID_SIZE;
+  }
+  if (_hostFlashOpFails()) {
+    return ESP_FAIL;
+  }
+
+  std::vector<std::uint8_t> cells(size);
+  if (pread(partition->fd, cells.data(), size, dst_offset) != static_cast<ssize_t>(size)) {
+    return ESP_FAIL;
+  }
+
+  const std::uint8_t* data = static_cast<const std::uint8_t*>(src);
+  for (std::size_t i = 0; i < size; ++i) {
+    cells[i] &= data[i];
+  }
+
+  return pwrite(partition->fd, cells.data(), size, dst_offset) == static_cast<ssize_t>(size) ? ESP_OK : ESP_FAIL;
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <cstdlib>
+
+[[noreturn]] inline void esp_restart() {
+  std::abort();
+}
@@ -0,0 +1,8 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+inline std::int64_t esp_timer_get_time() {
+  return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+// Host stand-in for the FreeRTOS kernel, backed by the standard library so native tests can run real threads against it
+// One tick is one millisecond, as configured for the firmware
+
+#include <cstdint>
+#include <mutex>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef std::uint32_t TickType_t;
+
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  pdTRUE
+#define pdFAIL  pdFALSE
+
+#define portMAX_DELAY      ((TickType_t)0xFFFFFFFFUL)
+#define portTICK_PERIOD_MS ((TickType_t)1)
+#define pdMS_TO_TICKS(ms)  ((TickType_t)(ms))
+
+// Critical sections only have to exclude the other host threads, recursive to match nesting on the same core
+typedef struct {
+  std::recursive_mutex mutex;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZER_UNLOCKED {}
+#define portMUX_INITIALIZE(mux)
+#define portENTER_CRITICAL(mux) (mux)->mutex.lock()
+#define portEXIT_CRITICAL(mux)  (mux)->mutex.unlock()
+
+#include "task.h"
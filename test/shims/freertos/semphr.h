@@ -0,0 +1,69 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+// Counting semaphore with a maximum of one, which covers both binary semaphores and mutexes
+// Priority inheritance has no meaning on the host, so mutexes are plain binary semaphores that start out given
+struct HostSemaphore {
+  std::mutex mutex;
+  std::condition_variable cv;
+  int count;
+};
+
+typedef HostSemaphore* SemaphoreHandle_t;
+
+/// @brief Called after a take timed out, before it returns, so tests can force the races that follow a timeout
+inline void (*g_semaphoreTimeoutHook)(SemaphoreHandle_t semaphore) = nullptr;
+
+inline SemaphoreHandle_t xSemaphoreCreateMutex() {
+  return new HostSemaphore {.count = 1};
+}
+
+inline SemaphoreHandle_t xSemaphoreCreateBinary() {
+  return new HostSemaphore {.count = 0};
+}
+
+inline void vSemaphoreDelete(SemaphoreHandle_t semaphore) {
+  delete semaphore;
+}
+
+inline BaseType_t xSemaphoreTake(SemaphoreHandle_t semaphore, TickType_t ticksToWait) {
+  {
+    std::unique_lock<std::mutex> lock(semaphore->mutex);
+
+    auto available = [semaphore] { return semaphore->count > 0; };
+    if (ticksToWait == portMAX_DELAY) {
+      semaphore->cv.wait(lock, available);
+    } else if (!semaphore->cv.wait_for(lock, std::chrono::milliseconds(ticksToWait), available)) {
+      lock.unlock();
+
+      if (g_semaphoreTimeoutHook != nullptr) {
+        g_semaphoreTimeoutHook(semaphore);
+      }
+
+      return pdFALSE;
+    }
+
+    --semaphore->count;
+  }
+
+  return pdTRUE;
+}
+
+inline BaseType_t xSemaphoreGive(SemaphoreHandle_t semaphore) {
+  {
+    std::lock_guard<std::mutex> lock(semaphore->mutex);
+    if (semaphore->count > 0) {
+      return pdFALSE;
+    }
+
+    ++semaphore->count;
+  }
+
+  semaphore->cv.notify_one();
+  return pdTRUE;
+}
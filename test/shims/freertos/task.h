@@ -0,0 +1,40 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+#include <chrono>
+#include <thread>
+
+typedef struct {
+  TickType_t enteredTick;
+} TimeOut_t;
+
+inline TickType_t xTaskGetTickCount() {
+  return static_cast<TickType_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+inline void vTaskDelay(TickType_t ticks) {
+  std::this_thread::sleep_for(std::chrono::milliseconds(ticks));
+}
+
+inline void vTaskSetTimeOutState(TimeOut_t* timeout) {
+  timeout->enteredTick = xTaskGetTickCount();
+}
+
+/// @brief Same contract as the kernel: returns pdTRUE once the wait has run out, otherwise shortens the remaining ticks and restarts the timeout
+inline BaseType_t xTaskCheckForTimeOut(TimeOut_t* timeout, TickType_t* ticksToWait) {
+  if (*ticksToWait == portMAX_DELAY) {
+    return pdFALSE;
+  }
+
+  TickType_t now     = xTaskGetTickCount();
+  TickType_t elapsed = now - timeout->enteredTick;
+  if (elapsed >= *ticksToWait) {
+    *ticksToWait = 0;
+    return pdTRUE;
+  }
+
+  *ticksToWait -= elapsed;
+  timeout->enteredTick = now;
+  return pdFALSE;
+}
@@ -0,0 +1,296 @@
+#include "ReadWriteMutex.h"
+
+// test_build_src is off for the native env, so the unit under test is compiled into the suite
+#include "../../src/ReadWriteMutex.cpp"
+
+#include <unity.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Compares the two ways config readers can be served while a setter is running:
+//  - Snapshot: _getSnapshot() copies a shared_ptr under a spinlock, what CONFIG_SNAPSHOT does in src/config/Config.cpp
+//  - Locked: ScopedReadLock on the config ReadWriteMutex, what the getters did before snapshots
+//
+// Config.cpp itself needs LittleFS and cJSON, so the two paths are reproduced here as they are written there, over a struct with the same
+// heap layout as RootConfig: a credentials vector and a dozen strings, most of them too long for the small string buffer.
+//
+// The price of the snapshot path is on the write side. _publishSnapshot deep-copies the whole RootConfig, the credentials vector and every
+// string in it, on every setter, however small the change. test_publish_cost counts those allocations.
+//
+// The shim critical section is a std::recursive_mutex rather than a spinlock with interrupts masked, so only the ratios mean anything,
+// not the absolute numbers.
+
+using namespace OpenShock;
+
+const int BENCH_READERS        = 4;
+const int BENCH_CREDENTIALS    = 8;
+const int BENCH_WRITER_SLEEPUS = 200;  // Roughly a setter burst, such as the frontend saving a form
+const std::chrono::milliseconds BENCH_DURATION(500);
+
+struct BenchCredentials {
+  std::uint8_t id;
+  std::string ssid;
+  std::string password;
+};
+
+struct BenchConfig {
+  std::uint32_t version;
+
+  std::uint8_t rfTxPin;
+  bool rfKeepAliveEnabled;
+
+  std::string accessPointSSID;
+  std::string hostname;
+  std::vector<BenchCredentials> credentialsList;
+
+  bool captivePortalAlwaysEnabled;
+
+  std::string backendDomain;
+  std::string backendAuthToken;
+  std::string backendLcgOverride;
+
+  std::string otaCdnDomain;
+  std::string otaUpdateChannel;
+  std::string otaRequestedVersion;
+};
+
+static std::atomic<std::uint64_t> s_allocations {0};
+static std::atomic<bool> s_countAllocations {false};
+
+[[gnu::noinline]] void* operator new(std::size_t size) {
+  if (s_countAllocations.load(std::memory_order_relaxed)) {
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void* ptr = std::malloc(size == 0 ? 1 : size);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  return ptr;
+}
+
+// Out of line so the compiler does not pair the inlined free with the new expression and warn about a mismatch
+[[gnu::noinline]] void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+// Every string carries the version, so a reader that sees two versions in one config has read a half-applied change
+static std::string _versioned(const char* prefix, std::uint32_t version) {
+  return std::string(prefix) + "-" + std::to_string(version);
+}
+
+static void _apply(BenchConfig& config, std::uint32_t version) {
+  config.version             = version;
+  config.rfTxPin             = static_cast<std::uint8_t>(version);
+  config.accessPointSSID     = _versioned("OpenShock-AP-0123456789", version);
+  config.hostname            = _versioned("openshock-hub-0123456789", version);
+  config.backendDomain       = _versioned("api.openshock.app.example", version);
+  config.backendAuthToken    = _versioned("0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef", version);
+  config.backendLcgOverride  = _versioned("lcg.openshock.app.example", version);
+  config.otaCdnDomain        = _versioned("firmware.openshock.app.example", version);
+  config.otaUpdateChannel    = _versioned("stable-channel-name", version);
+  config.otaRequestedVersion = _versioned("1.2.3-rc.4+build.5678", version);
+
+  config.credentialsList.resize(BENCH_CREDENTIALS);
+  for (int i = 0; i < BENCH_CREDENTIALS; ++i) {
+    BenchCredentials& creds = config.credentialsList[i];
+    creds.id                = static_cast<std::uint8_t>(i + 1);
+    creds.ssid              = _versioned("Neighbourhood-Network-Name", version);
+    creds.password          = _versioned("correct horse battery staple 0123456789", version);
+  }
+}
+
+// A typical getter: a few scalars, one string and a walk over the credentials
+static bool _read(const BenchConfig& config) {
+  std::string suffix = "-" + std::to_string(config.version);
+
+  if (config.rfTxPin != static_cast<std::uint8_t>(config.version)) {
+    return false;
+  }
+
+  auto endsWith = [&suffix](const std::string& value) { return value.size() >= suffix.size() && value.compare(value.size() - suffix.size(), suffix.size(), suffix) == 0; };
+
+  if (!endsWith(config.hostname) || !endsWith(config.backendAuthToken)) {
+    return false;
+  }
+
+  for (const auto& creds : config.credentialsList) {
+    if (!endsWith(creds.ssid)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+// As in Config.cpp
+static BenchConfig _configData;
+static ReadWriteMutex _configMutex("Config");
+static portMUX_TYPE s_snapshotSpinlock = portMUX_INITIALIZER_UNLOCKED;
+static std::shared_ptr<const BenchConfig> s_snapshot;
+
+std::shared_ptr<const BenchConfig> _getSnapshot() {
+  portENTER_CRITICAL(&s_snapshotSpinlock);
+  std::shared_ptr<const BenchConfig> snapshot = s_snapshot;
+  portEXIT_CRITICAL(&s_snapshotSpinlock);
+
+  return snapshot;
+}
+
+void _publishSnapshot() {
+  std::shared_ptr<const BenchConfig> snapshot = std::make_shared<const BenchConfig>(_configData);
+
+  portENTER_CRITICAL(&s_snapshotSpinlock);
+  s_snapshot.swap(snapshot);
+  portEXIT_CRITICAL(&s_snapshotSpinlock);
+}
+
+struct BenchResult {
+  std::uint64_t reads;
+  std::uint64_t torn;
+  std::uint64_t writes;
+  std::uint64_t maxReadNs;
+  std::uint64_t maxWriteNs;
+};
+
+static std::uint64_t _nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void _updateMax(std::atomic<std::uint64_t>& max, std::uint64_t value) {
+  std::uint64_t prev = max.load(std::memory_order_relaxed);
+  while (value > prev && !max.compare_exchange_weak(prev, value, std::memory_order_relaxed)) { }
+}
+
+static BenchResult _run(bool useSnapshot) {
+  _apply(_configData, 1);
+  _publishSnapshot();
+
+  std::atomic<bool> stop {false};
+  std::atomic<std::uint64_t> reads {0}, torn {0}, writes {0}, maxReadNs {0}, maxWriteNs {0};
+
+  std::vector<std::thread> readers;
+  for (int i = 0; i < BENCH_READERS; ++i) {
+    readers.emplace_back([&] {
+      std::uint64_t localReads = 0, localTorn = 0;
+      while (!stop.load(std::memory_order_relaxed)) {
+        std::uint64_t startNs = _nowNs();
+        bool ok;
+
+        if (useSnapshot) {
+          std::shared_ptr<const BenchConfig> snapshot = _getSnapshot();
+          ok                                          = _read(*snapshot);
+        } else {
+          ScopedReadLock lock(&_configMutex);
+          ok = _read(_configData);
+        }
+
+        _updateMax(maxReadNs, _nowNs() - startNs);
+
+        ++localReads;
+        if (!ok) {
+          ++localTorn;
+        }
+      }
+
+      reads += localReads;
+      torn += localTorn;
+    });
+  }
+
+  std::thread writer([&] {
+    std::uint32_t version = 1;
+    while (!stop.load(std::memory_order_relaxed)) {
+      std::uint64_t startNs = _nowNs();
+      {
+        ScopedWriteLock lock(&_configMutex);
+        _apply(_configData, ++version);
+        if (useSnapshot) {
+          _publishSnapshot();
+        }
+      }
+      _updateMax(maxWriteNs, _nowNs() - startNs);
+      ++writes;
+
+      std::this_thread::sleep_for(std::chrono::microseconds(BENCH_WRITER_SLEEPUS));
+    }
+  });
+
+  std::this_thread::sleep_for(BENCH_DURATION);
+  stop = true;
+  writer.join();
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  return BenchResult {reads, torn, writes, maxReadNs, maxWriteNs};
+}
+
+static void _report(const char* name, const BenchResult& result) {
+  char message[192];
+  std::snprintf(message, sizeof(message), "%-8s reads %10llu (%6.2f M/s)  max read %8.1f us  writes %6llu  max setter %8.1f us", name, static_cast<unsigned long long>(result.reads), result.reads / (BENCH_DURATION.count() * 1000.0), result.maxReadNs / 1000.0, static_cast<unsigned long long>(result.writes), result.maxWriteNs / 1000.0);
+  TEST_MESSAGE(message);
+}
+
+void setUp(void) { }
+void tearDown(void) { }
+
+void test_reads_under_writer(void) {
+  BenchResult locked   = _run(false);
+  BenchResult snapshot = _run(true);
+
+  _report("Locked", locked);
+  _report("Snapshot", snapshot);
+
+  TEST_ASSERT_EQUAL_UINT32(0, locked.torn);
+  TEST_ASSERT_EQUAL_UINT32(0, snapshot.torn);
+  TEST_ASSERT_GREATER_THAN(0, locked.reads);
+  TEST_ASSERT_GREATER_THAN(0, snapshot.reads);
+  TEST_ASSERT_GREATER_THAN(0, locked.writes);
+  TEST_ASSERT_GREATER_THAN(0, snapshot.writes);
+}
+
+void test_publish_cost(void) {
+  const int iterations = 10'000;
+
+  _apply(_configData, 1);
+
+  s_allocations      = 0;
+  s_countAllocations = true;
+  std::uint64_t startNs = _nowNs();
+  for (int i = 0; i < iterations; ++i) {
+    _publishSnapshot();
+  }
+  std::uint64_t elapsedNs = _nowNs() - startNs;
+  s_countAllocations = false;
+
+  double allocationsPerPublish = static_cast<double>(s_allocations.load()) / iterations;
+
+  char message[160];
+  std::snprintf(message, sizeof(message), "_publishSnapshot: %.2f us and %.1f heap allocations per setter for %d credentials", elapsedNs / 1000.0 / iterations, allocationsPerPublish, BENCH_CREDENTIALS);
+  TEST_MESSAGE(message);
+
+  // The control block and config share one allocation, every string past the small buffer and the credentials vector are copied on top of that
+  TEST_ASSERT_GREATER_OR_EQUAL(1 + 1 + 2 * BENCH_CREDENTIALS + 8, static_cast<int>(allocationsPerPublish));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_reads_under_writer);
+  RUN_TEST(test_publish_cost);
+  return UNITY_END();
+}
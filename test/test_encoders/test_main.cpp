@@ -0,0 +1,310 @@
+#include "radio/rmt/MainEncoder.h"
+
+#include <unity.h>
+
+#include <cstdint>
+
+using namespace OpenShock;
+
+// Decodes the frames back into the fields the shockers read, following https://wiki.openshock.org/hardware/shockers/
+
+struct Decoded {
+  bool valid;
+  std::uint16_t shockerId;
+  std::uint8_t channelId;
+  ShockerCommandType type;
+  std::uint8_t intensity;
+};
+
+static std::uint8_t _reverseBits(std::uint8_t value, int width) {
+  std::uint8_t out = 0;
+  for (int i = 0; i < width; ++i) {
+    out |= ((value >> i) & 1) << (width - 1 - i);
+  }
+  return out;
+}
+
+static Decoded _decodePetrainer(const Rmt::PetrainerEncoder::Frame& frame) {
+  using namespace Rmt::PetrainerEncoder;
+
+  Decoded out {};
+  if (frame.size() != kPulseCount || !Rmt::Internal::PulseEquals(frame.pulses[0], kRmtPreamble) || !Rmt::Internal::PulseEquals(frame.pulses[kPulseCount - 1], kRmtPostamble)) {
+    return out;
+  }
+
+  std::uint64_t data = 0;
+  if (!Rmt::Internal::DecodeBits<40>(frame, 1, data, kRmtOne, kRmtZero)) {
+    return out;
+  }
+
+  // [type:8][shockerId:16][intensity:8][typeSum:8], typeSum is the type mirrored and inverted
+  std::uint8_t typeVal = static_cast<std::uint8_t>(data >> 32);
+  std::uint8_t typeSum = static_cast<std::uint8_t>(data);
+  if (static_cast<std::uint8_t>(~_reverseBits(typeVal, 8)) != typeSum) {
+    return out;
+  }
+
+  switch (typeVal) {
+    case 0x81:
+      out.type = ShockerCommandType::Shock;
+      break;
+    case 0x82:
+      out.type = ShockerCommandType::Vibrate;
+      break;
+    case 0x84:
+      out.type = ShockerCommandType::Sound;
+      break;
+    default:
+      return out;
+  }
+
+  out.shockerId = static_cast<std::uint16_t>(data >> 16);
+  out.intensity = static_cast<std::uint8_t>(data >> 8);
+  out.valid     = true;
+
+  return out;
+}
+
+static Decoded _decodePetrainer998DR(const Rmt::Petrainer998DREncoder::Frame& frame) {
+  using namespace Rmt::Petrainer998DREncoder;
+
+  Decoded out {};
+  if (frame.size() != kPulseCount || !Rmt::Internal::PulseEquals(frame.pulses[0], kRmtPreamble) || !Rmt::Internal::PulseEquals(frame.pulses[1], kRmtOne) || !Rmt::Internal::PulseEquals(frame.pulses[kPulseCount - 1], kRmtPostamble)) {
+    return out;
+  }
+
+  std::uint64_t data = 0;
+  if (!Rmt::Internal::DecodeBits<38>(frame, 2, data, kRmtOne, kRmtZero)) {
+    return out;
+  }
+
+  // [channel:3][type:4][shockerId:17][intensity:7][typeInvert:4][channelInvert:3]
+  std::uint8_t channel       = (data >> 35) & 0b111;
+  std::uint8_t typeVal       = (data >> 31) & 0b1111;
+  std::uint8_t typeInvert    = (data >> 3) & 0b1111;
+  std::uint8_t channelInvert = data & 0b111;
+  if ((~_reverseBits(typeVal, 4) & 0b1111) != typeInvert || (~_reverseBits(channel, 3) & 0b111) != channelInvert) {
+    return out;
+  }
+
+  switch (typeVal) {
+    case 0b0001:
+      out.type = ShockerCommandType::Shock;
+      break;
+    case 0b0010:
+      out.type = ShockerCommandType::Vibrate;
+      break;
+    case 0b0100:
+      out.type = ShockerCommandType::Sound;
+      break;
+    default:
+      return out;
+  }
+
+  out.shockerId = static_cast<std::uint16_t>((data >> 14) & 0x1FFFF);
+  out.channelId = channel;
+  out.intensity = (data >> 7) & 0x7F;
+  out.valid     = true;
+
+  return out;
+}
+
+static Decoded _decodeCaiXianlin(const Rmt::CaiXianlinEncoder::Frame& frame) {
+  using namespace Rmt::CaiXianlinEncoder;
+
+  Decoded out {};
+  if (frame.size() != kPulseCount || !Rmt::Internal::PulseEquals(frame.pulses[0], kRmtPreamble)) {
+    return out;
+  }
+
+  std::uint64_t data = 0;
+  if (!Rmt::Internal::DecodeBits<43>(frame, 1, data, kRmtOne, kRmtZero)) {
+    return out;
+  }
+
+  // [transmitterId:16][channelId:4][type:4][intensity:8][checksum:8][postamble:3], the checksum is the byte sum of the payload
+  std::uint32_t payload = static_cast<std::uint32_t>(data >> 11);
+  std::uint8_t checksum = static_cast<std::uint8_t>(data >> 3);
+  std::uint8_t byteSum  = static_cast<std::uint8_t>((payload >> 24) + (payload >> 16) + (payload >> 8) + payload);
+  if ((data & 0b111) != 0 || checksum != byteSum) {
+    return out;
+  }
+
+  switch ((payload >> 8) & 0xF) {
+    case 0x01:
+      out.type = ShockerCommandType::Shock;
+      break;
+    case 0x02:
+      out.type = ShockerCommandType::Vibrate;
+      break;
+    case 0x03:
+      out.type = ShockerCommandType::Sound;
+      break;
+    default:
+      return out;
+  }
+
+  out.shockerId = static_cast<std::uint16_t>(payload >> 16);
+  out.channelId = (payload >> 12) & 0xF;
+  out.intensity = static_cast<std::uint8_t>(payload);
+  out.valid     = true;
+
+  return out;
+}
+
+static const ShockerCommandType kTypes[] = {ShockerCommandType::Shock, ShockerCommandType::Vibrate, ShockerCommandType::Sound};
+static const std::uint16_t kShockerIds[] = {0x0000, 0x0001, 0x1234, 0x8000, 0xBEEF, 0xFFFF};
+
+void setUp(void) { }
+void tearDown(void) { }
+
+void test_petrainer_round_trip(void) {
+  for (auto type : kTypes) {
+    for (auto shockerId : kShockerIds) {
+      for (std::uint8_t intensity : {0, 1, 50, 99, 100}) {
+        Decoded decoded = _decodePetrainer(Rmt::PetrainerEncoder::GetSequence(shockerId, type, intensity));
+
+        TEST_ASSERT_TRUE(decoded.valid);
+        TEST_ASSERT_EQUAL_UINT16(shockerId, decoded.shockerId);
+        TEST_ASSERT_EQUAL_UINT8(static_cast<std::uint8_t>(type), static_cast<std::uint8_t>(decoded.type));
+        TEST_ASSERT_EQUAL_UINT8(intensity, decoded.intensity);
+      }
+    }
+  }
+}
+
+void test_petrainer998dr_round_trip(void) {
+  for (auto type : kTypes) {
+    for (auto shockerId : kShockerIds) {
+      for (std::uint8_t intensity : {0, 1, 50, 99, 100}) {
+        Decoded decoded = _decodePetrainer998DR(Rmt::Petrainer998DREncoder::GetSequence(shockerId, type, intensity));
+
+        TEST_ASSERT_TRUE(decoded.valid);
+        TEST_ASSERT_EQUAL_UINT16(shockerId, decoded.shockerId);
+        TEST_ASSERT_EQUAL_UINT8(0, decoded.channelId);
+        TEST_ASSERT_EQUAL_UINT8(static_cast<std::uint8_t>(type), static_cast<std::uint8_t>(decoded.type));
+        TEST_ASSERT_EQUAL_UINT8(intensity, decoded.intensity);
+      }
+    }
+  }
+}
+
+void test_caixianlin_round_trip(void) {
+  for (auto type : kTypes) {
+    for (auto shockerId : kShockerIds) {
+      for (std::uint8_t channelId : {0, 1, 2, 15}) {
+        for (std::uint8_t intensity : {0, 1, 50, 99}) {
+          Decoded decoded = _decodeCaiXianlin(Rmt::CaiXianlinEncoder::GetSequence(shockerId, channelId, type, intensity));
+
+          TEST_ASSERT_TRUE(decoded.valid);
+          TEST_ASSERT_EQUAL_UINT16(shockerId, decoded.shockerId);
+          TEST_ASSERT_EQUAL_UINT8(channelId, decoded.channelId);
+          TEST_ASSERT_EQUAL_UINT8(static_cast<std::uint8_t>(type), static_cast<std::uint8_t>(decoded.type));
+          // Sound is always sent at intensity 0, some shockers soft lock otherwise
+          TEST_ASSERT_EQUAL_UINT8(type == ShockerCommandType::Sound ? 0 : intensity, decoded.intensity);
+        }
+      }
+    }
+  }
+}
+
+void test_intensity_is_clamped(void) {
+  for (std::uint8_t intensity : {101, 127, 128, 200, 255}) {
+    TEST_ASSERT_EQUAL_UINT8(100, _decodePetrainer(Rmt::PetrainerEncoder::GetSequence(0x1234, ShockerCommandType::Shock, intensity)).intensity);
+    TEST_ASSERT_EQUAL_UINT8(100, _decodePetrainer998DR(Rmt::Petrainer998DREncoder::GetSequence(0x1234, ShockerCommandType::Shock, intensity)).intensity);
+  }
+
+  for (std::uint8_t intensity : {100, 101, 128, 255}) {
+    TEST_ASSERT_EQUAL_UINT8(99, _decodeCaiXianlin(Rmt::CaiXianlinEncoder::GetSequence(0x1234, 0, ShockerCommandType::Vibrate, intensity)).intensity);
+  }
+}
+
+void test_caixianlin_channel_is_masked(void) {
+  // Only 4 bits are sent, a larger channel must not spill into the shocker ID or type
+  Decoded decoded = _decodeCaiXianlin(Rmt::CaiXianlinEncoder::GetSequence(0x1234, 0x1F, ShockerCommandType::Shock, 10));
+
+  TEST_ASSERT_TRUE(decoded.valid);
+  TEST_ASSERT_EQUAL_UINT16(0x1234, decoded.shockerId);
+  TEST_ASSERT_EQUAL_UINT8(0xF, decoded.channelId);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<std::uint8_t>(ShockerCommandType::Shock), static_cast<std::uint8_t>(decoded.type));
+}
+
+void test_unknown_type_encodes_nothing(void) {
+  for (auto type : {ShockerCommandType::Stop, static_cast<ShockerCommandType>(4), static_cast<ShockerCommandType>(0xFF)}) {
+    TEST_ASSERT_TRUE(Rmt::PetrainerEncoder::GetSequence(0x1234, type, 50).empty());
+    TEST_ASSERT_TRUE(Rmt::Petrainer998DREncoder::GetSequence(0x1234, type, 50).empty());
+    TEST_ASSERT_TRUE(Rmt::CaiXianlinEncoder::GetSequence(0x1234, 0, type, 50).empty());
+
+    for (auto model : {ShockerModelType::CaiXianlin, ShockerModelType::Petrainer, ShockerModelType::Petrainer998DR}) {
+      TEST_ASSERT_TRUE(Rmt::GetSequence(model, 0x1234, type, 50).empty());
+    }
+  }
+}
+
+void test_unknown_model_encodes_nothing(void) {
+  TEST_ASSERT_TRUE(Rmt::GetSequence(static_cast<ShockerModelType>(3), 0x1234, ShockerCommandType::Shock, 50).empty());
+  TEST_ASSERT_TRUE(Rmt::GetSequence(static_cast<ShockerModelType>(0xFF), 0x1234, ShockerCommandType::Shock, 50).empty());
+  TEST_ASSERT_TRUE(Rmt::GetZeroSequence(static_cast<ShockerModelType>(0xFF), 0x1234).empty());
+}
+
+void test_main_encoder_dispatch(void) {
+  // The shared sequence type holds every protocol unchanged
+  Rmt::PetrainerEncoder::Frame petrainer = Rmt::PetrainerEncoder::GetSequence(0xBEEF, ShockerCommandType::Shock, 42);
+  Rmt::Sequence sequence                 = Rmt::GetSequence(ShockerModelType::Petrainer, 0xBEEF, ShockerCommandType::Shock, 42);
+
+  TEST_ASSERT_EQUAL_size_t(petrainer.size(), sequence.size());
+  for (std::size_t i = 0; i < sequence.size(); ++i) {
+    TEST_ASSERT_EQUAL_UINT32(petrainer.pulses[i].val, sequence.pulses[i].val);
+  }
+
+  Rmt::Sequence caiXianlin               = Rmt::GetSequence(ShockerModelType::CaiXianlin, 0xBEEF, ShockerCommandType::Vibrate, 42);
+  Rmt::CaiXianlinEncoder::Frame expected = Rmt::CaiXianlinEncoder::GetSequence(0xBEEF, 0, ShockerCommandType::Vibrate, 42);
+
+  TEST_ASSERT_EQUAL_size_t(expected.size(), caiXianlin.size());
+  for (std::size_t i = 0; i < caiXianlin.size(); ++i) {
+    TEST_ASSERT_EQUAL_UINT32(expected.pulses[i].val, caiXianlin.pulses[i].val);
+  }
+}
+
+void test_zero_sequence_is_silent_vibrate(void) {
+  Rmt::Sequence zero = Rmt::GetZeroSequence(ShockerModelType::Petrainer998DR, 0x4321);
+
+  Rmt::Petrainer998DREncoder::Frame frame;
+  TEST_ASSERT_TRUE(zero.size() <= frame.capacity());
+  for (std::size_t i = 0; i < zero.size(); ++i) {
+    frame.push_back(zero.pulses[i]);
+  }
+
+  Decoded decoded = _decodePetrainer998DR(frame);
+  TEST_ASSERT_TRUE(decoded.valid);
+  TEST_ASSERT_EQUAL_UINT16(0x4321, decoded.shockerId);
+  TEST_ASSERT_EQUAL_UINT8(static_cast<std::uint8_t>(ShockerCommandType::Vibrate), static_cast<std::uint8_t>(decoded.type));
+  TEST_ASSERT_EQUAL_UINT8(0, decoded.intensity);
+}
+
+void test_frame_append_stretches_gap(void) {
+  Rmt::CaiXianlinEncoder::Frame frame = Rmt::CaiXianlinEncoder::GetSequence(0x1234, 0, ShockerCommandType::Shock, 10);
+
+  Rmt::PulseFrame<Rmt::CaiXianlinEncoder::kPulseCount * 2> burst;
+  TEST_ASSERT_TRUE(burst.append(frame, Rmt::CaiXianlinEncoder::kInterFrameGap));
+  TEST_ASSERT_TRUE(burst.append(frame, Rmt::CaiXianlinEncoder::kInterFrameGap));
+  TEST_ASSERT_FALSE(burst.append(frame, Rmt::CaiXianlinEncoder::kInterFrameGap));
+
+  TEST_ASSERT_EQUAL_size_t(frame.size() * 2, burst.size());
+  TEST_ASSERT_EQUAL_UINT32(frame.duration() * 2 + Rmt::CaiXianlinEncoder::kInterFrameGap * 2, burst.duration());
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_petrainer_round_trip);
+  RUN_TEST(test_petrainer998dr_round_trip);
+  RUN_TEST(test_caixianlin_round_trip);
+  RUN_TEST(test_intensity_is_clamped);
+  RUN_TEST(test_caixianlin_channel_is_masked);
+  RUN_TEST(test_unknown_type_encodes_nothing);
+  RUN_TEST(test_unknown_model_encodes_nothing);
+  RUN_TEST(test_main_encoder_dispatch);
+  RUN_TEST(test_zero_sequence_is_silent_vibrate);
+  RUN_TEST(test_frame_append_stretches_gap);
+  return UNITY_END();
+}
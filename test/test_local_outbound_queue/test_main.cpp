@@ -0,0 +1,246 @@
+#include "LocalOutboundQueue.h"
+
+// test_build_src is off for the native env, so the unit under test is compiled into the suite
+#include "../../src/LocalOutboundQueue.cpp"
+
+#include <unity.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+// Eight simulated captive portal clients, the most LocalOutboundQueue takes. In the fan-out run one of them reads slowly, as a browser on a weak link does.
+// Timings come from the host, so only the comparisons between the runs mean anything.
+
+using namespace OpenShock;
+
+const std::size_t BENCH_CLIENTS          = LocalOutboundQueue::kMaxClients;
+const std::uint8_t BENCH_SLOW_CLIENT     = BENCH_CLIENTS - 1;
+const std::size_t BENCH_MESSAGE_SIZE     = 1024;  // About a serialized scan result
+const std::size_t BENCH_SENDS_PER_CLIENT = 4;     // WEBSOCKET_SENDS_PER_CLIENT in CaptivePortalInstance.cpp
+const int BENCH_BROADCAST_INTERVAL_US    = 1000;
+const int BENCH_SLOW_SEND_US             = 300;
+
+struct ClientLog {
+  std::vector<std::uint32_t> sequences;
+};
+
+static std::vector<std::uint8_t> _message(std::uint32_t sequence) {
+  std::vector<std::uint8_t> message(BENCH_MESSAGE_SIZE, static_cast<std::uint8_t>(sequence));
+  std::memcpy(message.data(), &sequence, sizeof(sequence));
+  return message;
+}
+
+static std::uint32_t _sequenceOf(const std::uint8_t* data) {
+  std::uint32_t sequence;
+  std::memcpy(&sequence, data, sizeof(sequence));
+  return sequence;
+}
+
+static void _addClients(LocalOutboundQueue& queue) {
+  for (std::uint8_t socketId = 0; socketId < BENCH_CLIENTS; ++socketId) {
+    TEST_ASSERT_TRUE(queue.AddClient(socketId));
+  }
+}
+
+void setUp(void) { }
+void tearDown(void) { }
+
+void test_broadcast_is_shared(void) {
+  LocalOutboundQueue queue;
+  _addClients(queue);
+
+  auto message = _message(1);
+  TEST_ASSERT_TRUE(queue.Broadcast(true, message.data(), message.size()));
+
+  std::vector<const std::uint8_t*> seen;
+  bool intact         = true;
+  std::size_t drained = queue.Drain(BENCH_SENDS_PER_CLIENT, [&](std::uint8_t, bool binary, const std::uint8_t* data, std::size_t length) {
+    intact &= binary && length == BENCH_MESSAGE_SIZE && _sequenceOf(data) == 1;
+    seen.push_back(data);
+    return true;
+  });
+
+  // Serialized once: every client is handed the same bytes, not a copy of them
+  TEST_ASSERT_EQUAL_size_t(BENCH_CLIENTS, drained);
+  TEST_ASSERT_TRUE(intact);
+  for (const std::uint8_t* data : seen) {
+    TEST_ASSERT_TRUE(data == seen.front());
+  }
+  TEST_ASSERT_TRUE(seen.front() != message.data());
+
+  LocalOutboundQueue::Stats stats = queue.GetStats();
+  TEST_ASSERT_EQUAL_UINT32(1, stats.broadcasts);
+  TEST_ASSERT_EQUAL_UINT32(BENCH_CLIENTS, stats.sent);
+  TEST_ASSERT_FALSE(queue.HasPending());
+}
+
+void test_unicast_only_reaches_its_client(void) {
+  LocalOutboundQueue queue;
+  _addClients(queue);
+
+  auto message = _message(7);
+  TEST_ASSERT_TRUE(queue.Send(3, true, message.data(), message.size()));
+  TEST_ASSERT_FALSE(queue.Send(static_cast<std::uint8_t>(BENCH_CLIENTS), true, message.data(), message.size()));
+
+  queue.RemoveClient(4);
+  TEST_ASSERT_FALSE(queue.Send(4, true, message.data(), message.size()));
+
+  std::vector<std::uint8_t> receivers;
+  queue.Drain(BENCH_SENDS_PER_CLIENT, [&](std::uint8_t socketId, bool, const std::uint8_t*, std::size_t) {
+    receivers.push_back(socketId);
+    return true;
+  });
+
+  TEST_ASSERT_EQUAL_size_t(1, receivers.size());
+  TEST_ASSERT_EQUAL_UINT8(3, receivers.front());
+}
+
+void test_backlog_drops_oldest(void) {
+  LocalOutboundQueue queue;
+  TEST_ASSERT_TRUE(queue.AddClient(0));
+
+  for (std::uint32_t sequence = 0; sequence < LocalOutboundQueue::kClientCapacity + 3; ++sequence) {
+    auto message = _message(sequence);
+    queue.Broadcast(true, message.data(), message.size());
+  }
+
+  std::vector<std::uint32_t> sequences;
+  queue.Drain(LocalOutboundQueue::kClientCapacity * 2, [&](std::uint8_t, bool, const std::uint8_t* data, std::size_t) {
+    sequences.push_back(_sequenceOf(data));
+    return true;
+  });
+
+  TEST_ASSERT_EQUAL_size_t(LocalOutboundQueue::kClientCapacity, sequences.size());
+  TEST_ASSERT_EQUAL_UINT32(3, sequences.front());
+  TEST_ASSERT_EQUAL_UINT32(LocalOutboundQueue::kClientCapacity + 2, sequences.back());
+  TEST_ASSERT_EQUAL_UINT32(3, queue.GetStats().dropped);
+}
+
+void test_fan_out_cost(void) {
+  const int iterations = 20'000;
+
+  auto message = _message(1);
+
+  // Copying once and sharing the buffer, against what every client used to cost: its own copy of the serialized message
+  LocalOutboundQueue shared;
+  _addClients(shared);
+
+  auto startShared = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    shared.Broadcast(true, message.data(), message.size());
+  }
+  auto sharedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startShared).count();
+
+  LocalOutboundQueue copied;
+  _addClients(copied);
+
+  auto startCopied = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    for (std::uint8_t socketId = 0; socketId < BENCH_CLIENTS; ++socketId) {
+      copied.Send(socketId, true, message.data(), message.size());
+    }
+  }
+  auto copiedNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - startCopied).count();
+
+  char report[160];
+  std::snprintf(report, sizeof(report), "Fan-out to %zu clients: shared %.2f us, copied per client %.2f us per broadcast of %zu bytes", BENCH_CLIENTS, sharedNs / 1000.0 / iterations, copiedNs / 1000.0 / iterations, BENCH_MESSAGE_SIZE);
+  TEST_MESSAGE(report);
+
+  TEST_ASSERT_EQUAL_UINT32(iterations, shared.GetStats().broadcasts);
+}
+
+struct FanOutResult {
+  std::int64_t maxFastLatencyUs;
+  bool inOrder;
+  LocalOutboundQueue::Stats stats;
+};
+
+static FanOutResult _runFanOut(std::uint32_t messages, int slowSendUs) {
+  LocalOutboundQueue queue;
+  _addClients(queue);
+
+  ClientLog logs[BENCH_CLIENTS];
+  std::atomic<bool> producerDone {false};
+  std::vector<std::int64_t> queuedAtUs(messages);
+  std::int64_t maxFastLatencyUs = 0;
+
+  // Stands in for the portal task: drains with the same per-client budget, one write at a time
+  std::thread portal([&] {
+    while (!producerDone || queue.HasPending()) {
+      queue.Drain(BENCH_SENDS_PER_CLIENT, [&](std::uint8_t socketId, bool, const std::uint8_t* data, std::size_t) {
+        std::uint32_t sequence = _sequenceOf(data);
+        logs[socketId].sequences.push_back(sequence);
+
+        if (socketId == BENCH_SLOW_CLIENT && slowSendUs > 0) {
+          std::this_thread::sleep_for(std::chrono::microseconds(slowSendUs));  // Socket buffer full, the write waits for the browser to read
+        } else {
+          maxFastLatencyUs = std::max(maxFastLatencyUs, OpenShock::micros() - queuedAtUs[sequence]);
+        }
+
+        return true;
+      });
+
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  });
+
+  // Stands in for WiFiManager and the command handlers broadcasting state changes
+  for (std::uint32_t sequence = 0; sequence < messages; ++sequence) {
+    auto message         = _message(sequence);
+    queuedAtUs[sequence] = OpenShock::micros();
+    queue.Broadcast(true, message.data(), message.size());
+
+    std::this_thread::sleep_for(std::chrono::microseconds(BENCH_BROADCAST_INTERVAL_US));
+  }
+  producerDone = true;
+  portal.join();
+
+  bool inOrder = true;
+  for (const auto& log : logs) {
+    if (log.sequences.size() != messages) {
+      inOrder = false;
+      continue;
+    }
+
+    for (std::uint32_t i = 0; i < messages; ++i) {
+      inOrder &= log.sequences[i] == i;
+    }
+  }
+
+  return FanOutResult {maxFastLatencyUs, inOrder, queue.GetStats()};
+}
+
+void test_slow_client_fan_out(void) {
+  const std::uint32_t messages = 400;
+
+  FanOutResult fast = _runFanOut(messages, 0);
+  FanOutResult slow = _runFanOut(messages, BENCH_SLOW_SEND_US);
+
+  char report[192];
+  std::snprintf(report, sizeof(report), "%zu clients, %u broadcasts: worst latency %lld us with all clients fast, %lld us for the fast clients next to a slow one", BENCH_CLIENTS, messages, static_cast<long long>(fast.maxFastLatencyUs), static_cast<long long>(slow.maxFastLatencyUs));
+  TEST_MESSAGE(report);
+
+  // A slow reader costs the others at most its share of each drain, every client still gets every broadcast in order
+  TEST_ASSERT_TRUE(fast.inOrder);
+  TEST_ASSERT_TRUE(slow.inOrder);
+  TEST_ASSERT_EQUAL_UINT32(0, fast.stats.dropped);
+  TEST_ASSERT_EQUAL_UINT32(0, slow.stats.dropped);
+  TEST_ASSERT_EQUAL_UINT32(messages, slow.stats.broadcasts);
+  TEST_ASSERT_EQUAL_UINT32(messages * BENCH_CLIENTS, slow.stats.sent);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_broadcast_is_shared);
+  RUN_TEST(test_unicast_only_reaches_its_client);
+  RUN_TEST(test_backlog_drops_oldest);
+  RUN_TEST(test_fan_out_cost);
+  RUN_TEST(test_slow_client_fan_out);
+  return UNITY_END();
+}
@@ -0,0 +1,205 @@
+#include "config/internal/RawPartition.h"
+
+// test_build_src is off for the native env, so the unit under test is compiled into the suite
+#include "../../src/config/internal/RawPartition.cpp"
+
+#include <unity.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+// The partition is a file mapped the way the firmware maps flash, see test/shims/esp_partition.h. Its size matches the rawconfig entry in
+// chips/partitions_4MB_OTA.csv, which gives two slots of two sectors each.
+
+using namespace OpenShock::Config::Internal;
+
+const std::uint32_t PARTITION_SIZE = 0x4000;
+const std::uint32_t SLOT_SIZE      = PARTITION_SIZE / 2;
+const std::uint32_t MAX_PAYLOAD    = SLOT_SIZE - sizeof(RawPartition::SlotHeader);
+
+static esp_partition_t s_hostPartition;
+static char s_hostPath[32];
+
+static void _attachPartition(std::uint32_t size) {
+  std::strcpy(s_hostPath, "/tmp/rawconfig-XXXXXX");
+  int fd = mkstemp(s_hostPath);
+
+  std::string erased(size, '\xFF');
+  TEST_ASSERT_EQUAL_INT(static_cast<int>(size), static_cast<int>(write(fd, erased.data(), erased.size())));
+
+  s_hostPartition = esp_partition_t {.type = ESP_PARTITION_TYPE_DATA, .subtype = ESP_PARTITION_SUBTYPE_DATA_UNDEFINED, .address = 0x3FC000, .size = size, .label = "rawconfig", .encrypted = false, .fd = fd};
+  g_hostPartition = &s_hostPartition;
+}
+
+static bool _write(const std::string& config) {
+  return RawPartition::Write(reinterpret_cast<const std::uint8_t*>(config.data()), config.size());
+}
+
+static std::string _latest() {
+  const std::uint8_t* data;
+  std::uint32_t size;
+  if (!RawPartition::GetLatest(data, size)) {
+    return "<none>";
+  }
+
+  return std::string(reinterpret_cast<const char*>(data), size);
+}
+
+void setUp(void) { }
+void tearDown(void) {
+  if (g_hostPartition != nullptr) {
+    close(g_hostPartition->fd);
+    unlink(s_hostPath);
+  }
+
+  g_hostPartition    = nullptr;
+  g_hostFlashOpsLeft = -1;
+}
+
+// Run after the others, so a failed Init also has to drop the mapping an earlier one left behind
+void test_missing_partition(void) {
+  TEST_ASSERT_FALSE(RawPartition::Init());
+  TEST_ASSERT_FALSE(RawPartition::IsAvailable());
+  TEST_ASSERT_FALSE(_write("config"));
+}
+
+void test_partition_too_small(void) {
+  _attachPartition(RawPartition::kSectorSize);
+
+  TEST_ASSERT_FALSE(RawPartition::Init());
+  TEST_ASSERT_FALSE(RawPartition::IsAvailable());
+}
+
+void test_erased_partition_holds_no_config(void) {
+  _attachPartition(PARTITION_SIZE);
+
+  TEST_ASSERT_TRUE(RawPartition::Init());
+  TEST_ASSERT_TRUE(RawPartition::IsAvailable());
+  TEST_ASSERT_EQUAL_STRING("<none>", _latest().c_str());
+}
+
+void test_writes_alternate_slots(void) {
+  _attachPartition(PARTITION_SIZE);
+  TEST_ASSERT_TRUE(RawPartition::Init());
+
+  const std::uint8_t* first;
+  const std::uint8_t* second;
+  const std::uint8_t* third;
+  std::uint32_t size;
+
+  TEST_ASSERT_TRUE(_write("one"));
+  TEST_ASSERT_TRUE(RawPartition::GetLatest(first, size));
+  TEST_ASSERT_TRUE(_write("two"));
+  TEST_ASSERT_TRUE(RawPartition::GetLatest(second, size));
+  TEST_ASSERT_TRUE(_write("three"));
+  TEST_ASSERT_TRUE(RawPartition::GetLatest(third, size));
+
+  // Read in place from the mapping, which sees every write without being remapped
+  TEST_ASSERT_EQUAL_STRING("three", _latest().c_str());
+  TEST_ASSERT_EQUAL_INT(SLOT_SIZE, second - first);
+  TEST_ASSERT_TRUE(third == first);
+}
+
+void test_config_survives_reboot(void) {
+  _attachPartition(PARTITION_SIZE);
+  TEST_ASSERT_TRUE(RawPartition::Init());
+
+  for (int i = 0; i < 5; ++i) {
+    TEST_ASSERT_TRUE(_write("config-" + std::to_string(i)));
+  }
+
+  TEST_ASSERT_TRUE(RawPartition::Init());
+  TEST_ASSERT_EQUAL_STRING("config-4", _latest().c_str());
+}
+
+void test_power_loss_keeps_previous_config(void) {
+  _attachPartition(PARTITION_SIZE);
+  TEST_ASSERT_TRUE(RawPartition::Init());
+  TEST_ASSERT_TRUE(_write("stable"));
+
+  // A write is an erase, the payload and then the header, power is lost before each of them in turn
+  for (int opsLeft = 0; opsLeft < 3; ++opsLeft) {
+    g_hostFlashOpsLeft = opsLeft;
+    TEST_ASSERT_FALSE(_write("interrupted"));
+    g_hostFlashOpsLeft = -1;
+
+    TEST_ASSERT_TRUE(RawPartition::Init());
+    TEST_ASSERT_EQUAL_STRING("stable", _latest().c_str());
+  }
+
+  TEST_ASSERT_TRUE(_write("next"));
+  TEST_ASSERT_EQUAL_STRING("next", _latest().c_str());
+}
+
+void test_corrupt_slot_falls_back(void) {
+  _attachPartition(PARTITION_SIZE);
+  TEST_ASSERT_TRUE(RawPartition::Init());
+  TEST_ASSERT_TRUE(_write("older"));
+  TEST_ASSERT_TRUE(_write("newer"));
+
+  // Newer config lives in the second slot, clearing bits in its payload is what a worn out or disturbed cell looks like
+  std::uint8_t zero = 0;
+  TEST_ASSERT_EQUAL_INT(1, static_cast<int>(pwrite(s_hostPartition.fd, &zero, 1, SLOT_SIZE + sizeof(RawPartition::SlotHeader))));
+
+  TEST_ASSERT_EQUAL_STRING("older", _latest().c_str());
+
+  // The next write goes over the corrupt slot rather than the one still holding a good config
+  TEST_ASSERT_TRUE(_write("repaired"));
+  TEST_ASSERT_EQUAL_STRING("repaired", _latest().c_str());
+}
+
+void test_oversized_config_is_rejected(void) {
+  _attachPartition(PARTITION_SIZE);
+  TEST_ASSERT_TRUE(RawPartition::Init());
+  TEST_ASSERT_TRUE(_write("small"));
+
+  TEST_ASSERT_FALSE(_write(std::string(MAX_PAYLOAD + 1, 'x')));
+  TEST_ASSERT_EQUAL_STRING("small", _latest().c_str());
+
+  std::string largest(MAX_PAYLOAD, 'x');
+  TEST_ASSERT_TRUE(_write(largest));
+  TEST_ASSERT_TRUE(_latest() == largest);
+}
+
+void test_sequence_wraps(void) {
+  static std::uint8_t image[PARTITION_SIZE];
+  std::memset(image, 0xFF, sizeof(image));
+
+  auto putSlot = [](int slot, std::uint32_t sequence) {
+    std::uint8_t payload = static_cast<std::uint8_t>(slot);
+
+    RawPartition::SlotHeader header {
+      .magic    = RawPartition::kSlotMagic,
+      .sequence = sequence,
+      .size     = 1,
+      .checksum = OpenShock::Checksum::ComputeBuffer<OpenShock::Checksum::CRC8Autosar>(&payload, 1),
+      .reserved = {0xFF, 0xFF, 0xFF},
+    };
+
+    std::memcpy(image + slot * SLOT_SIZE, &header, sizeof(header));
+    image[slot * SLOT_SIZE + sizeof(header)] = payload;
+  };
+
+  putSlot(0, 0xFFFFFFFF);
+  putSlot(1, 0);
+  TEST_ASSERT_EQUAL_INT(1, RawPartition::FindLatestSlot(image, PARTITION_SIZE, SLOT_SIZE));
+
+  putSlot(0, 1);
+  TEST_ASSERT_EQUAL_INT(0, RawPartition::FindLatestSlot(image, PARTITION_SIZE, SLOT_SIZE));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_erased_partition_holds_no_config);
+  RUN_TEST(test_writes_alternate_slots);
+  RUN_TEST(test_config_survives_reboot);
+  RUN_TEST(test_power_loss_keeps_previous_config);
+  RUN_TEST(test_corrupt_slot_falls_back);
+  RUN_TEST(test_oversized_config_is_rejected);
+  RUN_TEST(test_sequence_wraps);
+  RUN_TEST(test_missing_partition);
+  RUN_TEST(test_partition_too_small);
+  return UNITY_END();
+}
@@ -0,0 +1,306 @@
+#include "ReadWriteMutex.h"
+
+// test_build_src is off for the native env, so the unit under test is compiled into the suite
+#include "../../src/ReadWriteMutex.cpp"
+
+#include <unity.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace OpenShock;
+
+const int STRESS_READERS = 6;
+const int STRESS_WRITERS = 2;
+const std::chrono::milliseconds STRESS_DURATION(1500);
+
+static void _sleepUs(int us) {
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+static ReadWriteMutex::Stats _stats(const ReadWriteMutex& mutex) {
+  ReadWriteMutex::Stats stats {};
+  mutex.getStats(stats);
+  return stats;
+}
+
+// Waits until a thread is blocked inside lockWrite with the writer flag raised, new readers fail to get in from then on
+static bool _waitForPendingWriter(ReadWriteMutex& mutex) {
+  for (int i = 0; i < 1000; ++i) {
+    if (!mutex.lockRead(0)) {
+      return true;
+    }
+    mutex.unlockRead();
+    _sleepUs(100);
+  }
+
+  return false;
+}
+
+void setUp(void) { }
+void tearDown(void) {
+  g_semaphoreTimeoutHook = nullptr;
+}
+
+void test_readers_share(void) {
+  ReadWriteMutex mutex("Test");
+
+  TEST_ASSERT_TRUE(mutex.lockRead(0));
+  TEST_ASSERT_TRUE(mutex.lockRead(0));
+  TEST_ASSERT_FALSE(mutex.lockWrite(0));
+  mutex.unlockRead();
+  mutex.unlockRead();
+
+  TEST_ASSERT_TRUE(mutex.lockWrite(0));
+  TEST_ASSERT_FALSE(mutex.lockRead(0));
+  TEST_ASSERT_FALSE(mutex.lockWrite(0));
+  mutex.unlockWrite();
+
+  ReadWriteMutex::Stats stats = _stats(mutex);
+  TEST_ASSERT_EQUAL_UINT32(2, stats.readLocks);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.writeLocks);
+  TEST_ASSERT_EQUAL_UINT32(3, stats.timeouts);
+}
+
+void test_unmatched_unlock_read_is_ignored(void) {
+  ReadWriteMutex mutex;
+
+  mutex.unlockRead();
+
+  // The reader count must not have gone negative, or this writer would wait for a reader that does not exist
+  TEST_ASSERT_TRUE(mutex.lockWrite(0));
+  mutex.unlockWrite();
+}
+
+void test_waiting_writer_blocks_new_readers(void) {
+  ReadWriteMutex mutex("Test");
+
+  TEST_ASSERT_TRUE(mutex.lockRead(0));
+
+  // Unity can not fail from another thread, so the threads only report back and the test thread asserts
+  std::atomic<bool> writerIn {false};
+  std::thread writer([&] {
+    if (mutex.lockWrite(portMAX_DELAY)) {
+      writerIn = true;
+      mutex.unlockWrite();
+    }
+  });
+
+  TEST_ASSERT_TRUE(_waitForPendingWriter(mutex));
+  TEST_ASSERT_FALSE(writerIn.load());
+
+  mutex.unlockRead();
+  writer.join();
+  TEST_ASSERT_TRUE(writerIn.load());
+
+  TEST_ASSERT_TRUE(mutex.lockRead(0));
+  mutex.unlockRead();
+}
+
+void test_lock_write_timeout_releases_readers(void) {
+  ReadWriteMutex mutex("Test");
+
+  TEST_ASSERT_TRUE(mutex.lockRead(0));
+
+  std::int64_t startUs = esp_timer_get_time();
+  TEST_ASSERT_FALSE(mutex.lockWrite(pdMS_TO_TICKS(20)));
+  TEST_ASSERT_GREATER_OR_EQUAL(19'000, esp_timer_get_time() - startUs);
+
+  // The timed out writer must drop its flag and the write mutex, otherwise readers and the next writer stay locked out
+  TEST_ASSERT_TRUE(mutex.lockRead(0));
+  mutex.unlockRead();
+  mutex.unlockRead();
+
+  TEST_ASSERT_TRUE(mutex.lockWrite(0));
+  mutex.unlockWrite();
+
+  TEST_ASSERT_EQUAL_UINT32(1, _stats(mutex).timeouts);
+}
+
+void test_lock_write_timeout_behind_writer(void) {
+  ReadWriteMutex mutex;
+
+  TEST_ASSERT_TRUE(mutex.lockWrite(0));
+
+  std::atomic<bool> otherResult {true};
+  std::thread other([&] { otherResult = mutex.lockWrite(pdMS_TO_TICKS(10)); });
+  other.join();
+  TEST_ASSERT_FALSE(otherResult.load());
+
+  TEST_ASSERT_FALSE(mutex.lockRead(pdMS_TO_TICKS(10)));
+  mutex.unlockWrite();
+
+  TEST_ASSERT_TRUE(mutex.lockRead(0));
+  mutex.unlockRead();
+}
+
+static ReadWriteMutex* s_staleMutex = nullptr;
+
+static void _unlockReaderOnTimeout(SemaphoreHandle_t) {
+  // Runs once the drain wait has timed out but before the writer clears its flag, so the last reader out gives the semaphore to nobody
+  g_semaphoreTimeoutHook = nullptr;
+  s_staleMutex->unlockRead();
+}
+
+void test_stale_readers_drained_give(void) {
+  ReadWriteMutex mutex("Test");
+  s_staleMutex = &mutex;
+
+  TEST_ASSERT_TRUE(mutex.lockRead(0));
+
+  g_semaphoreTimeoutHook = _unlockReaderOnTimeout;
+  TEST_ASSERT_FALSE(mutex.lockWrite(pdMS_TO_TICKS(5)));
+  TEST_ASSERT_NULL(g_semaphoreTimeoutHook);
+
+  // The drained semaphore is now given while a reader is inside, the next writer must not take that as the readers having left
+  TEST_ASSERT_TRUE(mutex.lockRead(0));
+
+  std::atomic<bool> writerResult {true};
+  std::thread writer([&] { writerResult = mutex.lockWrite(pdMS_TO_TICKS(30)); });
+  writer.join();
+
+  TEST_ASSERT_FALSE(writerResult.load());
+  mutex.unlockRead();
+
+  TEST_ASSERT_TRUE(mutex.lockWrite(0));
+  mutex.unlockWrite();
+
+  TEST_ASSERT_EQUAL_UINT32(2, _stats(mutex).timeouts);
+}
+
+void test_registry(void) {
+  std::vector<ReadWriteMutex::Stats> stats;
+  ReadWriteMutex::GetAllStats(stats);
+  std::size_t before = stats.size();
+
+  {
+    ReadWriteMutex named("Registered");
+    ReadWriteMutex unnamed;
+
+    ReadWriteMutex::Stats unnamedStats;
+    TEST_ASSERT_FALSE(unnamed.getStats(unnamedStats));
+
+    stats.clear();
+    ReadWriteMutex::GetAllStats(stats);
+    TEST_ASSERT_EQUAL_size_t(before + 1, stats.size());
+    TEST_ASSERT_EQUAL_STRING("Registered", stats.front().name);
+  }
+
+  stats.clear();
+  ReadWriteMutex::GetAllStats(stats);
+  TEST_ASSERT_EQUAL_size_t(before, stats.size());
+}
+
+void test_fairness_stress(void) {
+  ReadWriteMutex mutex("Stress");
+
+  std::atomic<int> readersIn {0};
+  std::atomic<int> writersIn {0};
+  std::atomic<std::uint32_t> violations {0};
+  std::atomic<bool> stop {false};
+
+  std::atomic<std::uint32_t> reads[STRESS_READERS]  = {};
+  std::atomic<std::uint32_t> writes[STRESS_WRITERS] = {};
+  std::atomic<std::uint32_t> timedOut {0};
+
+  std::vector<std::thread> threads;
+
+  // Readers overlap so there is never a gap between them, a reader-preferring lock would starve the writers here
+  for (int i = 0; i < STRESS_READERS; ++i) {
+    threads.emplace_back([&, i] {
+      std::uint32_t n = 0;
+      while (!stop) {
+        // Every fourth reader gives up quickly, which keeps timed out readers in the mix
+        TickType_t wait = (n++ % 4) == 0 ? pdMS_TO_TICKS(1) : portMAX_DELAY;
+        if (!mutex.lockRead(wait)) {
+          ++timedOut;
+          continue;
+        }
+
+        ++readersIn;
+        if (writersIn != 0) {
+          ++violations;
+        }
+        _sleepUs(300);
+        --readersIn;
+
+        mutex.unlockRead();
+        ++reads[i];
+      }
+    });
+  }
+
+  for (int i = 0; i < STRESS_WRITERS; ++i) {
+    threads.emplace_back([&, i] {
+      std::uint32_t n = 0;
+      while (!stop) {
+        // Short timeouts race the last reader out, which is what leaves stale gives on the drained semaphore
+        TickType_t wait = (n++ % 3) == 0 ? pdMS_TO_TICKS(1) : portMAX_DELAY;
+        if (!mutex.lockWrite(wait)) {
+          ++timedOut;
+          continue;
+        }
+
+        if (writersIn++ != 0 || readersIn != 0) {
+          ++violations;
+        }
+        _sleepUs(100);
+        --writersIn;
+
+        mutex.unlockWrite();
+        ++writes[i];
+        _sleepUs(500);
+      }
+    });
+  }
+
+  std::this_thread::sleep_for(STRESS_DURATION);
+  stop = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  TEST_ASSERT_EQUAL_UINT32(0, violations.load());
+
+  // Nobody starves: every writer keeps getting in despite the reader flood, and readers still get through between writers
+  for (int i = 0; i < STRESS_WRITERS; ++i) {
+    TEST_ASSERT_GREATER_THAN(50, writes[i].load());
+  }
+  std::uint32_t totalReads = 0, totalWrites = 0;
+  for (int i = 0; i < STRESS_READERS; ++i) {
+    TEST_ASSERT_GREATER_THAN(50, reads[i].load());
+    totalReads += reads[i];
+  }
+  for (int i = 0; i < STRESS_WRITERS; ++i) {
+    totalWrites += writes[i];
+  }
+
+  ReadWriteMutex::Stats stats = _stats(mutex);
+  TEST_ASSERT_EQUAL_UINT32(totalReads, stats.readLocks);
+  TEST_ASSERT_EQUAL_UINT32(totalWrites, stats.writeLocks);
+  TEST_ASSERT_EQUAL_UINT32(timedOut.load(), stats.timeouts);
+  TEST_ASSERT_GREATER_THAN(0, stats.contended);
+  TEST_ASSERT_LESS_OR_EQUAL(stats.totalWaitUs, stats.maxWaitUs);
+
+  // Whatever the timeouts left behind, the lock must be idle again
+  TEST_ASSERT_TRUE(mutex.lockWrite(0));
+  mutex.unlockWrite();
+  TEST_ASSERT_TRUE(mutex.lockRead(0));
+  mutex.unlockRead();
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_readers_share);
+  RUN_TEST(test_unmatched_unlock_read_is_ignored);
+  RUN_TEST(test_waiting_writer_blocks_new_readers);
+  RUN_TEST(test_lock_write_timeout_releases_readers);
+  RUN_TEST(test_lock_write_timeout_behind_writer);
+  RUN_TEST(test_stale_readers_drained_give);
+  RUN_TEST(test_registry);
+  RUN_TEST(test_fairness_stress);
+  return UNITY_END();
+}
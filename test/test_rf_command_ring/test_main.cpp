@@ -0,0 +1,254 @@
+#include "radio/RFCommandRing.h"
+
+// test_build_src is off for the native env, so the unit under test is compiled into the suite
+#include "../../src/radio/RFCommandRing.cpp"
+
+#include <unity.h>
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using namespace OpenShock;
+
+const std::uint16_t STRESS_SHOCKERS = 5;
+const std::uint32_t STRESS_COMMANDS = 200'000;
+
+// Every field carries the same sequence number, so a command torn by a racing overwrite shows up as a mismatch
+static RFCommandRing::Command _command(std::uint16_t shockerId, std::uint32_t sequence, bool overwrite) {
+  RFCommandRing::Command command {};
+  command.model     = ShockerModelType::Petrainer;
+  command.shockerId = shockerId;
+  command.overwrite = overwrite;
+  command.untilUs   = sequence;
+  command.queuedUs  = sequence;
+  command.traceId   = sequence;
+  command.sequence  = Rmt::GetSequence(ShockerModelType::Petrainer, shockerId, ShockerCommandType::Shock, static_cast<std::uint8_t>(sequence % 101));
+  return command;
+}
+
+static bool _isIntact(const RFCommandRing::Command& command) {
+  std::uint32_t sequence = command.traceId;
+  if (command.untilUs != sequence || command.queuedUs != sequence) {
+    return false;
+  }
+
+  Rmt::Sequence expected = Rmt::GetSequence(ShockerModelType::Petrainer, command.shockerId, ShockerCommandType::Shock, static_cast<std::uint8_t>(sequence % 101));
+  if (expected.size() != command.sequence.size()) {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    if (expected.pulses[i].val != command.sequence.pulses[i].val) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void setUp(void) { }
+void tearDown(void) { }
+
+void test_push_pop_in_order(void) {
+  RFCommandRing ring;
+
+  for (std::uint16_t id = 0; id < 4; ++id) {
+    TEST_ASSERT_TRUE(ring.Push(_command(id, id, false)));
+  }
+
+  RFCommandRing::Command out;
+  for (std::uint16_t id = 0; id < 4; ++id) {
+    TEST_ASSERT_TRUE(ring.Pop(out));
+    TEST_ASSERT_EQUAL_UINT16(id, out.shockerId);
+  }
+  TEST_ASSERT_FALSE(ring.Pop(out));
+}
+
+void test_overwrite_coalesces_in_place(void) {
+  RFCommandRing ring;
+
+  TEST_ASSERT_TRUE(ring.Push(_command(1, 10, true)));
+  TEST_ASSERT_TRUE(ring.Push(_command(2, 11, true)));
+  TEST_ASSERT_TRUE(ring.Push(_command(1, 12, true)));
+
+  RFCommandRing::Stats stats = ring.GetStats();
+  TEST_ASSERT_EQUAL_UINT32(2, stats.pushed);
+  TEST_ASSERT_EQUAL_UINT32(1, stats.coalesced);
+
+  // Shocker 1 keeps its place in the queue but carries the newer command
+  RFCommandRing::Command out;
+  TEST_ASSERT_TRUE(ring.Pop(out));
+  TEST_ASSERT_EQUAL_UINT16(1, out.shockerId);
+  TEST_ASSERT_EQUAL_UINT32(12, out.traceId);
+  TEST_ASSERT_TRUE(_isIntact(out));
+
+  TEST_ASSERT_TRUE(ring.Pop(out));
+  TEST_ASSERT_EQUAL_UINT16(2, out.shockerId);
+  TEST_ASSERT_FALSE(ring.Pop(out));
+}
+
+void test_no_overwrite_queues_behind(void) {
+  RFCommandRing ring;
+
+  TEST_ASSERT_TRUE(ring.Push(_command(1, 10, false)));
+  TEST_ASSERT_TRUE(ring.Push(_command(1, 11, true)));
+
+  RFCommandRing::Command out;
+  TEST_ASSERT_TRUE(ring.Pop(out));
+  TEST_ASSERT_EQUAL_UINT32(10, out.traceId);
+  TEST_ASSERT_TRUE(ring.Pop(out));
+  TEST_ASSERT_EQUAL_UINT32(11, out.traceId);
+  TEST_ASSERT_EQUAL_UINT32(0, ring.GetStats().coalesced);
+}
+
+void test_same_id_other_model_is_not_coalesced(void) {
+  RFCommandRing ring;
+
+  RFCommandRing::Command caiXianlin = _command(1, 10, true);
+  caiXianlin.model                  = ShockerModelType::CaiXianlin;
+
+  TEST_ASSERT_TRUE(ring.Push(caiXianlin));
+  TEST_ASSERT_TRUE(ring.Push(_command(1, 11, true)));
+  TEST_ASSERT_EQUAL_UINT32(2, ring.GetStats().pushed);
+  TEST_ASSERT_EQUAL_UINT32(0, ring.GetStats().coalesced);
+}
+
+void test_full_ring_drops(void) {
+  RFCommandRing ring;
+
+  for (std::uint16_t id = 0; id < RFCommandRing::kCapacity; ++id) {
+    TEST_ASSERT_TRUE(ring.Push(_command(id, id, false)));
+  }
+  TEST_ASSERT_FALSE(ring.Push(_command(0xFFFF, 0, false)));
+  TEST_ASSERT_EQUAL_UINT32(1, ring.GetStats().dropped);
+
+  // Popping one record frees exactly one slot
+  RFCommandRing::Command out;
+  TEST_ASSERT_TRUE(ring.Pop(out));
+  TEST_ASSERT_TRUE(ring.Push(_command(0xFFFF, 1, false)));
+}
+
+void test_cancel_skips_pending(void) {
+  RFCommandRing ring;
+
+  TEST_ASSERT_TRUE(ring.Push(_command(1, 1, false)));
+  TEST_ASSERT_TRUE(ring.Push(_command(2, 2, false)));
+  ring.Cancel();
+  TEST_ASSERT_TRUE(ring.Push(_command(3, 3, false)));
+
+  RFCommandRing::Command out;
+  TEST_ASSERT_TRUE(ring.Pop(out));
+  TEST_ASSERT_EQUAL_UINT16(3, out.shockerId);
+  TEST_ASSERT_FALSE(ring.Pop(out));
+
+  // Cancelled records are handed back, so the ring is usable to its full capacity again
+  for (std::uint16_t id = 0; id < RFCommandRing::kCapacity; ++id) {
+    TEST_ASSERT_TRUE(ring.Push(_command(id, id, false)));
+  }
+}
+
+void test_spsc_stress(void) {
+  RFCommandRing ring;
+
+  // Accepted commands per shocker, in push order, and which of them must never be coalesced away
+  std::vector<std::vector<std::uint32_t>> accepted(STRESS_SHOCKERS);
+  std::vector<std::vector<bool>> mustArrive(STRESS_SHOCKERS);
+
+  std::atomic<bool> producerDone {false};
+  std::vector<std::vector<std::uint32_t>> popped(STRESS_SHOCKERS);
+  std::uint32_t torn = 0;
+
+  std::thread consumer([&] {
+    RFCommandRing::Command out;
+    while (true) {
+      bool done = producerDone.load(std::memory_order_acquire);
+
+      if (ring.Pop(out)) {
+        if (!_isIntact(out)) {
+          ++torn;
+        }
+        popped[out.shockerId].push_back(out.traceId);
+        continue;
+      }
+
+      if (done) {
+        break;
+      }
+
+      std::this_thread::yield();
+    }
+  });
+
+  std::thread producer([&] {
+    std::uint32_t state = 12345;
+    for (std::uint32_t sequence = 1; sequence <= STRESS_COMMANDS; ++sequence) {
+      state = state * 1103515245 + 12345;  // Deterministic mix of shockers and overwrite flags
+
+      std::uint16_t shockerId = (state >> 16) % STRESS_SHOCKERS;
+      bool overwrite          = ((state >> 8) & 3) != 0;
+
+      RFCommandRing::Command command = _command(shockerId, sequence, overwrite);
+      while (!ring.Push(command)) {
+        std::this_thread::yield();
+      }
+
+      accepted[shockerId].push_back(sequence);
+      mustArrive[shockerId].push_back(!overwrite);
+    }
+
+    producerDone.store(true, std::memory_order_release);
+  });
+
+  producer.join();
+  consumer.join();
+
+  TEST_ASSERT_EQUAL_UINT32(0, torn);
+
+  RFCommandRing::Stats stats = ring.GetStats();
+  std::size_t totalPopped    = 0;
+
+  for (std::uint16_t id = 0; id < STRESS_SHOCKERS; ++id) {
+    const auto& in  = accepted[id];
+    const auto& out = popped[id];
+    totalPopped += out.size();
+
+    // No duplication, and order per shocker is kept
+    for (std::size_t i = 1; i < out.size(); ++i) {
+      TEST_ASSERT_LESS_THAN(out[i], out[i - 1]);
+    }
+
+    // No loss: the newest command always arrives, and anything missing was replaced by a newer one while it was pending and allowed to be
+    TEST_ASSERT_FALSE(out.empty());
+    TEST_ASSERT_EQUAL_UINT32(in.back(), out.back());
+
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < in.size(); ++i) {
+      if (j < out.size() && out[j] == in[i]) {
+        ++j;
+        continue;
+      }
+
+      TEST_ASSERT_FALSE_MESSAGE(mustArrive[id][i], "A command that may not be overwritten was lost");
+    }
+    TEST_ASSERT_EQUAL_size_t(out.size(), j);
+  }
+
+  // Every record pushed was popped exactly once, and every accepted command was either pushed or coalesced
+  TEST_ASSERT_EQUAL_size_t(stats.pushed, totalPopped);
+  TEST_ASSERT_EQUAL_UINT32(STRESS_COMMANDS, stats.pushed + stats.coalesced);
+  TEST_ASSERT_GREATER_THAN(0, stats.coalesced);
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_push_pop_in_order);
+  RUN_TEST(test_overwrite_coalesces_in_place);
+  RUN_TEST(test_no_overwrite_queues_behind);
+  RUN_TEST(test_same_id_other_model_is_not_coalesced);
+  RUN_TEST(test_full_ring_drops);
+  RUN_TEST(test_cancel_skips_pending);
+  RUN_TEST(test_spsc_stress);
+  return UNITY_END();
+}
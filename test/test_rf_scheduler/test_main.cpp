@@ -0,0 +1,381 @@
+#include "radio/RFScheduler.h"
+
+// test_build_src is off for the native env, so the unit under test is compiled into the suite
+#include "../../src/radio/RFScheduler.cpp"
+
+#include <unity.h>
+
+#include <cstdint>
+#include <vector>
+
+using namespace OpenShock;
+
+const std::int64_t FRAME_INTERVAL_US = 10'000;
+const std::int64_t END_DURATION_US   = 30'000;
+
+static RFScheduler::Config _config(RFScheduler::FairnessPolicy policy) {
+  return {
+    .policy                = policy,
+    .frameIntervalUs       = FRAME_INTERVAL_US,
+    .transmitEndDurationUs = END_DURATION_US,
+  };
+}
+
+static Rmt::Sequence _sequence(std::uint16_t shockerId, std::uint8_t intensity) {
+  return Rmt::GetSequence(ShockerModelType::Petrainer, shockerId, ShockerCommandType::Shock, intensity);
+}
+
+static bool _sameSequence(const Rmt::Sequence& a, const Rmt::Sequence& b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+
+  for (std::size_t i = 0; i < a.size(); ++i) {
+    if (a.pulses[i].val != b.pulses[i].val) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool _submit(RFScheduler& scheduler, std::uint16_t shockerId, std::int64_t nowUs, std::int64_t durationUs, std::uint8_t intensity = 50, bool overwrite = true) {
+  return scheduler.Submit(ShockerModelType::Petrainer, shockerId, nowUs + durationUs, _sequence(shockerId, intensity), Rmt::GetZeroSequence(ShockerModelType::Petrainer, shockerId), overwrite, nowUs);
+}
+
+// Mirrors RFScheduler::slotIndexFor, used to pick IDs that collide in the table
+static std::size_t _homeSlot(std::uint16_t shockerId) {
+  return static_cast<std::uint16_t>(shockerId * 40503U) >> (16 - RFScheduler::kSlotBits);
+}
+
+void setUp(void) { }
+void tearDown(void) { }
+
+void test_fibonacci_hash_spreads_sequential_ids(void) {
+  bool seen[RFScheduler::kSlotCount] = {};
+  for (std::uint16_t id = 0; id < RFScheduler::kSlotCount; ++id) {
+    seen[_homeSlot(id)] = true;
+  }
+
+  std::size_t distinct = 0;
+  for (bool slot : seen) {
+    distinct += slot ? 1 : 0;
+  }
+
+  TEST_ASSERT_GREATER_OR_EQUAL(RFScheduler::kSlotCount * 3 / 4, distinct);
+}
+
+void test_table_full(void) {
+  RFScheduler scheduler(_config(RFScheduler::FairnessPolicy::RoundRobin));
+
+  for (std::uint16_t id = 1; id <= RFScheduler::kSlotCount; ++id) {
+    TEST_ASSERT_TRUE(_submit(scheduler, id, 0, 1'000'000));
+  }
+
+  TEST_ASSERT_FALSE(_submit(scheduler, 0xFFFF, 0, 1'000'000));
+
+  // Replacing a command for a shocker already in the table still works when full
+  TEST_ASSERT_TRUE(_submit(scheduler, 1, 0, 1'000'000, 10));
+
+  std::vector<RFScheduler::SlotStats> stats;
+  scheduler.GetSlotStats(stats);
+  TEST_ASSERT_EQUAL_size_t(RFScheduler::kSlotCount, stats.size());
+}
+
+void test_duplicate_key_replaces_in_place(void) {
+  RFScheduler scheduler(_config(RFScheduler::FairnessPolicy::RoundRobin));
+
+  TEST_ASSERT_TRUE(_submit(scheduler, 0x1234, 0, 100'000, 10));
+  TEST_ASSERT_TRUE(_submit(scheduler, 0x1234, 5, 100'000, 90));
+
+  std::vector<RFScheduler::SlotStats> stats;
+  scheduler.GetSlotStats(stats);
+  TEST_ASSERT_EQUAL_size_t(1, stats.size());
+
+  // The replacement keeps the original deadline, so it is due at 0 and carries the new waveform
+  RFScheduler::Transmission tx;
+  TEST_ASSERT_TRUE(scheduler.Pop(0, tx));
+  TEST_ASSERT_EQUAL_INT64(0, tx.deadlineUs);
+  TEST_ASSERT_TRUE(_sameSequence(*tx.sequence, _sequence(0x1234, 90)));
+  TEST_ASSERT_FALSE(scheduler.Pop(0, tx));
+}
+
+void test_duplicate_key_without_overwrite_is_rejected(void) {
+  RFScheduler scheduler(_config(RFScheduler::FairnessPolicy::RoundRobin));
+
+  TEST_ASSERT_TRUE(_submit(scheduler, 0x1234, 0, 100'000, 10, false));
+  TEST_ASSERT_FALSE(_submit(scheduler, 0x1234, 5, 100'000, 90));
+
+  RFScheduler::Transmission tx;
+  TEST_ASSERT_TRUE(scheduler.Pop(0, tx));
+  TEST_ASSERT_TRUE(_sameSequence(*tx.sequence, _sequence(0x1234, 10)));
+}
+
+void test_colliding_ids_probe_past_tombstones(void) {
+  // Find three IDs that share a home slot
+  std::vector<std::uint16_t> ids;
+  for (std::uint32_t id = 1; id <= 0xFFFF && ids.size() < 3; ++id) {
+    if (_homeSlot(static_cast<std::uint16_t>(id)) == _homeSlot(1)) {
+      ids.push_back(static_cast<std::uint16_t>(id));
+    }
+  }
+  TEST_ASSERT_EQUAL_size_t(3, ids.size());
+
+  RFScheduler scheduler(_config(RFScheduler::FairnessPolicy::RoundRobin));
+
+  // The first one expires almost immediately, the others run for a while
+  TEST_ASSERT_TRUE(_submit(scheduler, ids[0], 0, 0));
+  TEST_ASSERT_TRUE(_submit(scheduler, ids[1], 1, 1'000'000, 20));
+  TEST_ASSERT_TRUE(_submit(scheduler, ids[2], 2, 1'000'000, 30));
+
+  // Drive time forward until the first one has sent its end sequence and is released
+  std::int64_t nowUs = 0;
+  RFScheduler::Transmission tx;
+  while (nowUs < END_DURATION_US * 2) {
+    if (scheduler.Pop(nowUs, tx)) {
+      scheduler.Complete(tx, nowUs);
+    }
+    nowUs += FRAME_INTERVAL_US / 4;
+  }
+
+  std::vector<RFScheduler::SlotStats> stats;
+  scheduler.GetSlotStats(stats);
+  TEST_ASSERT_EQUAL_size_t(2, stats.size());
+
+  // The chain now starts with a tombstone, replacing the later IDs must still find them instead of allocating a second slot
+  TEST_ASSERT_TRUE(_submit(scheduler, ids[2], nowUs, 1'000'000, 77, false));
+  TEST_ASSERT_FALSE(_submit(scheduler, ids[2], nowUs, 1'000'000, 78));
+  TEST_ASSERT_TRUE(_submit(scheduler, ids[1], nowUs, 1'000'000, 66));
+
+  scheduler.GetSlotStats(stats);
+  TEST_ASSERT_EQUAL_size_t(2, stats.size());
+}
+
+void test_expiry_sends_zero_sequence_then_releases(void) {
+  RFScheduler scheduler(_config(RFScheduler::FairnessPolicy::RoundRobin));
+
+  TEST_ASSERT_TRUE(_submit(scheduler, 0x0042, 0, 20'000));
+
+  Rmt::Sequence zero = Rmt::GetZeroSequence(ShockerModelType::Petrainer, 0x0042);
+
+  RFScheduler::Transmission tx;
+  std::int64_t nowUs = 0;
+
+  // Active: the command waveform
+  TEST_ASSERT_TRUE(scheduler.Pop(nowUs, tx));
+  TEST_ASSERT_TRUE(_sameSequence(*tx.sequence, _sequence(0x0042, 50)));
+  scheduler.Complete(tx, nowUs);
+
+  // Past untilUs: only the zero sequence
+  nowUs = 25'000;
+  TEST_ASSERT_TRUE(scheduler.Pop(nowUs, tx));
+  TEST_ASSERT_TRUE(_sameSequence(*tx.sequence, zero));
+  scheduler.Complete(tx, nowUs);
+  TEST_ASSERT_FALSE(scheduler.empty());
+
+  // Past untilUs + transmitEndDurationUs: released on completion
+  nowUs = 20'000 + END_DURATION_US + 1;
+  TEST_ASSERT_TRUE(scheduler.Pop(nowUs, tx));
+  TEST_ASSERT_TRUE(_sameSequence(*tx.sequence, zero));
+  scheduler.Complete(tx, nowUs);
+  TEST_ASSERT_TRUE(scheduler.empty());
+}
+
+void test_expire_all_cuts_commands_short(void) {
+  RFScheduler scheduler(_config(RFScheduler::FairnessPolicy::RoundRobin));
+
+  TEST_ASSERT_TRUE(_submit(scheduler, 1, 0, 1'000'000));
+  TEST_ASSERT_TRUE(_submit(scheduler, 2, 0, 1'000'000));
+
+  scheduler.ExpireAll(0);
+
+  // Both are due at once and only send their end sequence from now on
+  for (int i = 0; i < 2; ++i) {
+    RFScheduler::Transmission tx;
+    TEST_ASSERT_TRUE(scheduler.Pop(1, tx));
+    TEST_ASSERT_TRUE(_sameSequence(*tx.sequence, Rmt::GetZeroSequence(ShockerModelType::Petrainer, 1)) || _sameSequence(*tx.sequence, Rmt::GetZeroSequence(ShockerModelType::Petrainer, 2)));
+    scheduler.Complete(tx, 1);
+  }
+
+  // And both are released once the end sequence has run its course
+  for (int i = 0; i < 2; ++i) {
+    RFScheduler::Transmission tx;
+    TEST_ASSERT_TRUE(scheduler.Pop(END_DURATION_US + 1, tx));
+    scheduler.Complete(tx, END_DURATION_US + 1);
+  }
+  TEST_ASSERT_TRUE(scheduler.empty());
+}
+
+void test_round_robin_order(void) {
+  RFScheduler scheduler(_config(RFScheduler::FairnessPolicy::RoundRobin));
+
+  TEST_ASSERT_TRUE(_submit(scheduler, 0xA, 0, 1'000'000));
+  TEST_ASSERT_TRUE(_submit(scheduler, 0xB, 1, 1'000'000));
+  TEST_ASSERT_TRUE(_submit(scheduler, 0xC, 2, 1'000'000));
+
+  // Served back to back, each completed slot goes to the back of the line
+  std::vector<std::uint16_t> order;
+  std::int64_t nowUs = 10;
+  for (int i = 0; i < 9; ++i) {
+    RFScheduler::Transmission tx;
+    TEST_ASSERT_TRUE(scheduler.Pop(nowUs, tx));
+
+    for (std::uint16_t id : {0xA, 0xB, 0xC}) {
+      if (_sameSequence(*tx.sequence, _sequence(id, 50))) {
+        order.push_back(id);
+      }
+    }
+
+    nowUs += 1'000;
+    scheduler.Complete(tx, nowUs);
+  }
+
+  const std::uint16_t expected[] = {0xA, 0xB, 0xC, 0xA, 0xB, 0xC, 0xA, 0xB, 0xC};
+  TEST_ASSERT_EQUAL_size_t(9, order.size());
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    TEST_ASSERT_EQUAL_UINT16(expected[i], order[i]);
+  }
+}
+
+void test_round_robin_late_submit_goes_first_by_deadline(void) {
+  RFScheduler scheduler(_config(RFScheduler::FairnessPolicy::RoundRobin));
+
+  TEST_ASSERT_TRUE(_submit(scheduler, 0xA, 0, 1'000'000));
+
+  RFScheduler::Transmission tx;
+  TEST_ASSERT_TRUE(scheduler.Pop(0, tx));
+  scheduler.Complete(tx, 5'000);  // A is now due at 5000
+
+  TEST_ASSERT_TRUE(_submit(scheduler, 0xB, 4'000, 1'000'000));  // B is due at 4000
+
+  TEST_ASSERT_EQUAL_INT64(4'000, scheduler.NextDeadline());
+  TEST_ASSERT_TRUE(scheduler.Pop(5'000, tx));
+  TEST_ASSERT_TRUE(_sameSequence(*tx.sequence, _sequence(0xB, 50)));
+}
+
+void test_fixed_frame_rate_paces_slots(void) {
+  RFScheduler scheduler(_config(RFScheduler::FairnessPolicy::FixedFrameRate));
+
+  TEST_ASSERT_TRUE(_submit(scheduler, 0xA, 0, 1'000'000));
+
+  RFScheduler::Transmission tx;
+  TEST_ASSERT_TRUE(scheduler.Pop(0, tx));
+  scheduler.Complete(tx, 2'000);
+
+  // Next frame is due one interval after the previous deadline, not after completion
+  TEST_ASSERT_EQUAL_INT64(FRAME_INTERVAL_US, scheduler.NextDeadline());
+  TEST_ASSERT_FALSE(scheduler.Pop(FRAME_INTERVAL_US - 1, tx));
+  TEST_ASSERT_TRUE(scheduler.Pop(FRAME_INTERVAL_US, tx));
+  TEST_ASSERT_EQUAL_INT64(FRAME_INTERVAL_US, tx.deadlineUs);
+  scheduler.Complete(tx, FRAME_INTERVAL_US + 2'000);
+
+  TEST_ASSERT_EQUAL_INT64(FRAME_INTERVAL_US * 2, scheduler.NextDeadline());
+}
+
+void test_fixed_frame_rate_does_not_burst_to_catch_up(void) {
+  RFScheduler scheduler(_config(RFScheduler::FairnessPolicy::FixedFrameRate));
+
+  TEST_ASSERT_TRUE(_submit(scheduler, 0xA, 0, 1'000'000));
+
+  RFScheduler::Transmission tx;
+  TEST_ASSERT_TRUE(scheduler.Pop(0, tx));
+
+  // The frame took far longer than several intervals
+  std::int64_t nowUs = FRAME_INTERVAL_US * 5;
+  scheduler.Complete(tx, nowUs);
+
+  TEST_ASSERT_EQUAL_INT64(nowUs, scheduler.NextDeadline());
+  TEST_ASSERT_TRUE(scheduler.Pop(nowUs, tx));
+  scheduler.Complete(tx, nowUs);
+  TEST_ASSERT_FALSE(scheduler.Pop(nowUs, tx));
+}
+
+void test_fixed_frame_rate_interleaves_by_deadline(void) {
+  RFScheduler scheduler(_config(RFScheduler::FairnessPolicy::FixedFrameRate));
+
+  TEST_ASSERT_TRUE(_submit(scheduler, 0xA, 0, 1'000'000));
+  TEST_ASSERT_TRUE(_submit(scheduler, 0xB, FRAME_INTERVAL_US / 2, 1'000'000));
+
+  std::vector<std::uint16_t> order;
+  std::vector<std::int64_t> deadlines;
+  std::int64_t nowUs = 0;
+  while (order.size() < 6) {
+    RFScheduler::Transmission tx;
+    if (!scheduler.Pop(nowUs, tx)) {
+      nowUs = scheduler.NextDeadline();
+      continue;
+    }
+
+    order.push_back(_sameSequence(*tx.sequence, _sequence(0xA, 50)) ? 0xA : 0xB);
+    deadlines.push_back(tx.deadlineUs);
+    scheduler.Complete(tx, nowUs + 100);
+  }
+
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    TEST_ASSERT_EQUAL_UINT16(i % 2 == 0 ? 0xA : 0xB, order[i]);
+    TEST_ASSERT_EQUAL_INT64(static_cast<std::int64_t>(i) * FRAME_INTERVAL_US / 2, deadlines[i]);
+  }
+}
+
+void test_missed_deadlines_are_counted(void) {
+  RFScheduler scheduler(_config(RFScheduler::FairnessPolicy::RoundRobin));
+
+  TEST_ASSERT_TRUE(_submit(scheduler, 0xA, 0, 1'000'000));
+
+  RFScheduler::Transmission tx;
+  TEST_ASSERT_TRUE(scheduler.Pop(FRAME_INTERVAL_US + 1, tx));
+  scheduler.Complete(tx, FRAME_INTERVAL_US + 1);
+
+  std::vector<RFScheduler::SlotStats> stats;
+  scheduler.GetSlotStats(stats);
+  TEST_ASSERT_EQUAL_size_t(1, stats.size());
+  TEST_ASSERT_EQUAL_UINT32(1, stats[0].framesSent);
+  TEST_ASSERT_EQUAL_UINT32(1, stats[0].missedDeadlines);
+}
+
+void test_pop_by_model_only_takes_matching_head(void) {
+  RFScheduler scheduler(_config(RFScheduler::FairnessPolicy::RoundRobin));
+
+  TEST_ASSERT_TRUE(_submit(scheduler, 0xA, 0, 1'000'000));
+  TEST_ASSERT_TRUE(scheduler.Submit(ShockerModelType::CaiXianlin, 0xB, 1'000'000, Rmt::GetSequence(ShockerModelType::CaiXianlin, 0xB, ShockerCommandType::Shock, 50), Rmt::GetZeroSequence(ShockerModelType::CaiXianlin, 0xB), true, 1));
+
+  RFScheduler::Transmission tx;
+  TEST_ASSERT_FALSE(scheduler.Pop(10, ShockerModelType::CaiXianlin, tx));
+  TEST_ASSERT_TRUE(scheduler.Pop(10, ShockerModelType::Petrainer, tx));
+  TEST_ASSERT_TRUE(scheduler.Pop(10, ShockerModelType::CaiXianlin, tx));
+}
+
+void test_complete_after_clear_is_ignored(void) {
+  RFScheduler scheduler(_config(RFScheduler::FairnessPolicy::RoundRobin));
+
+  TEST_ASSERT_TRUE(_submit(scheduler, 0xA, 0, 1'000'000));
+
+  RFScheduler::Transmission tx;
+  TEST_ASSERT_TRUE(scheduler.Pop(0, tx));
+
+  scheduler.Clear();
+  scheduler.Complete(tx, 1'000);
+
+  TEST_ASSERT_TRUE(scheduler.empty());
+  TEST_ASSERT_FALSE(scheduler.Pop(1'000'000, tx));
+}
+
+int main(int argc, char** argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_fibonacci_hash_spreads_sequential_ids);
+  RUN_TEST(test_table_full);
+  RUN_TEST(test_duplicate_key_replaces_in_place);
+  RUN_TEST(test_duplicate_key_without_overwrite_is_rejected);
+  RUN_TEST(test_colliding_ids_probe_past_tombstones);
+  RUN_TEST(test_expiry_sends_zero_sequence_then_releases);
+  RUN_TEST(test_expire_all_cuts_commands_short);
+  RUN_TEST(test_round_robin_order);
+  RUN_TEST(test_round_robin_late_submit_goes_first_by_deadline);
+  RUN_TEST(test_fixed_frame_rate_paces_slots);
+  RUN_TEST(test_fixed_frame_rate_does_not_burst_to_catch_up);
+  RUN_TEST(test_fixed_frame_rate_interleaves_by_deadline);
+  RUN_TEST(test_missed_deadlines_are_counted);
+  RUN_TEST(test_pop_by_model_only_takes_matching_head);
+  RUN_TEST(test_complete_after_clear_is_ignored);
+  return UNITY_END();
+}